@@ -0,0 +1,729 @@
+//
+// Created by rogerv on 5/24/24.
+//
+#ifndef COMPACT_DBL_LNK_LST_HPP
+#define COMPACT_DBL_LNK_LST_HPP
+
+#include <new>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include "dbl-lnk-lst.hpp"
+
+namespace cust_coll {
+
+  /**
+   * A doubly-linked-list whose nodes live in one growable contiguous array and link to each other
+   * by 32-bit array index instead of by pointer - for small element types that cuts the memory
+   * per item to a fraction of dbl_lnk_lst's (no per-node allocation, no 64-bit links). Freed
+   * slots go onto an internal free list and are reused before the array grows.
+   *
+   * Has the same API as dbl_lnk_lst apart from splice()/merge()/concat() (nodes can't be relinked
+   * from one array into another) and parallel_sort(); adds capacity(), reserve(), compact() and
+   * shrink_to_fit(). compact() renumbers the nodes into list order, so that traversal becomes a
+   * sequential sweep of the array.
+   *
+   * Iterators refer to a node by index, so they stay valid when the array grows - only
+   * compact(), shrink_to_fit() and erasing their own item invalidate them.
+   *
+   * @tparam T type of element contained by container - as constrained by
+   *           concept lst_elm_type_constraints
+   * @tparam Alloc allocator type - is rebound to allocate the node array
+   */
+  template <typename T, typename Alloc = std::allocator<T>> requires lst_elm_type_constraints<T>
+  class compact_dbl_lnk_lst {
+  protected:
+    using idx_t = uint32_t;
+    static constexpr idx_t npos = UINT32_MAX;           // null link
+    static constexpr idx_t free_mark = npos - 1;        // prev link of a slot on the free list
+    static constexpr size_t max_capacity = free_mark;
+    struct cpt_node {
+      idx_t prev;
+      idx_t next;
+      alignas(T) std::byte store[sizeof(T)];
+      T& value() noexcept { return *std::launder(reinterpret_cast<T*>(store)); }
+    };
+    using node_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<cpt_node>;
+    using node_alloc_traits = std::allocator_traits<node_alloc_t>;
+    cpt_node *nodes{nullptr};  // owning plain pointer to node array of cap slots
+    idx_t cap{0};
+    idx_t used{0};             // slots [0, used) have been handed out at some point
+    idx_t head{npos};
+    idx_t tail{npos};
+    idx_t free_head{npos};     // first slot of the free list (linked via next)
+    size_t count{0};
+    [[no_unique_address]] node_alloc_t node_alloc{};
+    template <typename F> bool relocate(size_t new_cap, bool in_list_order, F &&prepare) noexcept;
+    bool relocate(size_t new_cap, bool in_list_order) noexcept
+      { return relocate(new_cap, in_list_order, [](cpt_node*) noexcept {}); }
+    template <typename F> bool grow(size_t min_cap, F &&prepare) noexcept;
+    bool grow(size_t min_cap) noexcept { return grow(min_cap, [](cpt_node*) noexcept {}); }
+    template <typename... Args> idx_t new_node(Args&&... args) noexcept;
+    void free_node(idx_t idx) noexcept;
+    void free_storage() noexcept;
+    void insert_at_head(idx_t idx) noexcept;
+    void append_at_tail(idx_t idx) noexcept;
+    void link_before(idx_t pos_idx, idx_t idx) noexcept;
+    void link_after(idx_t pos_idx, idx_t idx) noexcept;
+    void unlink(idx_t idx) noexcept;
+    idx_t find_first(const T&pos) const noexcept;
+    idx_t find_last(const T&pos) const noexcept;
+    template <typename U> bool insert_node(U &&item, idx_t pos_idx, bool before) noexcept;
+    template <bool Move, typename It, typename S>
+    bool link_new_chain(idx_t pos_idx, It first, S last, size_t nbr_hint = 0) noexcept;
+    template <typename R> bool link_new_range(idx_t pos_idx, R &&rng) noexcept;
+    template <typename Compare> idx_t merge_chains(idx_t a, idx_t b, Compare &comp) noexcept;
+  public:
+    using allocator_type = Alloc;
+    compact_dbl_lnk_lst() noexcept(std::is_nothrow_default_constructible_v<node_alloc_t>) = default;
+    explicit compact_dbl_lnk_lst(const Alloc &alloc) noexcept : node_alloc{alloc} {}
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    compact_dbl_lnk_lst(It first, S last) noexcept(std::is_nothrow_default_constructible_v<node_alloc_t>)
+      { append_range(std::move(first), std::move(last)); }
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    compact_dbl_lnk_lst(It first, S last, const Alloc &alloc) noexcept : node_alloc{alloc}
+      { append_range(std::move(first), std::move(last)); }
+    template <lst_compatible_range<T> R> requires (not std::same_as<std::remove_cvref_t<R>, compact_dbl_lnk_lst>)
+    explicit compact_dbl_lnk_lst(R &&rng) noexcept(std::is_nothrow_default_constructible_v<node_alloc_t>)
+      { append_range(std::forward<R>(rng)); }
+    template <lst_compatible_range<T> R> requires (not std::same_as<std::remove_cvref_t<R>, compact_dbl_lnk_lst>)
+    compact_dbl_lnk_lst(R &&rng, const Alloc &alloc) noexcept : node_alloc{alloc} { append_range(std::forward<R>(rng)); }
+    compact_dbl_lnk_lst(const compact_dbl_lnk_lst&) = delete;
+    compact_dbl_lnk_lst& operator=(const compact_dbl_lnk_lst&) = delete;
+    compact_dbl_lnk_lst(compact_dbl_lnk_lst &&other) noexcept;
+    compact_dbl_lnk_lst& operator=(compact_dbl_lnk_lst &&other) noexcept;
+    ~compact_dbl_lnk_lst() noexcept { free_storage(); }
+    void swap(compact_dbl_lnk_lst &other) noexcept;
+    friend void swap(compact_dbl_lnk_lst &a, compact_dbl_lnk_lst &b) noexcept { a.swap(b); }
+    Alloc get_allocator() const noexcept { return Alloc{node_alloc}; }
+    size_t size() const noexcept { return count; }
+    bool is_empty() const noexcept { return count == 0; }
+    size_t capacity() const noexcept { return cap; }
+    bool reserve(size_t nbr) noexcept { return nbr <= cap || relocate(nbr, false); }
+    bool compact() noexcept { return relocate(cap, true); }
+    bool shrink_to_fit() noexcept;
+    bool insert(const T& item) noexcept { return insert_node(item, head, true); }
+    bool insert(T &&item) noexcept { return insert_node(std::move(item), head, true); }
+    bool insert_at(const T& item, const T&pos) noexcept { return insert_node(item, find_first(pos), true); }
+    bool insert_at(T &&item, const T&pos) noexcept { return insert_node(std::move(item), find_first(pos), true); }
+    bool append(const T& item) noexcept { return insert_node(item, npos, true); }
+    bool append(T &&item) noexcept { return insert_node(std::move(item), npos, true); }
+    bool append_at(const T& item, const T&pos) noexcept { return insert_node(item, find_last(pos), false); }
+    bool append_at(T &&item, const T&pos) noexcept { return insert_node(std::move(item), find_last(pos), false); }
+    bool delete_at(const T&pos) noexcept;
+    template <lst_compatible_range<T> R> bool insert_range(R &&rng) noexcept
+      { return link_new_range(head, std::forward<R>(rng)); }
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    bool insert_range(It first, S last) noexcept
+      { return link_new_chain<false>(head, std::move(first), std::move(last)); }
+    template <lst_compatible_range<T> R> bool insert_range_at(R &&rng, const T&pos) noexcept
+      { return link_new_range(find_first(pos), std::forward<R>(rng)); }
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    bool insert_range_at(It first, S last, const T&pos) noexcept
+      { return link_new_chain<false>(find_first(pos), std::move(first), std::move(last)); }
+    template <lst_compatible_range<T> R> bool append_range(R &&rng) noexcept
+      { return link_new_range(npos, std::forward<R>(rng)); }
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    bool append_range(It first, S last) noexcept
+      { return link_new_chain<false>(npos, std::move(first), std::move(last)); }
+    void clear() noexcept;
+
+    /**
+     * Bidirectional iterator - same scheme as dbl_lnk_lst::basic_iterator, but refers to its node
+     * by array index (so survives growth of the node array).
+     */
+    template <bool Reverse, bool Const>
+    class basic_iterator {
+    public:
+      using iterator_concept  = std::bidirectional_iterator_tag;
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type  = T;
+      using pointer     = std::conditional_t<Const, const T*, T*>;
+      using reference   = std::conditional_t<Const, const T&, T&>;
+    protected:
+      using lst_ptr_t = std::conditional_t<Const, const compact_dbl_lnk_lst*, compact_dbl_lnk_lst*>;
+      idx_t idx{npos};         // npos at end
+      lst_ptr_t lst{nullptr};  // non-owning plain pointer
+      friend class compact_dbl_lnk_lst;
+      template <bool, bool> friend class basic_iterator;
+      basic_iterator(idx_t i, lst_ptr_t l) noexcept : idx{i}, lst{l} {}
+    public:
+      basic_iterator() noexcept = default;
+      // a non-const iterator converts to its const counterpart
+      template <bool C = Const> requires C
+      basic_iterator(const basic_iterator<Reverse, false> &oth) noexcept : idx{oth.idx}, lst{oth.lst} {}
+      // Prefix increment
+      basic_iterator& operator++() noexcept {
+        idx = Reverse ? lst->nodes[idx].prev : lst->nodes[idx].next;
+        return *this;
+      }
+      // Postfix increment
+      basic_iterator operator++(int) noexcept { basic_iterator tmp = *this; ++(*this); return tmp; }
+      // Prefix decrement (end() decrements to the last item in iteration order)
+      basic_iterator& operator--() noexcept {
+        if (idx != npos)
+          idx = Reverse ? lst->nodes[idx].next : lst->nodes[idx].prev;
+        else
+          idx = Reverse ? lst->head : lst->tail;
+        return *this;
+      }
+      // Postfix decrement
+      basic_iterator operator--(int) noexcept { basic_iterator tmp = *this; --(*this); return tmp; }
+      friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.idx == b.idx; };
+      reference operator*() const noexcept { return lst->nodes[idx].value(); }
+      pointer operator->() const noexcept { return &lst->nodes[idx].value(); }
+    };
+    using iterator = basic_iterator<false, false>;
+    using const_iterator = basic_iterator<false, true>;
+    using reverse_iterator = basic_iterator<true, false>;
+    using const_reverse_iterator = basic_iterator<true, true>;
+    iterator begin() noexcept { return iterator{head, this}; }
+    iterator end() noexcept { return iterator{npos, this}; }
+    const_iterator begin() const noexcept { return const_iterator{head, this}; }
+    const_iterator end() const noexcept { return const_iterator{npos, this}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator{tail, this}; }
+    reverse_iterator rend() noexcept { return reverse_iterator{npos, this}; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{tail, this}; }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator{npos, this}; }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+  protected:
+    template <bool R, typename U>
+    basic_iterator<R, false> insert_node_at(idx_t pos_idx, U &&item, bool before) noexcept;
+  public:
+    template <bool R, bool C> basic_iterator<R, false> insert_before(basic_iterator<R, C> pos, const T& item) noexcept
+      { return insert_node_at<R>(pos.idx, item, true); }
+    template <bool R, bool C> basic_iterator<R, false> insert_before(basic_iterator<R, C> pos, T &&item) noexcept
+      { return insert_node_at<R>(pos.idx, std::move(item), true); }
+    template <bool R, bool C> basic_iterator<R, false> insert_after(basic_iterator<R, C> pos, const T& item) noexcept
+      { return insert_node_at<R>(pos.idx, item, false); }
+    template <bool R, bool C> basic_iterator<R, false> insert_after(basic_iterator<R, C> pos, T &&item) noexcept
+      { return insert_node_at<R>(pos.idx, std::move(item), false); }
+    template <bool R, bool C> basic_iterator<R, false> erase(basic_iterator<R, C> pos) noexcept;
+    template <bool R, bool C> basic_iterator<R, false> erase(basic_iterator<R, C> first, basic_iterator<R, C> last) noexcept;
+    void sort() noexcept { sort(std::less<>{}); }
+    template <typename Compare> void sort(Compare comp) noexcept;
+  };
+
+  /**
+   * Moves the live items into a newly allocated node array of new_cap slots - keeping their slot
+   * numbers, or (when in_list_order) renumbering them 0..count-1 in list order, which leaves all
+   * other slots unused (so the free list is emptied). prepare(new_nodes) is invoked on the new
+   * node array before any item is moved out of the old one (so may still read from it).
+   * @return false when fails to allocate the new node array (the list is then left as it was)
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <typename F>
+  bool compact_dbl_lnk_lst<T, Alloc>::relocate(const size_t new_cap, const bool in_list_order, F &&prepare) noexcept {
+    if (new_cap > max_capacity || new_cap < (in_list_order ? count : used))
+      return false;
+    cpt_node *new_nodes = nullptr;
+    if (new_cap > 0) {
+      try {
+        new_nodes = node_alloc_traits::allocate(node_alloc, new_cap);
+      } catch (...) {
+        return false;
+      }
+    }
+    prepare(new_nodes);
+    if (in_list_order) {
+      idx_t new_idx = 0;
+      for (auto idx = head; idx != npos; idx = nodes[idx].next, new_idx++) {
+        auto &new_node = new_nodes[new_idx];
+        std::construct_at(reinterpret_cast<T*>(new_node.store), std::move(nodes[idx].value()));
+        std::destroy_at(&nodes[idx].value());
+        new_node.prev = new_idx > 0 ? new_idx - 1 : npos;
+        new_node.next = new_idx + 1 < count ? new_idx + 1 : npos;
+      }
+      head = count > 0 ? 0 : npos;
+      tail = count > 0 ? static_cast<idx_t>(count - 1) : npos;
+      used = static_cast<idx_t>(count);
+      free_head = npos;
+    } else {
+      for (idx_t idx = 0; idx < used; idx++) {
+        auto &node = nodes[idx];
+        auto &new_node = new_nodes[idx];
+        new_node.prev = node.prev;
+        new_node.next = node.next;
+        if (node.prev != free_mark) {
+          std::construct_at(reinterpret_cast<T*>(new_node.store), std::move(node.value()));
+          std::destroy_at(&node.value());
+        }
+      }
+    }
+    if (nodes != nullptr)
+      node_alloc_traits::deallocate(node_alloc, nodes, cap);
+    nodes = new_nodes;
+    cap = static_cast<idx_t>(new_cap);
+    return true;
+  }
+
+  /**
+   * Grows the node array geometrically so as to hold at least min_cap slots (see relocate() as
+   * to prepare).
+   * @return false when min_cap is beyond max_capacity or fails to allocate the new node array
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <typename F>
+  inline bool compact_dbl_lnk_lst<T, Alloc>::grow(const size_t min_cap, F &&prepare) noexcept {
+    if (min_cap > max_capacity)
+      return false;
+    return relocate(std::clamp<size_t>(std::max<size_t>(size_t{cap} * 2, 16), min_cap, max_capacity), false,
+                    std::forward<F>(prepare));
+  }
+
+  /**
+   * Takes a slot - from the free list if possible, else a never used one (growing the node array
+   * if full) - and constructs an item in it. When the array grows, the item is constructed in the
+   * new array before the old one is freed - so args may refer to an item of this list (as with
+   * std::vector::push_back).
+   * @return slot of the new node, npos when fails to allocate memory
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <typename... Args>
+  auto compact_dbl_lnk_lst<T, Alloc>::new_node(Args&&... args) noexcept -> idx_t {
+    idx_t idx;
+    if (free_head != npos) {
+      idx = free_head;
+      free_head = nodes[idx].next;
+      std::construct_at(reinterpret_cast<T*>(nodes[idx].store), std::forward<Args>(args)...);
+    } else if (used < cap) {
+      idx = used++;
+      std::construct_at(reinterpret_cast<T*>(nodes[idx].store), std::forward<Args>(args)...);
+    } else {
+      idx = used;
+      const auto construct_new = [idx, &args...](cpt_node *const new_nodes) noexcept {
+        std::construct_at(reinterpret_cast<T*>(new_nodes[idx].store), std::forward<Args>(args)...);
+      };
+      if (not grow(size_t{cap} + 1, construct_new))
+        return npos;
+      used++;
+    }
+    nodes[idx].prev = nodes[idx].next = npos;
+    return idx;
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  inline void compact_dbl_lnk_lst<T, Alloc>::free_node(const idx_t idx) noexcept {
+    std::destroy_at(&nodes[idx].value());
+    nodes[idx].prev = free_mark;
+    nodes[idx].next = free_head;
+    free_head = idx;
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  void compact_dbl_lnk_lst<T, Alloc>::free_storage() noexcept {
+    clear();
+    if (nodes != nullptr)
+      node_alloc_traits::deallocate(node_alloc, nodes, cap);
+    nodes = nullptr;
+    cap = 0;
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  inline void compact_dbl_lnk_lst<T, Alloc>::insert_at_head(const idx_t idx) noexcept {
+    nodes[idx].prev = npos;
+    nodes[idx].next = head;
+    if (head != npos)
+      nodes[head].prev = idx;
+    else
+      tail = idx;
+    head = idx;
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  inline void compact_dbl_lnk_lst<T, Alloc>::append_at_tail(const idx_t idx) noexcept {
+    nodes[idx].next = npos;
+    nodes[idx].prev = tail;
+    if (tail != npos)
+      nodes[tail].next = idx;
+    else
+      head = idx;
+    tail = idx;
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  inline void compact_dbl_lnk_lst<T, Alloc>::link_before(const idx_t pos_idx, const idx_t idx) noexcept {
+    const auto prev_idx = nodes[pos_idx].prev;
+    if (prev_idx == npos) {
+      assert(pos_idx == head); // (we trust but verify)
+      insert_at_head(idx);
+      return;
+    }
+    nodes[idx].prev = prev_idx;
+    nodes[idx].next = pos_idx;
+    nodes[prev_idx].next = idx;
+    nodes[pos_idx].prev = idx;
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  inline void compact_dbl_lnk_lst<T, Alloc>::link_after(const idx_t pos_idx, const idx_t idx) noexcept {
+    const auto next_idx = nodes[pos_idx].next;
+    if (next_idx == npos) {
+      assert(pos_idx == tail); // (we trust but verify)
+      append_at_tail(idx);
+      return;
+    }
+    nodes[idx].prev = pos_idx;
+    nodes[idx].next = next_idx;
+    nodes[next_idx].prev = idx;
+    nodes[pos_idx].next = idx;
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  inline void compact_dbl_lnk_lst<T, Alloc>::unlink(const idx_t idx) noexcept {
+    const auto prev_idx = nodes[idx].prev;
+    const auto next_idx = nodes[idx].next;
+    if (prev_idx != npos)
+      nodes[prev_idx].next = next_idx;
+    else
+      head = next_idx;
+    if (next_idx != npos)
+      nodes[next_idx].prev = prev_idx;
+    else
+      tail = prev_idx;
+  }
+
+  /**
+   * @return slot of first node, starting from head of list, whose value matches pos (or npos)
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  auto compact_dbl_lnk_lst<T, Alloc>::find_first(const T&pos) const noexcept -> idx_t {
+    for (auto idx = head; idx != npos; idx = nodes[idx].next) {
+      if (nodes[idx].value() == pos)
+        return idx;
+    }
+    return npos;
+  }
+
+  /**
+   * @return slot of first node, starting from tail of list, whose value matches pos (or npos)
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  auto compact_dbl_lnk_lst<T, Alloc>::find_last(const T&pos) const noexcept -> idx_t {
+    for (auto idx = tail; idx != npos; idx = nodes[idx].prev) {
+      if (nodes[idx].value() == pos)
+        return idx;
+    }
+    return npos;
+  }
+
+  /**
+   * Constructs a node for item and links it in before (or after) the pos_idx node - when pos_idx
+   * is npos then item is appended at tail of list.
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <typename U>
+  bool compact_dbl_lnk_lst<T, Alloc>::insert_node(U &&item, const idx_t pos_idx, const bool before) noexcept {
+    const auto idx = new_node(std::forward<U>(item));
+    if (idx == npos)
+      return false;
+    if (pos_idx == npos)
+      append_at_tail(idx);
+    else if (before)
+      link_before(pos_idx, idx);
+    else
+      link_after(pos_idx, idx);
+    count++;
+    return true;
+  }
+
+  /**
+   * Removes a pos specified matched item from list (its slot goes onto the free list).
+   * @tparam T item's type
+   * @param pos item to be removed
+   * @return returns true if item was matched and removed from list
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  bool compact_dbl_lnk_lst<T, Alloc>::delete_at(const T&pos) noexcept {
+    if (const auto idx = find_first(pos); idx != npos) {
+      unlink(idx);
+      free_node(idx);
+      count--;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Same as dbl_lnk_lst::link_new_chain() - the node array is grown once up front when the item
+   * count is known.
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <bool Move, typename It, typename S>
+  bool compact_dbl_lnk_lst<T, Alloc>::link_new_chain(const idx_t pos_idx, It first, S last,
+                                                     size_t nbr_hint) noexcept {
+    if constexpr (std::sized_sentinel_for<S, It>)
+      nbr_hint = static_cast<size_t>(last - first);
+    if (nbr_hint > 0 && count + nbr_hint > cap && not grow(count + nbr_hint))
+      return false;
+    idx_t chain_first = npos, chain_last = npos;
+    size_t nbr = 0;
+    for (; first != last; ++first) {
+      auto &&item = [&first]() -> decltype(auto) {
+        if constexpr (Move)
+          return std::ranges::iter_move(first);
+        else
+          return *first;
+      }();
+      idx_t idx;
+      if constexpr (std::same_as<std::remove_cvref_t<decltype(item)>, T>)
+        idx = new_node(std::forward<decltype(item)>(item));
+      else
+        idx = new_node(T(std::forward<decltype(item)>(item))); // (converted first)
+      if (idx == npos) {
+        while (chain_first != npos) {
+          const auto next_idx = nodes[chain_first].next;
+          free_node(chain_first);
+          chain_first = next_idx;
+        }
+        return false;
+      }
+      nodes[idx].prev = chain_last;
+      if (chain_last != npos)
+        nodes[chain_last].next = idx;
+      else
+        chain_first = idx;
+      chain_last = idx;
+      nbr++;
+    }
+    if (chain_first == npos)
+      return true;
+    const auto prev_idx = pos_idx != npos ? nodes[pos_idx].prev : tail;
+    nodes[chain_first].prev = prev_idx;
+    nodes[chain_last].next = pos_idx;
+    if (prev_idx != npos)
+      nodes[prev_idx].next = chain_first;
+    else
+      head = chain_first;
+    if (pos_idx != npos)
+      nodes[pos_idx].prev = chain_last;
+    else
+      tail = chain_last;
+    count += nbr;
+    return true;
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <typename R>
+  bool compact_dbl_lnk_lst<T, Alloc>::link_new_range(const idx_t pos_idx, R &&rng) noexcept {
+    constexpr bool move = not std::is_lvalue_reference_v<R> && not std::ranges::borrowed_range<R>;
+    size_t nbr_hint = 0;
+    if constexpr (std::ranges::sized_range<R>)
+      nbr_hint = static_cast<size_t>(std::ranges::size(rng));
+    return link_new_chain<move>(pos_idx, std::ranges::begin(rng), std::ranges::end(rng), nbr_hint);
+  }
+
+  /**
+   * Moves the items into a node array just big enough for them (in list order, as compact()
+   * does) - the array is freed altogether when the list is empty.
+   * @return false when fails to allocate the new node array (the list is then left as it was)
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  bool compact_dbl_lnk_lst<T, Alloc>::shrink_to_fit() noexcept {
+    if (count == 0) {
+      free_storage();
+      return true;
+    }
+    return relocate(count, true);
+  }
+
+  /**
+   * Removes all items in container - the node array is retained (see shrink_to_fit()).
+   * @tparam T item's type
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  void compact_dbl_lnk_lst<T, Alloc>::clear() noexcept {
+    if constexpr (not std::is_trivially_destructible_v<T>) {
+      for (auto idx = head; idx != npos; idx = nodes[idx].next)
+        std::destroy_at(&nodes[idx].value());
+    }
+    head = tail = free_head = npos;
+    used = 0;
+    count = 0;
+  }
+
+  /**
+   * Takes over the node array of other - O(1); other is left empty.
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  compact_dbl_lnk_lst<T, Alloc>::compact_dbl_lnk_lst(compact_dbl_lnk_lst &&other) noexcept
+    : nodes{std::exchange(other.nodes, nullptr)}, cap{std::exchange(other.cap, 0)},
+      used{std::exchange(other.used, 0)}, head{std::exchange(other.head, npos)},
+      tail{std::exchange(other.tail, npos)}, free_head{std::exchange(other.free_head, npos)},
+      count{std::exchange(other.count, 0)}, node_alloc{other.node_alloc} {}
+
+  /**
+   * Frees this list's node array then takes over the node array of other - O(1) when the
+   * allocator propagates on move assignment or the allocators compare equal, otherwise the items
+   * are moved into a node array of this list's allocator. Either way other is left empty.
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  auto compact_dbl_lnk_lst<T, Alloc>::operator=(compact_dbl_lnk_lst &&other) noexcept -> compact_dbl_lnk_lst& {
+    if (&other == this)
+      return *this;
+    if constexpr (not node_alloc_traits::propagate_on_container_move_assignment::value) {
+      if (not (node_alloc == other.node_alloc)) {
+        clear();
+        link_new_chain<true>(npos, other.begin(), other.end(), other.count);
+        other.free_storage();
+        return *this;
+      }
+    }
+    free_storage();
+    if constexpr (node_alloc_traits::propagate_on_container_move_assignment::value)
+      node_alloc = other.node_alloc;
+    nodes = std::exchange(other.nodes, nullptr);
+    cap = std::exchange(other.cap, 0);
+    used = std::exchange(other.used, 0);
+    head = std::exchange(other.head, npos);
+    tail = std::exchange(other.tail, npos);
+    free_head = std::exchange(other.free_head, npos);
+    count = std::exchange(other.count, 0);
+    return *this;
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  void compact_dbl_lnk_lst<T, Alloc>::swap(compact_dbl_lnk_lst &other) noexcept {
+    if constexpr (node_alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(node_alloc, other.node_alloc);
+    } else {
+      assert(node_alloc == other.node_alloc); // (we trust but verify)
+    }
+    std::swap(nodes, other.nodes);
+    std::swap(cap, other.cap);
+    std::swap(used, other.used);
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(free_head, other.free_head);
+    std::swap(count, other.count);
+  }
+
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <bool R, typename U>
+  auto compact_dbl_lnk_lst<T, Alloc>::insert_node_at(const idx_t pos_idx, U &&item, const bool before) noexcept
+    -> basic_iterator<R, false>
+  {
+    const auto idx = new_node(std::forward<U>(item));
+    if (idx == npos)
+      return basic_iterator<R, false>{npos, this};
+    if (pos_idx == npos) {
+      if (before)
+        append_at_tail(idx);
+      else
+        insert_at_head(idx);
+    } else if (before) {
+      link_before(pos_idx, idx);
+    } else {
+      link_after(pos_idx, idx);
+    }
+    count++;
+    return basic_iterator<R, false>{idx, this};
+  }
+
+  /**
+   * Removes the item referred to by pos from list - no scan of the list takes place.
+   * @return iterator referring to the item that followed pos (in pos's direction of iteration)
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <bool R, bool C>
+  auto compact_dbl_lnk_lst<T, Alloc>::erase(basic_iterator<R, C> pos) noexcept -> basic_iterator<R, false> {
+    const auto idx = pos.idx;
+    if (idx == npos)
+      return basic_iterator<R, false>{npos, this};
+    const basic_iterator<R, false> next_it{R ? nodes[idx].prev : nodes[idx].next, this};
+    unlink(idx);
+    free_node(idx);
+    count--;
+    return next_it;
+  }
+
+  /**
+   * Removes the items [first, last) from list, iterating in first's direction.
+   * @return last
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <bool R, bool C>
+  auto compact_dbl_lnk_lst<T, Alloc>::erase(basic_iterator<R, C> first, const basic_iterator<R, C> last) noexcept
+    -> basic_iterator<R, false>
+  {
+    while (first != last && first.idx != npos)
+      first = erase(first);
+    return basic_iterator<R, false>{last.idx, this};
+  }
+
+  /**
+   * Merges the two sorted chains a and b (linked by next only) - stable, a's items first on ties.
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <typename Compare>
+  auto compact_dbl_lnk_lst<T, Alloc>::merge_chains(idx_t a, idx_t b, Compare &comp) noexcept -> idx_t {
+    idx_t first = npos;
+    auto *link = &first; // the next link to be set
+    while (a != npos && b != npos) {
+      if (comp(nodes[b].value(), nodes[a].value())) {
+        *link = b;
+        b = nodes[b].next;
+      } else {
+        *link = a;
+        a = nodes[a].next;
+      }
+      link = &nodes[*link].next;
+    }
+    *link = a != npos ? a : b;
+    return first;
+  }
+
+  /**
+   * Sorts the items by relinking the nodes - a stable bottom-up merge sort, O(n log n), the same
+   * as dbl_lnk_lst::sort(). Slot numbers are left as they were (see compact()).
+   * @tparam T item's type
+   * @param comp strict weak ordering of two items (std::less<> when not specified)
+   */
+  template <typename T, typename Alloc> requires lst_elm_type_constraints<T>
+  template <typename Compare>
+  void compact_dbl_lnk_lst<T, Alloc>::sort(Compare comp) noexcept {
+    if (count < 2)
+      return;
+    idx_t bins[64];
+    size_t top = 0;
+    for (auto idx = head; idx != npos;) {
+      auto carry = idx;
+      idx = nodes[idx].next;
+      nodes[carry].next = npos;
+      size_t i = 0;
+      for (; i < top && bins[i] != npos; i++) {
+        carry = merge_chains(bins[i], carry, comp);
+        bins[i] = npos;
+      }
+      bins[i] = carry;
+      if (i == top)
+        top++;
+    }
+    idx_t sorted = npos;
+    for (size_t i = 0; i < top; i++) {
+      if (bins[i] != npos)
+        sorted = merge_chains(bins[i], sorted, comp);
+    }
+    head = tail = sorted;
+    nodes[head].prev = npos;
+    for (; nodes[tail].next != npos; tail = nodes[tail].next)
+      nodes[nodes[tail].next].prev = tail;
+  }
+
+} // cust_coll
+
+#endif //COMPACT_DBL_LNK_LST_HPP
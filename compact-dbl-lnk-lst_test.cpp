@@ -0,0 +1,229 @@
+//
+// Created by rogerv on 5/24/24.
+//
+#include <list>
+#include <string>
+#include <vector>
+#include <functional>
+#include <random>
+#include <ranges>
+#include <iterator>
+#include <numeric>
+#include <algorithm>
+#include <memory_resource>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "compact-dbl-lnk-lst.hpp"
+using cust_coll::compact_dbl_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+
+static_assert(std::bidirectional_iterator<compact_dbl_lnk_lst<int>::iterator>);
+static_assert(std::bidirectional_iterator<compact_dbl_lnk_lst<int>::const_reverse_iterator>);
+static_assert(std::ranges::bidirectional_range<compact_dbl_lnk_lst<some_elm>>);
+static_assert(std::is_nothrow_move_constructible_v<compact_dbl_lnk_lst<some_elm>>);
+
+TEST(CompactDblLnkListAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  compact_dbl_lnk_lst<some_elm> lst{};  // <<=== compact-dbl-lnk-list
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(lst.capacity(), 0);
+  EXPECT_TRUE(lst.begin() == lst.end());
+  EXPECT_FALSE(lst.delete_at(some_elm{}));
+}
+
+TEST(CompactDblLnkListAssertions, OpsMatchStdList) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> op_dist{0, 4}, val_dist{0, 99};
+  compact_dbl_lnk_lst<int> lst{};  // <<=== compact-dbl-lnk-list
+  std::list<int> oracle{};
+  for (int i = 0; i < ITEM_NBR; i++) {
+    const int val = val_dist(gen), pos = val_dist(gen);
+    switch (op_dist(gen)) {
+      case 0:
+        EXPECT_TRUE(lst.insert(val));
+        oracle.push_front(val);
+        break;
+      case 1:
+        EXPECT_TRUE(lst.append(val));
+        oracle.push_back(val);
+        break;
+      case 2:
+        EXPECT_TRUE(lst.insert_at(val, pos));
+        oracle.insert(std::find(oracle.begin(), oracle.end(), pos), val);
+        break;
+      case 3: {
+        EXPECT_TRUE(lst.append_at(val, pos));
+        auto it = std::find(oracle.rbegin(), oracle.rend(), pos);
+        oracle.insert(it != oracle.rend() ? it.base() : oracle.end(), val);
+        break;
+      }
+      default: {
+        auto it = std::find(oracle.begin(), oracle.end(), pos);
+        EXPECT_EQ(lst.delete_at(pos), it != oracle.end());
+        if (it != oracle.end())
+          oracle.erase(it);
+      }
+    }
+  }
+  EXPECT_EQ(lst.size(), oracle.size());
+  EXPECT_TRUE(std::ranges::equal(lst, oracle));
+  EXPECT_TRUE(std::ranges::equal(std::ranges::subrange(lst.rbegin(), lst.rend()),
+                                 std::ranges::subrange(oracle.rbegin(), oracle.rend())));
+  // slots freed by delete_at() get reused - the node array never holds more than the peak size
+  EXPECT_LE(lst.capacity(), 2 * ITEM_NBR);
+  lst.clear();
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_TRUE(lst.begin() == lst.end());
+}
+
+TEST(CompactDblLnkListAssertions, MoveAndCopyInsertElements) {
+  std::vector<some_elm> strs{ITEM_NBR};
+  const std::vector<some_elm> sav_strs{strs};
+  compact_dbl_lnk_lst<some_elm> lst{};  // <<=== compact-dbl-lnk-list
+  for (auto &elm: strs)
+    EXPECT_TRUE(lst.append(std::move(elm)));
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  EXPECT_TRUE(std::ranges::equal(lst, sav_strs)); // (items survive growth of the node array)
+  for (const auto &elm: sav_strs)
+    EXPECT_TRUE(lst.insert(elm));
+  EXPECT_EQ(lst.size(), 2 * ITEM_NBR);
+  EXPECT_TRUE(std::ranges::equal(std::ranges::subrange(lst.begin(), std::next(lst.begin(), ITEM_NBR)),
+                                 sav_strs | std::views::reverse));
+  for (const auto &elm: sav_strs)
+    EXPECT_TRUE(lst.delete_at(elm));
+  EXPECT_TRUE(std::ranges::equal(lst, sav_strs));
+}
+
+TEST(CompactDblLnkListAssertions, InsertOwnItemWhenFull) {
+  using lst_t = compact_dbl_lnk_lst<std::string>;
+  const std::string item(64, 'x');  // (not a short string - so lives on the heap)
+  const auto full_lst = [&item] {
+    lst_t lst{};  // <<=== compact-dbl-lnk-list
+    do {
+      lst.append(item + std::to_string(lst.size()));
+    } while (lst.size() < lst.capacity());
+    return lst;
+  };
+  // each overload (copy then move) is passed an item of the list itself while the node array must grow for it
+  const std::vector<std::function<bool(lst_t&)>> ops{
+    [](lst_t &lst) { return lst.insert(*lst.begin()); },
+    [](lst_t &lst) { return lst.insert(std::move(*lst.begin())); },
+    [](lst_t &lst) { return lst.insert_at(*lst.begin(), *lst.rbegin()); },
+    [](lst_t &lst) { return lst.insert_at(std::move(*lst.begin()), *lst.rbegin()); },
+    [](lst_t &lst) { return lst.append(*lst.begin()); },
+    [](lst_t &lst) { return lst.append(std::move(*lst.begin())); },
+    [](lst_t &lst) { return lst.append_at(*lst.begin(), *lst.rbegin()); },
+    [](lst_t &lst) { return lst.append_at(std::move(*lst.begin()), *lst.rbegin()); },
+    [](lst_t &lst) { return lst.insert_before(lst.end(), *lst.begin()) != lst.end(); },
+    [](lst_t &lst) { return lst.insert_before(lst.end(), std::move(*lst.begin())) != lst.end(); },
+    [](lst_t &lst) { return lst.insert_after(lst.begin(), *lst.begin()) != lst.end(); },
+    [](lst_t &lst) { return lst.insert_after(lst.begin(), std::move(*lst.begin())) != lst.end(); },
+  };
+  for (size_t i = 0; i < ops.size(); i++) {
+    const auto &op = ops[i];
+    const bool moves = i % 2 == 1;
+    auto lst = full_lst();
+    const auto cap = lst.capacity();
+    const auto nbr = lst.size();
+    EXPECT_TRUE(op(lst));
+    EXPECT_GT(lst.capacity(), cap);
+    EXPECT_EQ(lst.size(), nbr + 1);
+    EXPECT_EQ(std::ranges::count(lst, item + "0"), moves ? 1 : 2);  // (the original and its copy, or the moved to item)
+  }
+}
+
+TEST(CompactDblLnkListAssertions, InsertEraseAtIterator) {
+  compact_dbl_lnk_lst<int> lst{std::views::iota(0, 10)};  // <<=== compact-dbl-lnk-list
+  auto it = std::ranges::find(lst, 5);
+  const auto cap = lst.capacity();
+  it = lst.insert_before(it, 50);
+  EXPECT_EQ(*it, 50);
+  it = lst.insert_after(it, 51);
+  EXPECT_EQ(*std::next(it), 5);
+  it = lst.erase(it);
+  EXPECT_EQ(*it, 5);
+  lst.erase(lst.begin(), std::ranges::find(lst, 3));
+  const std::vector<int> expected{3, 4, 50, 5, 6, 7, 8, 9};
+  EXPECT_TRUE(std::ranges::equal(lst, expected));
+  // iterators hold on to their item while the node array grows
+  auto rit = lst.rbegin();
+  EXPECT_TRUE(lst.append_range(std::views::iota(100, 100 + ITEM_NBR)));
+  EXPECT_GT(lst.capacity(), cap);
+  EXPECT_EQ(*rit, 9);
+  EXPECT_EQ(*--lst.end(), 100 + ITEM_NBR - 1);
+  EXPECT_TRUE(lst.insert_range_at(std::vector<int>{-1, -2}, 4));
+  EXPECT_EQ(*std::ranges::find(lst, -2), -2);
+  EXPECT_EQ(*std::next(std::ranges::find(lst, -2)), 4);
+}
+
+TEST(CompactDblLnkListAssertions, CompactRenumbersIntoListOrder) {
+  compact_dbl_lnk_lst<int> lst{};  // <<=== compact-dbl-lnk-list
+  std::vector<int> vals(ITEM_NBR);
+  std::iota(vals.begin(), vals.end(), 0);
+  std::shuffle(vals.begin(), vals.end(), std::mt19937{7});
+  for (const auto val: vals)
+    lst.insert_at(val, val + 1); // (ends up sorted - each value goes in front of its successor, if present)
+  for (int val = 0; val < ITEM_NBR; val += 3)
+    EXPECT_TRUE(lst.delete_at(val));
+  std::vector<int> expected{};
+  std::ranges::copy(lst, std::back_inserter(expected));
+  const auto cap = lst.capacity();
+  EXPECT_TRUE(lst.compact());
+  EXPECT_EQ(lst.capacity(), cap);
+  EXPECT_TRUE(std::ranges::equal(lst, expected));
+  // list order is now array order - the items sit at consecutive addresses
+  const auto *const first = reinterpret_cast<const std::byte*>(&*lst.begin());
+  const auto stride = reinterpret_cast<const std::byte*>(&*std::next(lst.begin())) - first;
+  EXPECT_GT(stride, 0);
+  std::ptrdiff_t i = 0;
+  for (const auto &item: lst)
+    EXPECT_EQ(reinterpret_cast<const std::byte*>(&item), first + stride * i++);
+  EXPECT_TRUE(lst.shrink_to_fit());
+  EXPECT_EQ(lst.capacity(), expected.size());
+  EXPECT_TRUE(std::ranges::equal(lst, expected));
+  EXPECT_TRUE(lst.append(-1)); // (grows again)
+  EXPECT_GT(lst.capacity(), expected.size());
+  lst.clear();
+  EXPECT_TRUE(lst.shrink_to_fit());
+  EXPECT_EQ(lst.capacity(), 0);
+}
+
+TEST(CompactDblLnkListAssertions, SortMoveAndSwap) {
+  std::vector<int> vals(ITEM_NBR);
+  std::mt19937 gen{11};
+  std::ranges::generate(vals, [&gen] { return static_cast<int>(gen() % 1000); });
+  compact_dbl_lnk_lst<int> lst{vals};  // <<=== compact-dbl-lnk-list
+  lst.sort();
+  std::ranges::sort(vals);
+  EXPECT_TRUE(std::ranges::equal(lst, vals));
+  lst.sort(std::greater<>{});
+  EXPECT_TRUE(std::ranges::equal(lst, vals | std::views::reverse));
+
+  compact_dbl_lnk_lst<int> moved{std::move(lst)};
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(moved.size(), vals.size());
+  compact_dbl_lnk_lst<int> other{std::vector<int>{1, 2, 3}};
+  swap(moved, other);
+  EXPECT_EQ(moved.size(), 3);
+  EXPECT_EQ(other.size(), vals.size());
+  other = std::move(moved);
+  EXPECT_TRUE(std::ranges::equal(other, std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(lst.append(4)); // (a moved-from list is usable again)
+  EXPECT_EQ(lst.size(), 1);
+}
+
+TEST(CompactDblLnkListAssertions, MoveAssignAcrossMemoryResources) {
+  std::pmr::monotonic_buffer_resource res_a{}, res_b{};
+  using pmr_lst = compact_dbl_lnk_lst<some_elm, std::pmr::polymorphic_allocator<some_elm>>;
+  std::vector<some_elm> strs{ITEM_NBR};
+  pmr_lst a{strs, &res_a};  // <<=== compact-dbl-lnk-list
+  pmr_lst b{&res_b};
+  b = std::move(a); // (allocators differ and don't propagate - items are moved)
+  EXPECT_TRUE(a.is_empty());
+  EXPECT_TRUE(b.get_allocator().resource() == &res_b);
+  EXPECT_TRUE(std::ranges::equal(b, strs));
+}
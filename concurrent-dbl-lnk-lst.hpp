@@ -0,0 +1,243 @@
+//
+// Created by rogerv on 5/22/24.
+//
+#ifndef CONCURRENT_DBL_LNK_LST_HPP
+#define CONCURRENT_DBL_LNK_LST_HPP
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cassert>
+#include "dbl-lnk-lst.hpp"
+
+namespace cust_coll {
+
+  /**
+   * A thread-safe doubly-linked-list with fine-grained locking - every node has its own mutex,
+   * and the list is traversed hand-over-hand (a node's lock is taken before its predecessor's is
+   * released), so operations working on different parts of the list proceed in parallel.
+   *
+   * Locks are always acquired in head-to-tail order, which rules out deadlock:
+   *
+   * - linking a node in between two adjacent nodes holds the locks of both
+   * - unlinking a node holds the locks of its predecessor, itself and its successor
+   * - append() starts from the tail sentinel and only try_locks backward (backing off on failure)
+   * - append_at() scans forward from head, keeping the lock of the latest pos match
+   *
+   * Because a node cannot be unlinked without its predecessor's lock being held, a traversing
+   * thread never reaches a freed node, so nodes are freed as soon as they are unlinked.
+   *
+   * @tparam T type of element contained by container - as constrained by
+   *           concept lst_elm_type_constraints
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  class concurrent_dbl_lnk_lst {
+  protected:
+    struct cnc_link {
+      cnc_link *prev{nullptr};  // non-owning plain pointer (guarded by this link's mtx)
+      cnc_link *next{nullptr};  // owning plain pointer (guarded by this link's mtx)
+      std::mutex mtx{};
+    };
+    struct cnc_node : cnc_link {
+      T value;
+      explicit cnc_node(const T &item) : value{item} {}
+      explicit cnc_node(T &&item) : value{std::move(item)} {}
+    };
+    cnc_link head{};  // sentinel - head.next is the first node (or &tail)
+    cnc_link tail{};  // sentinel - tail.prev is the last node (or &head)
+    std::atomic<size_t> count{0};
+    static T& value_of(cnc_link *link) noexcept { return static_cast<cnc_node*>(link)->value; }
+    static void link_between(cnc_link *prev_link, cnc_link *node, cnc_link *next_link) noexcept;
+    template <typename U> bool insert_at_head(U &&item) noexcept;
+    template <typename U> bool append_at_tail(U &&item) noexcept;
+    template <typename U> bool insert_at_position(U &&item, const T&pos) noexcept;
+    template <typename U> bool append_at_position(U &&item, const T&pos) noexcept;
+    bool unlink_first_match(const T *pos) noexcept;
+  public:
+    concurrent_dbl_lnk_lst() noexcept { head.next = &tail; tail.prev = &head; }
+    concurrent_dbl_lnk_lst(const concurrent_dbl_lnk_lst&) = delete;
+    concurrent_dbl_lnk_lst& operator=(const concurrent_dbl_lnk_lst&) = delete;
+    ~concurrent_dbl_lnk_lst() noexcept { clear(); }
+    size_t size() const noexcept { return count.load(std::memory_order_relaxed); }
+    bool is_empty() const noexcept { return size() == 0; }
+    bool insert(const T& item) noexcept { return insert_at_head(item); }
+    bool insert(T &&item) noexcept { return insert_at_head(std::move(item)); }
+    bool insert_at(const T& item, const T&pos) noexcept { return insert_at_position(item, pos); }
+    bool insert_at(T &&item, const T&pos) noexcept { return insert_at_position(std::move(item), pos); }
+    bool append(const T& item) noexcept { return append_at_tail(item); }
+    bool append(T &&item) noexcept { return append_at_tail(std::move(item)); }
+    bool append_at(const T& item, const T&pos) noexcept { return append_at_position(item, pos); }
+    bool append_at(T &&item, const T&pos) noexcept { return append_at_position(std::move(item), pos); }
+    bool delete_at(const T&pos) noexcept { return unlink_first_match(&pos); }
+    void clear() noexcept { while (unlink_first_match(nullptr)) {} }
+    template <typename F> void for_each(F &&f);
+  };
+
+  /**
+   * Links node in between the adjacent prev_link and next_link - the caller holds both their locks.
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  inline void concurrent_dbl_lnk_lst<T>::link_between(cnc_link *const prev_link, cnc_link *const node,
+                                                      cnc_link *const next_link) noexcept {
+    assert(prev_link->next == next_link && next_link->prev == prev_link); // (we trust but verify)
+    node->prev = prev_link;
+    node->next = next_link;
+    prev_link->next = node;
+    next_link->prev = node;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T>
+  template <typename U>
+  bool concurrent_dbl_lnk_lst<T>::insert_at_head(U &&item) noexcept {
+    auto *const node = new (std::nothrow) cnc_node{std::forward<U>(item)};
+    if (node == nullptr)
+      return false;
+    std::scoped_lock lk_head{head.mtx};
+    std::scoped_lock lk_next{head.next->mtx};
+    link_between(&head, node, head.next);
+    count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * Holding the tail sentinel's lock keeps tail.prev from being unlinked, so it's safe to
+   * try_lock it; if that fails (some thread holding it may be waiting on the tail lock) then
+   * back off and retry.
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  template <typename U>
+  bool concurrent_dbl_lnk_lst<T>::append_at_tail(U &&item) noexcept {
+    auto *const node = new (std::nothrow) cnc_node{std::forward<U>(item)};
+    if (node == nullptr)
+      return false;
+    for (;;) {
+      std::unique_lock lk_tail{tail.mtx};
+      auto *const last_link = tail.prev;
+      if (std::unique_lock lk_last{last_link->mtx, std::try_to_lock}; lk_last.owns_lock()) {
+        link_between(last_link, node, &tail);
+        count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      lk_tail.unlock();
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * Traverses hand-over-hand from head; links item in front of the first pos match, or in front
+   * of the tail sentinel if there is no match.
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  template <typename U>
+  bool concurrent_dbl_lnk_lst<T>::insert_at_position(U &&item, const T&pos) noexcept {
+    auto *const node = new (std::nothrow) cnc_node{std::forward<U>(item)};
+    if (node == nullptr)
+      return false;
+    std::unique_lock lk_prev{head.mtx};
+    auto *prev_link = static_cast<cnc_link*>(&head);
+    for (;;) {
+      auto *const curr_link = prev_link->next;
+      std::unique_lock lk_curr{curr_link->mtx};
+      if (curr_link == &tail || value_of(curr_link) == pos) {
+        link_between(prev_link, node, curr_link);
+        count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      lk_prev = std::move(lk_curr); // releases lock of prev_link, retains lock of curr_link
+      prev_link = curr_link;
+    }
+  }
+
+  /**
+   * Traverses hand-over-hand from head, retaining the lock of the latest pos match found (earlier
+   * in list order than the traversal window, so lock order is kept); links item right after the
+   * last match, or in front of the tail sentinel if there is no match.
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  template <typename U>
+  bool concurrent_dbl_lnk_lst<T>::append_at_position(U &&item, const T&pos) noexcept {
+    auto *const node = new (std::nothrow) cnc_node{std::forward<U>(item)};
+    if (node == nullptr)
+      return false;
+    std::unique_lock<std::mutex> lk_match{};
+    cnc_link *match_link = nullptr;
+    std::unique_lock lk_prev{head.mtx}; // (doesn't own a lock when prev_link is match_link)
+    auto *prev_link = static_cast<cnc_link*>(&head);
+    for (;;) {
+      auto *const curr_link = prev_link->next;
+      std::unique_lock lk_curr{curr_link->mtx};
+      if (curr_link == &tail) {
+        if (match_link == nullptr || match_link == prev_link) {
+          link_between(prev_link, node, curr_link);
+        } else {
+          lk_curr.unlock();
+          lk_prev.unlock();
+          std::scoped_lock lk_after{match_link->next->mtx}; // match_link is held so its next is stable
+          link_between(match_link, node, match_link->next);
+        }
+        count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      if (value_of(curr_link) == pos) {
+        if (lk_prev.owns_lock())
+          lk_prev.unlock();
+        lk_match = std::move(lk_curr); // releases lock of previous match (if any)
+        match_link = prev_link = curr_link;
+        continue;
+      }
+      lk_prev = std::move(lk_curr); // releases lock of prev_link (unless is match_link), retains curr_link's
+      prev_link = curr_link;
+    }
+  }
+
+  /**
+   * Traverses hand-over-hand from head; unlinks and frees the first pos match (the first node when
+   * pos is null) holding the locks of its predecessor, itself and its successor.
+   * @return true if a node was unlinked
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  bool concurrent_dbl_lnk_lst<T>::unlink_first_match(const T *const pos) noexcept {
+    std::unique_lock lk_prev{head.mtx};
+    auto *prev_link = static_cast<cnc_link*>(&head);
+    for (;;) {
+      auto *const curr_link = prev_link->next;
+      if (curr_link == &tail)
+        return false;
+      std::unique_lock lk_curr{curr_link->mtx};
+      if (pos == nullptr || value_of(curr_link) == *pos) {
+        {
+          std::scoped_lock lk_next{curr_link->next->mtx};
+          prev_link->next = curr_link->next;
+          curr_link->next->prev = prev_link;
+        }
+        count.fetch_sub(1, std::memory_order_relaxed);
+        lk_curr.unlock();
+        lk_prev.unlock();
+        delete static_cast<cnc_node*>(curr_link); // unreachable now - no thread can be waiting on it
+        return true;
+      }
+      lk_prev = std::move(lk_curr); // releases lock of prev_link, retains lock of curr_link
+      prev_link = curr_link;
+    }
+  }
+
+  /**
+   * Visits every item from head to tail, hand-over-hand - f is invoked while the item's node is
+   * locked (so f must not call back into this container).
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  template <typename F>
+  void concurrent_dbl_lnk_lst<T>::for_each(F &&f) {
+    std::unique_lock lk_prev{head.mtx};
+    for (auto *curr_link = head.next; curr_link != &tail;) {
+      std::unique_lock lk_curr{curr_link->mtx};
+      lk_prev = std::move(lk_curr);
+      f(value_of(curr_link));
+      curr_link = curr_link->next;
+    }
+  }
+
+} // cust_coll
+
+#endif //CONCURRENT_DBL_LNK_LST_HPP
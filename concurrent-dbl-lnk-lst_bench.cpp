@@ -0,0 +1,212 @@
+//
+// Created by rogerv on 5/22/24.
+//
+// Thread scaling benchmarks of concurrent_dbl_lnk_lst (hand-over-hand locking) against a
+// dbl_lnk_lst guarded by one global mutex, and reader scaling of rcu_dbl_lnk_lst (lock-free
+// readers) against a dbl_lnk_lst guarded by a std::shared_mutex, and multi-producer append of
+// sharded_dbl_lnk_lst against a dbl_lnk_lst guarded by one global mutex, e.g.:
+//
+//   concurrent-dbl-lnk-lst_bench --benchmark_out=bench.json --benchmark_out_format=json
+//
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <shared_mutex>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include "dbl-lnk-lst.hpp"
+#include "concurrent-dbl-lnk-lst.hpp"
+#include "rcu-dbl-lnk-lst.hpp"
+#include "sharded-dbl-lnk-lst.hpp"
+using cust_coll::dbl_lnk_lst;
+using cust_coll::concurrent_dbl_lnk_lst;
+using cust_coll::rcu_dbl_lnk_lst;
+using cust_coll::sharded_dbl_lnk_lst;
+
+/**
+ * A dbl_lnk_lst where every operation is serialized by a single mutex - the coarse-grained
+ * baseline.
+ */
+template <typename T>
+class global_mutex_dbl_lnk_lst {
+  std::mutex mtx{};
+  dbl_lnk_lst<T> lst{};
+public:
+  bool append(const T &item) { std::scoped_lock lk{mtx}; return lst.append(item); }
+  bool insert_at(const T &item, const T &pos) { std::scoped_lock lk{mtx}; return lst.insert_at(item, pos); }
+  bool append_at(const T &item, const T &pos) { std::scoped_lock lk{mtx}; return lst.append_at(item, pos); }
+  bool delete_at(const T &pos) { std::scoped_lock lk{mtx}; return lst.delete_at(pos); }
+};
+
+/**
+ * A dbl_lnk_lst where writers take a std::shared_mutex exclusively and readers share it - the
+ * reader-writer lock baseline.
+ */
+template <typename T>
+class shared_mutex_dbl_lnk_lst {
+  mutable std::shared_mutex mtx{};
+  dbl_lnk_lst<T> lst{};
+public:
+  bool append(const T &item) { std::unique_lock lk{mtx}; return lst.append(item); }
+  bool delete_at(const T &pos) { std::unique_lock lk{mtx}; return lst.delete_at(pos); }
+  template <typename F> void for_each(F &&f) const {
+    std::shared_lock lk{mtx};
+    for (const auto &item : lst)
+      f(item);
+  }
+};
+
+template <typename C>
+static std::unique_ptr<C> shared_lst{};
+
+/**
+ * Skips a run whose threads outnumber the n list items (so they couldn't each be handed values
+ * of their own) - every thread of the run takes the same decision, ahead of any setup.
+ * @return true when the run is skipped
+ */
+static bool skipped_for_too_few_items(benchmark::State &state, const int n) {
+  if (state.threads() <= n)
+    return false;
+  state.SkipWithError("more threads than list items");
+  return true;
+}
+
+/**
+ * range(0) is the list size. Each thread repeatedly deletes one of its own values and inserts
+ * it back in front of its successor; the threads' values are interleaved throughout the list, so
+ * the operations spread over the whole of it.
+ */
+template <typename C>
+static void BM_delete_reinsert(benchmark::State &state) {
+  const auto n = static_cast<int>(state.range(0));
+  if (skipped_for_too_few_items(state, n))
+    return;
+  if (state.thread_index() == 0) {
+    shared_lst<C> = std::make_unique<C>();
+    for (int i = 0; i < n; i++)
+      shared_lst<C>->append(i);
+  }
+  std::mt19937 gen{static_cast<unsigned>(state.thread_index())};
+  const int nbr_threads = state.threads();
+  std::uniform_int_distribution<int> slot_dist{0, n / nbr_threads - 1};
+  for (auto _ : state) {
+    const int val = slot_dist(gen) * nbr_threads + state.thread_index();
+    shared_lst<C>->delete_at(val);
+    shared_lst<C>->insert_at(val, val + 1);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+  if (state.thread_index() == 0)
+    shared_lst<C>.reset();
+}
+
+/**
+ * range(0) is the list size. Each thread appends values right after its own anchor value (with
+ * the anchors evenly spaced out over the list) - then deletes them again.
+ */
+template <typename C>
+static void BM_append_at_delete(benchmark::State &state) {
+  const auto n = static_cast<int>(state.range(0));
+  if (skipped_for_too_few_items(state, n))
+    return;
+  if (state.thread_index() == 0) {
+    shared_lst<C> = std::make_unique<C>();
+    for (int i = 0; i < n; i++)
+      shared_lst<C>->append(i);
+  }
+  const int anchor = n / state.threads() * state.thread_index();
+  const int item = -1 - state.thread_index();
+  for (auto _ : state) {
+    shared_lst<C>->append_at(item, anchor);
+    shared_lst<C>->delete_at(item);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+  if (state.thread_index() == 0)
+    shared_lst<C>.reset();
+}
+
+/**
+ * range(0) is the list size. Every benchmark thread is a reader, repeatedly traversing the whole
+ * list, while one extra writer thread keeps appending a new value and deleting the oldest (so the
+ * list keeps its size) until the readers are done.
+ */
+template <typename C>
+static void BM_read_during_writes(benchmark::State &state) {
+  const auto n = static_cast<int>(state.range(0));
+  static std::atomic<bool> stop{false};
+  static std::atomic<int64_t> nbr_writes{0};
+  static std::thread writer{};
+  if (state.thread_index() == 0) {
+    shared_lst<C> = std::make_unique<C>();
+    for (int i = 0; i < n; i++)
+      shared_lst<C>->append(i);
+    stop = false;
+    nbr_writes = 0;
+    writer = std::thread{[n] {
+      int64_t i = n;
+      for (; not stop.load(std::memory_order_relaxed); i++) {
+        shared_lst<C>->append(static_cast<int>(i));
+        shared_lst<C>->delete_at(static_cast<int>(i - n));
+      }
+      nbr_writes = i - n;
+    }};
+  }
+  int64_t sum = 0;
+  for (auto _ : state)
+    shared_lst<C>->for_each([&sum](const int v) { sum += v; });
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * n);
+  if (state.thread_index() == 0) {
+    stop = true;
+    writer.join();
+    state.counters["writes"] = benchmark::Counter(static_cast<double>(nbr_writes), benchmark::Counter::kIsRate);
+    shared_lst<C>.reset();
+  }
+}
+
+/**
+ * Every thread appends values into one shared list (which is collected into a dbl_lnk_lst at the
+ * end, for the sharded list). The iterations are fixed, to bound the memory the list takes up.
+ */
+template <typename C>
+static void BM_multi_producer_append(benchmark::State &state) {
+  if (state.thread_index() == 0)
+    shared_lst<C> = std::make_unique<C>();
+  int i = 0;
+  for (auto _ : state)
+    shared_lst<C>->append(i++);
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    if constexpr (requires { shared_lst<C>->collect(); })
+      benchmark::DoNotOptimize(shared_lst<C>->collect());
+    shared_lst<C>.reset();
+  }
+}
+
+static const int max_threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+
+#define BENCH_SCALING(func, C)                                                 \
+  BENCHMARK_TEMPLATE(func, C)->RangeMultiplier(10)->Range(100, 10'000)         \
+    ->ThreadRange(1, max_threads)->UseRealTime()
+
+BENCH_SCALING(BM_delete_reinsert, concurrent_dbl_lnk_lst<int>);
+BENCH_SCALING(BM_delete_reinsert, global_mutex_dbl_lnk_lst<int>);
+BENCH_SCALING(BM_append_at_delete, concurrent_dbl_lnk_lst<int>);
+BENCH_SCALING(BM_append_at_delete, global_mutex_dbl_lnk_lst<int>);
+
+#define BENCH_READERS(C)                                                       \
+  BENCHMARK_TEMPLATE(BM_read_during_writes, C)->Arg(10'000)                    \
+    ->ThreadRange(1, std::max(1, max_threads - 1))->UseRealTime()
+
+BENCH_READERS(rcu_dbl_lnk_lst<int>);
+BENCH_READERS(shared_mutex_dbl_lnk_lst<int>);
+
+#define BENCH_PRODUCERS(C)                                                     \
+  BENCHMARK_TEMPLATE(BM_multi_producer_append, C)->Iterations(1'000'000)       \
+    ->ThreadRange(1, max_threads)->UseRealTime()
+
+BENCH_PRODUCERS(sharded_dbl_lnk_lst<int>);
+BENCH_PRODUCERS(global_mutex_dbl_lnk_lst<int>);
+
+BENCHMARK_MAIN();
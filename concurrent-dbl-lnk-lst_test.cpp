@@ -0,0 +1,139 @@
+//
+// Created by rogerv on 5/22/24.
+//
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "concurrent-dbl-lnk-lst.hpp"
+using cust_coll::concurrent_dbl_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+static constexpr auto THREAD_NBR = 8;
+
+template <typename T>
+static std::vector<T> contents_of(concurrent_dbl_lnk_lst<T> &lst) {
+  std::vector<T> items{};
+  lst.for_each([&items](const T &item) { items.push_back(item); });
+  return items;
+}
+
+TEST(ConcurrentDblLnkListAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  concurrent_dbl_lnk_lst<some_elm> lst{};  // <<=== concurrent-dbl-lnk-list
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_TRUE(contents_of(lst).empty());
+  EXPECT_FALSE(lst.delete_at(some_elm{}));
+}
+
+TEST(ConcurrentDblLnkListAssertions, SingleThreadedOpsMatchStdList) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> op_dist{0, 4}, val_dist{0, 99};
+  concurrent_dbl_lnk_lst<int> lst{};  // <<=== concurrent-dbl-lnk-list
+  std::list<int> oracle{};
+  for (int i = 0; i < ITEM_NBR; i++) {
+    const int val = val_dist(gen), pos = val_dist(gen);
+    switch (op_dist(gen)) {
+      case 0:
+        EXPECT_TRUE(lst.insert(val));
+        oracle.push_front(val);
+        break;
+      case 1:
+        EXPECT_TRUE(lst.append(val));
+        oracle.push_back(val);
+        break;
+      case 2:
+        EXPECT_TRUE(lst.insert_at(val, pos));
+        oracle.insert(std::find(oracle.begin(), oracle.end(), pos), val);
+        break;
+      case 3: {
+        EXPECT_TRUE(lst.append_at(val, pos));
+        auto it = std::find(oracle.rbegin(), oracle.rend(), pos);
+        oracle.insert(it != oracle.rend() ? it.base() : oracle.end(), val);
+        break;
+      }
+      default: {
+        auto it = std::find(oracle.begin(), oracle.end(), pos);
+        EXPECT_EQ(lst.delete_at(pos), it != oracle.end());
+        if (it != oracle.end())
+          oracle.erase(it);
+      }
+    }
+  }
+  EXPECT_EQ(lst.size(), oracle.size());
+  const auto items = contents_of(lst);
+  ASSERT_EQ(items.size(), oracle.size());
+  EXPECT_TRUE(std::equal(items.begin(), items.end(), oracle.begin()));
+  lst.clear();
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_TRUE(contents_of(lst).empty());
+}
+
+TEST(ConcurrentDblLnkListAssertions, ConcurrentInsertAppendDelete) {
+  concurrent_dbl_lnk_lst<int> lst{};  // <<=== concurrent-dbl-lnk-list
+  std::vector<std::thread> threads{};
+  constexpr int per_thread = ITEM_NBR / THREAD_NBR;
+  for (int t = 0; t < THREAD_NBR; t++) {
+    threads.emplace_back([&lst, t] {
+      const int base = t * per_thread;
+      for (int i = 0; i < per_thread; i++) {
+        if (i % 2 == 0)
+          lst.insert(base + i);
+        else
+          lst.append(base + i);
+      }
+      // every odd value gets a neighbour placed in front of it, every even value one after it
+      for (int i = 0; i < per_thread; i++) {
+        if (i % 2 == 0)
+          lst.append_at(-(base + i) - 1, base + i);
+        else
+          lst.insert_at(-(base + i) - 1, base + i);
+      }
+      // then the original values are all deleted again
+      for (int i = 0; i < per_thread; i++)
+        EXPECT_TRUE(lst.delete_at(base + i));
+    });
+  }
+  for (auto &thrd: threads)
+    thrd.join();
+  EXPECT_EQ(lst.size(), per_thread * THREAD_NBR);
+  auto items = contents_of(lst);
+  ASSERT_EQ(items.size(), per_thread * THREAD_NBR);
+  std::sort(items.begin(), items.end());
+  for (int i = 0; i < per_thread * THREAD_NBR; i++)
+    EXPECT_EQ(items[i], -(per_thread * THREAD_NBR) + i);
+}
+
+TEST(ConcurrentDblLnkListAssertions, ConcurrentNeighboursKeepTheirOrder) {
+  concurrent_dbl_lnk_lst<int> lst{};  // <<=== concurrent-dbl-lnk-list
+  for (int t = 0; t < THREAD_NBR; t++)
+    lst.append(t * ITEM_NBR); // one anchor value per thread
+  std::vector<std::thread> threads{};
+  for (int t = 0; t < THREAD_NBR; t++) {
+    threads.emplace_back([&lst, t] {
+      const int anchor = t * ITEM_NBR;
+      for (int i = 1; i < ITEM_NBR / THREAD_NBR; i++)
+        lst.append_at(anchor + i, anchor + i - 1);
+    });
+  }
+  for (auto &thrd: threads)
+    thrd.join();
+  // each thread's run of values must sit contiguously and in order after its anchor
+  const auto items = contents_of(lst);
+  ASSERT_EQ(items.size(), (ITEM_NBR / THREAD_NBR) * THREAD_NBR);
+  for (size_t i = 0; i < items.size(); i++) {
+    if (items[i] % ITEM_NBR != 0) {
+      ASSERT_GT(i, 0);
+      EXPECT_EQ(items[i], items[i - 1] + 1);
+    }
+  }
+  lst.clear();
+  EXPECT_TRUE(lst.is_empty());
+}
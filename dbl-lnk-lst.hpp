@@ -5,158 +5,397 @@
 #define DBL_LNK_LST_HPP
 
 #include <memory>
+#include <memory_resource>
 #include <concepts>
+#include <iterator>
+#include <ranges>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <unordered_map>
 #include <cassert>
+#include "node-pool.hpp"
+#include "lnk-anchor.hpp"
+#include "lst-stats.hpp"
 
 namespace cust_coll {
 
+  /**
+   * What every list requires of its element type - items are matched by value (the positional
+   * APIs) and are moved into their nodes. Copy construction is only required by the APIs that
+   * copy an item in (the const T& overloads), so move-only types (e.g., std::unique_ptr) can be
+   * stored via the T&& overloads and the emplace APIs, and types that aren't default
+   * constructible via emplace.
+   */
   template <typename T>
   concept lst_elm_type_constraints = requires {
     requires std::equality_comparable<T>;
-    requires std::is_default_constructible_v<T>;
-    requires std::copy_constructible<T>;
     requires std::move_constructible<T>;
   };
 
+  /**
+   * A range whose elements the container's element type T can be constructed from.
+   */
+  template <typename R, typename T>
+  concept lst_compatible_range = std::ranges::input_range<R> &&
+                                 std::constructible_from<T, std::ranges::range_reference_t<R>>;
+
+  /**
+   * List node of dbl_lnk_lst - owns its element value.
+   */
+  template <typename E> requires lst_elm_type_constraints<E>
+  struct lst_node {
+    E value;
+    lst_node<E> *prev{nullptr};  // non-owning plain pointer
+    lst_node<E> *next{nullptr};  // owning plain pointer (freed via the container's node allocator)
+    lst_node()  noexcept = delete;
+    lst_node(const E &item) noexcept : value{item} {}
+    lst_node(E &&item) noexcept : value{std::move(item)} {};
+    // constructs the value in place from args
+    template <typename... Args>
+    explicit lst_node(std::in_place_t, Args&&... args) noexcept : value(std::forward<Args>(args)...) {}
+    lst_node& operator=(const E &item) = delete;
+    lst_node& operator=(E &&item) = delete;
+    ~lst_node() noexcept = default;
+  };
+
   /**
    * A classic CS-101 doubly-linked-list container template, but with C++ flair.
    *
-   * Supports forward and reverse iteration via begin()/end() and rbegin()/rend().
+   * Supports forward and reverse iteration via begin()/end() and rbegin()/rend() (and const
+   * counterparts) - the iterators are bidirectional, so the list is a std::ranges::bidirectional_range.
+   *
+   * Nodes are obtained from the Alloc allocator (rebound to the node type) - use std::allocator
+   * (the default), pool_allocator (see node-pool.hpp) for slab allocated nodes, or the
+   * cust_coll::pmr::dbl_lnk_lst alias for a std::pmr::memory_resource.
    *
    * @tparam T type of element contained by container - as constrained by
    *           concept lst_elm_type_constraints (see above)
+   * @tparam Alloc allocator type - is rebound to allocate the list nodes
+   * @tparam Stats stats policy - no_lst_stats (the default) records nothing at no cost, whereas
+   *               lst_stats_collector counts operations, scan lengths and allocation failures
+   *               for stats() (see lst-stats.hpp)
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  class dbl_lnk_lst {
+  template <typename T, typename Alloc = std::allocator<T>, typename Stats = no_lst_stats>
+    requires lst_elm_type_constraints<T>
+  class dbl_lnk_lst : protected lnk_anchor<lst_node<T>> {
   protected:
-    template <typename E> requires lst_elm_type_constraints<E>
-    struct lst_node {
-      E value{};
-      lst_node<E> *prev{nullptr};           // non-owning plain pointer
-      std::unique_ptr<lst_node<E>> next{};  // owning smart pointer
-      lst_node()  noexcept = delete;
-      lst_node(const E &item) noexcept : value{item} {}
-      lst_node(E &&item) noexcept : value{std::move(item)} {};
-      lst_node& operator=(const E &item) = delete;
-      lst_node& operator=(E &&item) = delete;
-      ~lst_node() noexcept = default;
-    };
+    using anchor = lnk_anchor<lst_node<T>>;
+    using node_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<lst_node<T>>;
+    using node_alloc_traits = std::allocator_traits<node_alloc_t>;
   protected:
-    std::unique_ptr<lst_node<T>> head{};  // owning smart pointer
-    lst_node<T> *tail{nullptr};           // non-owning plain pointer
+    using anchor::head;  // owning plain pointer
+    using anchor::tail;  // non-owning plain pointer
     size_t count{0};
-    void insert_at_head(lst_node<T> *node) noexcept;
-    void append_at_tail(lst_node<T> *node) noexcept;
+    [[no_unique_address]] node_alloc_t node_alloc{};
+    [[no_unique_address]] mutable Stats stats_rec{};  // (is recorded into by the const lookups too)
+    template <typename... Args> lst_node<T>* new_node(Args&&... args) noexcept;
+    void free_node(lst_node<T> *node) noexcept;
+    using anchor::insert_at_head;
+    using anchor::append_at_tail;
+    using anchor::link_before;
+    using anchor::link_after;
+    using anchor::unlink;
+    using anchor::link_chain_before;
+    using anchor::unlink_chain;
+    lst_node<T>* find_first(const T&pos) const noexcept;
+    lst_node<T>* find_last(const T&pos) const noexcept;
     void insert_at_position(const T&pos, lst_node<T> *node) noexcept;
     void append_at_position(const T&pos, lst_node<T> *node) noexcept;
+    template <bool Move, typename It, typename S>
+    bool link_new_chain(lst_node<T> *pos_node, It first, S last, size_t nbr_hint = 0) noexcept;
+    template <typename R> bool link_new_range(lst_node<T> *pos_node, R &&rng) noexcept;
+    template <typename Pred> size_t unlink_matching(Pred &pred, size_t max_nbr) noexcept;
+    void free_chain(lst_node<T> *first) noexcept;
   public:
-    dbl_lnk_lst()  noexcept = default;
+    using allocator_type = Alloc;
+    dbl_lnk_lst() noexcept(std::is_nothrow_default_constructible_v<node_alloc_t>) = default;
+    explicit dbl_lnk_lst(const Alloc &alloc) noexcept : node_alloc{alloc} {}
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    dbl_lnk_lst(It first, S last) noexcept(std::is_nothrow_default_constructible_v<node_alloc_t>)
+      { append_range(std::move(first), std::move(last)); }
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    dbl_lnk_lst(It first, S last, const Alloc &alloc) noexcept : node_alloc{alloc}
+      { append_range(std::move(first), std::move(last)); }
+    template <lst_compatible_range<T> R> requires (not std::same_as<std::remove_cvref_t<R>, dbl_lnk_lst>)
+    explicit dbl_lnk_lst(R &&rng) noexcept(std::is_nothrow_default_constructible_v<node_alloc_t>)
+      { append_range(std::forward<R>(rng)); }
+    template <lst_compatible_range<T> R> requires (not std::same_as<std::remove_cvref_t<R>, dbl_lnk_lst>)
+    dbl_lnk_lst(R &&rng, const Alloc &alloc) noexcept : node_alloc{alloc} { append_range(std::forward<R>(rng)); }
+    dbl_lnk_lst(const dbl_lnk_lst&) = delete;
+    dbl_lnk_lst& operator=(const dbl_lnk_lst&) = delete;
+    dbl_lnk_lst(dbl_lnk_lst &&other) noexcept;
+    dbl_lnk_lst& operator=(dbl_lnk_lst &&other) noexcept;
     ~dbl_lnk_lst() noexcept { clear(); }
+    void swap(dbl_lnk_lst &other) noexcept;
+    friend void swap(dbl_lnk_lst &a, dbl_lnk_lst &b) noexcept { a.swap(b); }
+    Alloc get_allocator() const noexcept { return Alloc{node_alloc}; }
     size_t size() const noexcept { return count; }
     bool is_empty() const noexcept { return count == 0; }
-    bool insert(const T& item) noexcept;
+    bool insert(const T& item) noexcept requires std::copy_constructible<T>;
     bool insert(T &&item) noexcept;
-    bool insert_at(const T& item, const T&pos) noexcept;
+    bool insert_at(const T& item, const T&pos) noexcept requires std::copy_constructible<T>;
     bool insert_at(T &&item, const T&pos) noexcept;
-    bool append(const T& item) noexcept;
+    bool append(const T& item) noexcept requires std::copy_constructible<T>;
     bool append(T &&item) noexcept;
-    bool append_at(const T& item, const T&pos) noexcept;
+    bool append_at(const T& item, const T&pos) noexcept requires std::copy_constructible<T>;
     bool append_at(T &&item, const T&pos) noexcept;
+    template <typename... Args> requires std::constructible_from<T, Args...>
+    bool emplace_front(Args&&... args) noexcept;
+    template <typename... Args> requires std::constructible_from<T, Args...>
+    bool emplace_back(Args&&... args) noexcept;
+    template <typename... Args> requires std::constructible_from<T, Args...>
+    bool emplace_at(const T&pos, Args&&... args) noexcept;
+    template <typename... Args> requires std::constructible_from<T, Args...>
+    bool emplace_after(const T&pos, Args&&... args) noexcept;
     bool delete_at(const T&pos) noexcept;
+    template <typename Pred> requires std::predicate<Pred&, const T&> size_t remove_if(Pred pred) noexcept;
+    size_t remove(const T&value) noexcept;
+    template <lst_compatible_range<T> R, typename Hash = std::hash<T>>
+      requires std::ranges::forward_range<R> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+    size_t delete_many(R &&values, const Hash &hash = Hash{}) noexcept;
+    template <lst_compatible_range<T> R> bool insert_range(R &&rng) noexcept;
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    bool insert_range(It first, S last) noexcept;
+    template <lst_compatible_range<T> R> bool insert_range_at(R &&rng, const T&pos) noexcept;
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    bool insert_range_at(It first, S last, const T&pos) noexcept;
+    template <lst_compatible_range<T> R> bool append_range(R &&rng) noexcept;
+    template <std::input_iterator It, std::sentinel_for<It> S>
+      requires std::constructible_from<T, std::iter_reference_t<It>>
+    bool append_range(It first, S last) noexcept;
     void clear() noexcept;
+    lst_stats stats() const noexcept requires Stats::enabled;
+    void reset_stats() noexcept requires Stats::enabled { stats_rec = Stats{}; }
 
-    class iterator {
+    /**
+     * Bidirectional iterator - Reverse iterates from tail to head (so ++ moves to the prev node),
+     * Const gives read-only access to the items. Direction is fixed at compile time, so advancing
+     * is a single load of the next (or prev) link. Also refers to the list, so that the end
+     * iterator can be decremented to the last item.
+     */
+    template <bool Reverse, bool Const>
+    class basic_iterator {
     public:
-      using get_next_node_t = lst_node<T> *(*)(lst_node<T> *) noexcept;
-    protected:
+      using iterator_concept  = std::bidirectional_iterator_tag;
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
       using value_type  = T;
-      using pointer     = T*;
-      using reference   = T&;
-      lst_node<T> *node{nullptr};
-      get_next_node_t get_next_node = [](lst_node<T> *) noexcept -> lst_node<T>* { return nullptr; };
+      using pointer     = std::conditional_t<Const, const T*, T*>;
+      using reference   = std::conditional_t<Const, const T&, T&>;
+    protected:
+      lst_node<T> *node{nullptr};       // non-owning plain pointer (null at end)
+      const dbl_lnk_lst *lst{nullptr};  // non-owning plain pointer
+      friend class dbl_lnk_lst;
+      template <bool, bool> friend class basic_iterator;
+      basic_iterator(lst_node<T> *n, const dbl_lnk_lst *l) noexcept : node{n}, lst{l} {}
     public:
-      iterator() noexcept = default;
-      iterator(get_next_node_t next_node, lst_node<T> *n) noexcept : node{n}, get_next_node{next_node} {}
+      basic_iterator() noexcept = default;
+      // a non-const iterator converts to its const counterpart
+      template <bool C = Const> requires C
+      basic_iterator(const basic_iterator<Reverse, false> &oth) noexcept : node{oth.node}, lst{oth.lst} {}
       // Prefix increment
-      iterator& operator++() { node = get_next_node(node); return *this; }
+      basic_iterator& operator++() noexcept {
+        node = Reverse ? node->prev : node->next;
+        return *this;
+      }
       // Postfix increment
-      iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
-      friend bool operator==(const iterator& a, const iterator& b) noexcept { return a.node == b.node; };
-      friend bool operator!=(const iterator& a, const iterator& b) noexcept { return a.node != b.node; };
-      T& operator*() { return node->value; }
-      T* operator->() { return &node->value; }
+      basic_iterator operator++(int) noexcept { basic_iterator tmp = *this; ++(*this); return tmp; }
+      // Prefix decrement (end() decrements to the last item in iteration order)
+      basic_iterator& operator--() noexcept {
+        if (node != nullptr)
+          node = Reverse ? node->next : node->prev;
+        else
+          node = Reverse ? lst->head : lst->tail;
+        return *this;
+      }
+      // Postfix decrement
+      basic_iterator operator--(int) noexcept { basic_iterator tmp = *this; --(*this); return tmp; }
+      friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.node == b.node; };
+      reference operator*() const noexcept { return node->value; }
+      pointer operator->() const noexcept { return &node->value; }
+    };
+    using iterator = basic_iterator<false, false>;
+    using const_iterator = basic_iterator<false, true>;
+    using reverse_iterator = basic_iterator<true, false>;
+    using const_reverse_iterator = basic_iterator<true, true>;
+    iterator begin() noexcept { return iterator{head, this}; }
+    iterator end() noexcept { return iterator{nullptr, this}; }
+    const_iterator begin() const noexcept { return const_iterator{head, this}; }
+    const_iterator end() const noexcept { return const_iterator{nullptr, this}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator{tail, this}; }
+    reverse_iterator rend() noexcept { return reverse_iterator{nullptr, this}; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{tail, this}; }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator{nullptr, this}; }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+  protected:
+    // node an iterator refers to (null at end) - for derived containers to reach it by
+    template <bool R, bool C> static lst_node<T>* node_of(basic_iterator<R, C> it) noexcept { return it.node; }
+    template <bool R, typename U>
+    basic_iterator<R, false> insert_node_at(lst_node<T> *pos_node, U &&item, bool before) noexcept;
+  public:
+    template <bool R, bool C> basic_iterator<R, false> insert_before(basic_iterator<R, C> pos, const T& item) noexcept
+      requires std::copy_constructible<T>;
+    template <bool R, bool C> basic_iterator<R, false> insert_before(basic_iterator<R, C> pos, T &&item) noexcept;
+    template <bool R, bool C> basic_iterator<R, false> insert_after(basic_iterator<R, C> pos, const T& item) noexcept
+      requires std::copy_constructible<T>;
+    template <bool R, bool C> basic_iterator<R, false> insert_after(basic_iterator<R, C> pos, T &&item) noexcept;
+    template <bool R, bool C> basic_iterator<R, false> erase(basic_iterator<R, C> pos) noexcept;
+    template <bool R, bool C> basic_iterator<R, false> erase(basic_iterator<R, C> first, basic_iterator<R, C> last) noexcept;
+
+    /**
+     * Node handle (same idea as std::map::node_type) - owns a node taken out of a list by extract(),
+     * until insert()/append() link it into a list again, with no allocation and no move of its
+     * item. The item can be accessed (and modified) via value() while detached. A handle that is
+     * dropped frees its node.
+     */
+    class node_type {
+    protected:
+      lst_node<T> *node{nullptr};            // owning plain pointer
+      std::optional<node_alloc_t> alloc{};  // allocator the node came from (if any node)
+      friend class dbl_lnk_lst;
+      node_type(lst_node<T> *n, const node_alloc_t &a) noexcept : node{n}, alloc{a} {}
+      void reset() noexcept {
+        if (node != nullptr) {
+          node_alloc_traits::destroy(*alloc, node);
+          node_alloc_traits::deallocate(*alloc, node, 1);
+          node = nullptr;
+        }
+        alloc.reset();
+      }
+      lst_node<T>* release() noexcept { alloc.reset(); return std::exchange(node, nullptr); }
+    public:
+      node_type() noexcept = default;
+      node_type(const node_type&) = delete;
+      node_type& operator=(const node_type&) = delete;
+      node_type(node_type &&other) noexcept : node{std::exchange(other.node, nullptr)}, alloc{std::move(other.alloc)} {
+        other.alloc.reset();
+      }
+      node_type& operator=(node_type &&other) noexcept {
+        if (&other != this) {
+          reset();
+          node = std::exchange(other.node, nullptr);
+          if (other.alloc.has_value())
+            alloc.emplace(*other.alloc); // (emplaced - e.g. polymorphic_allocator isn't assignable)
+          other.alloc.reset();
+        }
+        return *this;
+      }
+      ~node_type() noexcept { reset(); }
+      bool empty() const noexcept { return node == nullptr; }
+      explicit operator bool() const noexcept { return node != nullptr; }
+      T& value() const noexcept {
+        assert(node != nullptr); // (we trust but verify)
+        return node->value;
+      }
+      Alloc get_allocator() const noexcept { return Alloc{*alloc}; }
     };
+    template <bool R, bool C> node_type extract(basic_iterator<R, C> pos) noexcept;
+    node_type extract(const T&value) noexcept;
+    bool insert(node_type &&nh) noexcept;
+    bool append(node_type &&nh) noexcept;
   protected:
-    static lst_node<T> *frwd(lst_node<T> *n) noexcept { return n->next.get(); }
-    static lst_node<T> *bkwd(lst_node<T> *n) noexcept { return n->prev; }
+    lst_node<T>* adopt_node(node_type &nh) noexcept;
   public:
-    iterator begin() noexcept { return iterator{frwd, head.get()}; }
-    iterator end() noexcept { return iterator{}; }
-    iterator rbegin() noexcept { return iterator{bkwd, tail}; }
-    iterator rend() noexcept { return iterator{}; }
+    void splice(const_iterator pos, dbl_lnk_lst &other) noexcept;
+    void splice(const_iterator pos, dbl_lnk_lst &other, const_iterator it) noexcept;
+    void splice(const_iterator pos, dbl_lnk_lst &other, const_iterator first, const_iterator last) noexcept;
+    // O(1) transfer of all the items of other to tail of list (same as splice at end())
+    void splice_back(dbl_lnk_lst &other) noexcept { splice(cend(), other); }
+    void concat(dbl_lnk_lst &&other) noexcept { splice(cend(), other); }
+  protected:
+    static constexpr size_t min_parallel_sort_segment = 4096;
+    template <typename Compare>
+    static lst_node<T>* merge_chains(lst_node<T> *a, lst_node<T> *b, Compare &comp) noexcept;
+    template <typename Compare> static lst_node<T>* sort_chain(lst_node<T> *first, Compare &comp) noexcept;
+    void relink_chain(lst_node<T> *first) noexcept;
+    template <typename F> static void run_parallel(size_t nbr, F &&f) noexcept;
+  public:
+    void sort() noexcept { sort(std::less<>{}); }
+    template <typename Compare> void sort(Compare comp) noexcept;
+    void parallel_sort(size_t nbr_threads = 0) noexcept { parallel_sort(std::less<>{}, nbr_threads); }
+    template <typename Compare> void parallel_sort(Compare comp, size_t nbr_threads = 0) noexcept;
+    void merge(dbl_lnk_lst &other) noexcept { merge(other, std::less<>{}); }
+    template <typename Compare> void merge(dbl_lnk_lst &other, Compare comp) noexcept;
   };
 
-  template <typename T> requires lst_elm_type_constraints<T>
-  inline void dbl_lnk_lst<T>::insert_at_head(lst_node<T> *const node) noexcept {
-    if (head) {
-      auto *const next_node = head.release(); // transferring ownership (not using assignment via std::move() for reasons)
-      next_node->prev = node;
-      node->next.reset(next_node); // new node taking ownership of next node
-      head.reset(node);  // head taking ownership of the new node
-    } else {
-      head.reset(node);  // head taking ownership of the new node
-      tail = head.get(); // tail set to point at the last node
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename... Args>
+  inline auto dbl_lnk_lst<T, Alloc, Stats>::new_node(Args&&... args) noexcept -> lst_node<T>* {
+    lst_node<T> *node;
+    try {
+      node = node_alloc_traits::allocate(node_alloc, 1);
+    } catch (...) {
+      stats_rec.on_alloc_failure();
+      return nullptr; // allocation failure is reported as a false return by the public APIs
     }
+    node_alloc_traits::construct(node_alloc, node, std::forward<Args>(args)...);
+    return node;
   }
 
-  template <typename T> requires lst_elm_type_constraints<T>
-  inline void dbl_lnk_lst<T>::append_at_tail(lst_node<T> *const node) noexcept {
-    if (tail != nullptr) {
-      node->prev = tail;
-      assert(tail->next.get() == nullptr); // (we trust but verify)
-      tail->next.reset(node); // taking ownership of the new node
-      tail = node; // newly appended node is now the tail node
-    } else {
-      insert_at_head(node);
-    }
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  inline void dbl_lnk_lst<T, Alloc, Stats>::free_node(lst_node<T> *const node) noexcept {
+    node_alloc_traits::destroy(node_alloc, node);
+    node_alloc_traits::deallocate(node_alloc, node, 1);
   }
 
-  template <typename T> requires lst_elm_type_constraints<T>
-  void dbl_lnk_lst<T>::insert_at_position(const T&pos, lst_node<T> *const node) noexcept {
-    for (auto *curr_node = head.get(); curr_node != nullptr; curr_node = curr_node->next.get()) {
+  /**
+   * @return first node, starting from head of list, whose value matches pos (or null)
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  auto dbl_lnk_lst<T, Alloc, Stats>::find_first(const T&pos) const noexcept -> lst_node<T>* {
+    size_t nbr_visited = 0;
+    for (auto *curr_node = head; curr_node != nullptr; curr_node = curr_node->next) {
+      nbr_visited++;
       if (curr_node->value == pos) {
-        auto *const prev_node = curr_node->prev;
-        if (curr_node->prev != nullptr) {
-          prev_node->next.release();   // ceases ownership of this pos-matching node without freeing it
-          node->next.reset(curr_node); //  takes ownership of this pos-matching node
-          node->prev = prev_node;
-          prev_node->next.reset(node); // prev_node takes ownership of the newly inserted node
-        } else {   // means pos-matching curr_node is the head node
-          assert(curr_node == head.get()); // (we trust but verify)
-          insert_at_head(node);
-        }
-        return;
+        stats_rec.on_scan(nbr_visited, true);
+        return curr_node;
       }
     }
-    append_at_tail(node);
+    stats_rec.on_scan(nbr_visited, false);
+    return nullptr;
   }
 
-  template <typename T> requires lst_elm_type_constraints<T>
-  void dbl_lnk_lst<T>::append_at_position(const T&pos, lst_node<T> *const node) noexcept {
+  /**
+   * @return first node, starting from tail of list, whose value matches pos (or null)
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  auto dbl_lnk_lst<T, Alloc, Stats>::find_last(const T&pos) const noexcept -> lst_node<T>* {
+    size_t nbr_visited = 0;
     for (auto *curr_node = tail; curr_node != nullptr; curr_node = curr_node->prev) {
+      nbr_visited++;
       if (curr_node->value == pos) {
-        auto *const next_node = curr_node->next.release(); // ceases ownership of next node without freeing it
-        if (next_node != nullptr) {
-          node->next.reset(next_node); // new node takes ownership of next node
-          node->prev = curr_node;
-          curr_node->next.reset(node); // curr_node takes ownership of the newly inserted node
-          return;
-        } else { // means pos-matching curr_node is the tail node
-          assert(curr_node == tail);     // (we trust but verify)
-        }
+        stats_rec.on_scan(nbr_visited, true);
+        return curr_node;
       }
     }
-    append_at_tail(node);
+    stats_rec.on_scan(nbr_visited, false);
+    return nullptr;
+  }
+
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  void dbl_lnk_lst<T, Alloc, Stats>::insert_at_position(const T&pos, lst_node<T> *const node) noexcept {
+    if (auto *const pos_node = find_first(pos); pos_node != nullptr)
+      link_before(pos_node, node);
+    else
+      append_at_tail(node);
+  }
+
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  void dbl_lnk_lst<T, Alloc, Stats>::append_at_position(const T&pos, lst_node<T> *const node) noexcept {
+    if (auto *const pos_node = find_last(pos); pos_node != nullptr)
+      link_after(pos_node, node);
+    else
+      append_at_tail(node);
   }
 
   /**
@@ -165,9 +404,10 @@ namespace cust_coll {
    * @param item to be copy-inserted
    * @return returns false when fails to allocate memory for new list item
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  bool dbl_lnk_lst<T>::insert(const T& item) noexcept {
-    auto *const node = new (std::nothrow) lst_node<T>{item};
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::insert(const T& item) noexcept requires std::copy_constructible<T> {
+    stats_rec.on_op(lst_op::insert);
+    auto *const node = new_node(item);
     if (node != nullptr) {
       insert_at_head(node);
       count++;
@@ -182,9 +422,10 @@ namespace cust_coll {
    * @param item to be move-inserted
    * @return returns false when fails to allocate memory for new list item
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  bool dbl_lnk_lst<T>::insert(T &&item) noexcept {
-    auto *const node = new (std::nothrow) lst_node<T>{std::move(item)};
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::insert(T &&item) noexcept {
+    stats_rec.on_op(lst_op::insert);
+    auto *const node = new_node(std::move(item));
     if (node != nullptr) {
       insert_at_head(node);
       count++;
@@ -202,9 +443,10 @@ namespace cust_coll {
    * @param pos item to be inserted in front of
    * @return returns false when fails to allocate memory for new list item
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  bool dbl_lnk_lst<T>::insert_at(const T& item, const T&pos) noexcept {
-    auto *const node = new (std::nothrow) lst_node<T>{item};
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::insert_at(const T& item, const T&pos) noexcept requires std::copy_constructible<T> {
+    stats_rec.on_op(lst_op::insert_at);
+    auto *const node = new_node(item);
     if (node != nullptr) {
       insert_at_position(pos, node);
       count++;
@@ -222,9 +464,10 @@ namespace cust_coll {
    * @param pos item to be inserted in front of
    * @return returns false when fails to allocate memory for new list item
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  bool dbl_lnk_lst<T>::insert_at(T &&item, const T&pos) noexcept {
-    auto *const node = new (std::nothrow) lst_node<T>{std::move(item)};
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::insert_at(T &&item, const T&pos) noexcept {
+    stats_rec.on_op(lst_op::insert_at);
+    auto *const node = new_node(std::move(item));
     if (node != nullptr) {
       insert_at_position(pos, node);
       count++;
@@ -239,9 +482,10 @@ namespace cust_coll {
    * @param item to be copy-inserted
    * @return returns false when fails to allocate memory for new list item
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  bool dbl_lnk_lst<T>::append(const T& item) noexcept {
-    auto *const node = new (std::nothrow) lst_node<T>{item};
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::append(const T& item) noexcept requires std::copy_constructible<T> {
+    stats_rec.on_op(lst_op::append);
+    auto *const node = new_node(item);
     if (node != nullptr) {
       append_at_tail(node);
       count++;
@@ -256,9 +500,10 @@ namespace cust_coll {
    * @param item to be move-inserted
    * @return returns false when fails to allocate memory for new list item
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  bool dbl_lnk_lst<T>::append(T &&item) noexcept {
-    auto *const node = new (std::nothrow) lst_node<T>{std::move(item)};
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::append(T &&item) noexcept {
+    stats_rec.on_op(lst_op::append);
+    auto *const node = new_node(std::move(item));
     if (node != nullptr) {
       append_at_tail(node);
       count++;
@@ -276,9 +521,10 @@ namespace cust_coll {
    * @param pos item to be inserted after
    * @return returns false when fails to allocate memory for new list item
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  bool dbl_lnk_lst<T>::append_at(const T& item, const T&pos) noexcept {
-    auto *const node = new (std::nothrow) lst_node<T>{item};
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::append_at(const T& item, const T&pos) noexcept requires std::copy_constructible<T> {
+    stats_rec.on_op(lst_op::append_at);
+    auto *const node = new_node(item);
     if (node != nullptr) {
       append_at_position(pos, node);
       count++;
@@ -296,9 +542,91 @@ namespace cust_coll {
    * @param pos item to be inserted after
    * @return returns false when fails to allocate memory for new list item
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  bool dbl_lnk_lst<T>::append_at(T &&item, const T&pos) noexcept {
-    auto *const node = new (std::nothrow) lst_node<T>{std::move(item)};
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::append_at(T &&item, const T&pos) noexcept {
+    stats_rec.on_op(lst_op::append_at);
+    auto *const node = new_node(std::move(item));
+    if (node != nullptr) {
+      append_at_position(pos, node);
+      count++;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Constructs an item in place from args (no temporary T is copied or moved) in a new node at
+   * head of list.
+   * @tparam T item's type
+   * @param args arguments passed to a constructor of T
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename... Args> requires std::constructible_from<T, Args...>
+  bool dbl_lnk_lst<T, Alloc, Stats>::emplace_front(Args&&... args) noexcept {
+    stats_rec.on_op(lst_op::insert);
+    auto *const node = new_node(std::in_place, std::forward<Args>(args)...);
+    if (node != nullptr) {
+      insert_at_head(node);
+      count++;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Constructs an item in place from args in a new node at tail of list.
+   * @tparam T item's type
+   * @param args arguments passed to a constructor of T
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename... Args> requires std::constructible_from<T, Args...>
+  bool dbl_lnk_lst<T, Alloc, Stats>::emplace_back(Args&&... args) noexcept {
+    stats_rec.on_op(lst_op::append);
+    auto *const node = new_node(std::in_place, std::forward<Args>(args)...);
+    if (node != nullptr) {
+      append_at_tail(node);
+      count++;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Constructs an item in place from args in a new node in front of the pos matched item
+   * (the first match starting from head of list) - same placement as insert_at().
+   * @tparam T item's type
+   * @param pos item to be matched as the insertion point
+   * @param args arguments passed to a constructor of T
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename... Args> requires std::constructible_from<T, Args...>
+  bool dbl_lnk_lst<T, Alloc, Stats>::emplace_at(const T&pos, Args&&... args) noexcept {
+    stats_rec.on_op(lst_op::insert_at);
+    auto *const node = new_node(std::in_place, std::forward<Args>(args)...);
+    if (node != nullptr) {
+      insert_at_position(pos, node);
+      count++;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Constructs an item in place from args in a new node right after the pos matched item
+   * (the first match starting from tail of list) - same placement as append_at().
+   * @tparam T item's type
+   * @param pos item to be matched as the insertion point
+   * @param args arguments passed to a constructor of T
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename... Args> requires std::constructible_from<T, Args...>
+  bool dbl_lnk_lst<T, Alloc, Stats>::emplace_after(const T&pos, Args&&... args) noexcept {
+    stats_rec.on_op(lst_op::append_at);
+    auto *const node = new_node(std::in_place, std::forward<Args>(args)...);
     if (node != nullptr) {
       append_at_position(pos, node);
       count++;
@@ -313,53 +641,873 @@ namespace cust_coll {
    * @param pos item to be removed
    * @return returns true if item was matched and removed from list
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  bool dbl_lnk_lst<T>::delete_at(const T&pos) noexcept {
-    for (auto *curr_node = head.get(); curr_node != nullptr; curr_node = curr_node->next.get()) {
-      if (curr_node->value == pos) {
-        auto *curr_next_node = curr_node->next.release(); // ceases ownership of next node without freeing it
-        if (auto *const prev_node = curr_node->prev; prev_node != nullptr) {
-          if (curr_next_node != nullptr)
-            curr_next_node->prev = prev_node;
-          if (tail == curr_node)
-            tail = prev_node;
-          prev_node->next.reset(curr_next_node); // transfer ownership (curr_node is also deleted)
-        } else {   // means pos-matching curr_node is the head node
-          assert(curr_node == head.get()); // (we trust but verify)
-          if (curr_next_node != nullptr)
-            curr_next_node->prev = nullptr;
-          head.reset(curr_next_node); // transfer ownership (curr_node is also deleted)
-          if (curr_next_node = head.get(); curr_next_node == nullptr)
-            tail = nullptr;
-          else if (curr_next_node->next.get() == nullptr)
-            tail = curr_next_node;
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::delete_at(const T&pos) noexcept {
+    stats_rec.on_op(lst_op::delete_at);
+    if (auto *const node = find_first(pos); node != nullptr) {
+      unlink(node);
+      free_node(node);
+      count--;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Unlinks, in a single walk from head of list, the nodes whose value pred matches - stopping
+   * once max_nbr of them have been unlinked. The nodes kept are relinked to each other as the walk
+   * goes (rather than unlinking each match from its neighbours), the unlinked ones are then freed
+   * as one batch.
+   * @return number of nodes unlinked and freed
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename Pred>
+  size_t dbl_lnk_lst<T, Alloc, Stats>::unlink_matching(Pred &pred, const size_t max_nbr) noexcept {
+    lst_node<T> *doomed = nullptr;   // chain (via next) of the unlinked nodes
+    lst_node<T> *last_kept = nullptr;
+    size_t nbr = 0;
+    auto *node = head;
+    while (node != nullptr && nbr < max_nbr) {
+      auto *const next_node = node->next;
+      if (pred(std::as_const(node->value))) {
+        node->next = doomed;
+        doomed = node;
+        nbr++;
+      } else {
+        node->prev = last_kept;
+        if (last_kept != nullptr)
+          last_kept->next = node;
+        else
+          head = node;
+        last_kept = node;
+      }
+      node = next_node;
+    }
+    if (nbr == 0)
+      return 0;
+    if (node != nullptr) { // stopped early - the rest of the list is kept as is
+      node->prev = last_kept;
+    } else {
+      tail = last_kept;
+    }
+    if (last_kept != nullptr)
+      last_kept->next = node;
+    else
+      head = node;
+    count -= nbr;
+    free_chain(doomed);
+    return nbr;
+  }
+
+  /**
+   * Frees the chain (via next) of nodes starting at first, which have been unlinked from the list.
+   * When that has left the list empty and the node allocator is a pool that isn't shared with any
+   * other container (see pool_allocator) then the pool's slabs are given back in one go instead
+   * of freeing node by node (and for trivially destructible T the chain isn't walked at all).
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  void dbl_lnk_lst<T, Alloc, Stats>::free_chain(lst_node<T> *const first) noexcept {
+    if constexpr (bulk_releasable_alloc<node_alloc_t>) {
+      if (head == nullptr && node_alloc.owns_pool_exclusively()) {
+        if constexpr (not std::is_trivially_destructible_v<T>) {
+          for (auto *node = first; node != nullptr; node = node->next)
+            node_alloc_traits::destroy(node_alloc, node);
         }
-        count--;
-        return true;
+        node_alloc.release();
+        return;
       }
     }
+    for (auto *node = first; node != nullptr;) {
+      auto *const next_node = node->next;
+      free_node(node);
+      node = next_node;
+    }
+  }
+
+  /**
+   * Removes all items that pred matches, in a single pass over the list.
+   * @tparam T item's type
+   * @param pred predicate called on each item (once, in list order)
+   * @return number of items removed
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename Pred> requires std::predicate<Pred&, const T&>
+  size_t dbl_lnk_lst<T, Alloc, Stats>::remove_if(Pred pred) noexcept {
+    stats_rec.on_op(lst_op::remove_if);
+    return unlink_matching(pred, SIZE_MAX);
+  }
+
+  /**
+   * Removes all items that match value (whereas delete_at() removes only the first), in a single
+   * pass over the list.
+   * @tparam T item's type
+   * @param value item to be removed
+   * @return number of items removed
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  size_t dbl_lnk_lst<T, Alloc, Stats>::remove(const T&value) noexcept {
+    stats_rec.on_op(lst_op::remove);
+    auto matches = [&value](const T &item) { return item == value; };
+    return unlink_matching(matches, SIZE_MAX);
+  }
+
+  /**
+   * Same as calling delete_at() for each of values - i.e., for each value, the first matching
+   * item (starting from head of list) not already removed is removed - but in a single pass over
+   * the list: values are counted into a temporary hash map, which each item is looked up in. The
+   * pass stops once all values have been matched. Should the hash map fail to allocate memory,
+   * falls back to calling delete_at() for each value.
+   * @tparam T item's type
+   * @param values items to be removed
+   * @param hash hash function object for T (consistent with T::operator==)
+   * @return number of items removed
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <lst_compatible_range<T> R, typename Hash>
+    requires std::ranges::forward_range<R> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  size_t dbl_lnk_lst<T, Alloc, Stats>::delete_many(R &&values, const Hash &hash) noexcept {
+    stats_rec.on_op(lst_op::delete_many);
+    std::unordered_map<T, size_t, Hash> pending{0, hash};
+    size_t nbr_pending = 0;
+    try {
+      for (auto &&value : values) {
+        pending.try_emplace(T(value), 0).first->second++;
+        nbr_pending++;
+      }
+    } catch (...) {
+      size_t nbr = 0;
+      for (auto &&value : values)
+        nbr += delete_at(T(value)) ? 1 : 0;
+      return nbr;
+    }
+    if (nbr_pending == 0)
+      return 0;
+    auto is_pending = [&pending](const T &item) {
+      const auto it = pending.find(item);
+      if (it == pending.end() || it->second == 0)
+        return false;
+      it->second--;
+      return true;
+    };
+    return unlink_matching(is_pending, nbr_pending);
+  }
+
+  /**
+   * Takes over the nodes of other - O(1), nothing is allocated, copied or moved. The node
+   * allocator is copied (not moved) so that other remains usable; other is left empty.
+   * @tparam T item's type
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  dbl_lnk_lst<T, Alloc, Stats>::dbl_lnk_lst(dbl_lnk_lst &&other) noexcept : node_alloc{other.node_alloc} {
+    head = other.head;
+    tail = other.tail;
+    count = other.count;
+    other.head = other.tail = nullptr;
+    other.count = 0;
+  }
+
+  /**
+   * Frees the items of this list then takes over the nodes of other - O(1) when the node allocator
+   * propagates on move assignment (see std::allocator_traits) or the allocators compare equal.
+   * Otherwise this list's allocator can't free other's nodes, so the items are moved into newly
+   * allocated nodes instead (should that allocation fail, this list is left empty). Either way
+   * other is left empty.
+   * @tparam T item's type
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  auto dbl_lnk_lst<T, Alloc, Stats>::operator=(dbl_lnk_lst &&other) noexcept -> dbl_lnk_lst& {
+    if (&other == this)
+      return *this;
+    clear();
+    if constexpr (not node_alloc_traits::propagate_on_container_move_assignment::value) {
+      if (not (node_alloc == other.node_alloc)) {
+        link_new_chain<true>(nullptr, other.begin(), other.end(), other.count);
+        other.clear();
+        return *this;
+      }
+    } else {
+      node_alloc = other.node_alloc;
+    }
+    head = other.head;
+    tail = other.tail;
+    count = other.count;
+    other.head = other.tail = nullptr;
+    other.count = 0;
+    return *this;
+  }
+
+  /**
+   * Exchanges the items of the two lists - O(1), nothing is allocated, copied or moved. The node
+   * allocators are swapped when they propagate on swap (see std::allocator_traits), otherwise
+   * they must compare equal.
+   * @tparam T item's type
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  void dbl_lnk_lst<T, Alloc, Stats>::swap(dbl_lnk_lst &other) noexcept {
+    if constexpr (node_alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(node_alloc, other.node_alloc);
+    } else {
+      assert(node_alloc == other.node_alloc); // (we trust but verify)
+    }
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(count, other.count);
+  }
+
+  /**
+   * Allocates a node for each item of [first, last), linking them to each other off to the side,
+   * then links the whole chain into the list in front of pos_node (at tail of list when pos_node
+   * is null) in one go. When the item count is known up front, a reservable node allocator (see
+   * pool_allocator) is asked to make room for the whole batch first.
+   * @tparam Move whether items are moved out of [first, last) instead of copied
+   * @param nbr_hint number of items in [first, last) when known to the caller (else zero)
+   * @return false when fails to allocate memory for a node - none of the items are then added
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <bool Move, typename It, typename S>
+  bool dbl_lnk_lst<T, Alloc, Stats>::link_new_chain(lst_node<T> *const pos_node, It first, S last,
+                                                    size_t nbr_hint) noexcept {
+    if constexpr (reservable_alloc<node_alloc_t>) {
+      if constexpr (std::sized_sentinel_for<S, It>)
+        nbr_hint = static_cast<size_t>(last - first);
+      try {
+        if (nbr_hint > 1)
+          node_alloc.reserve(nbr_hint);
+      } catch (...) {
+        stats_rec.on_alloc_failure();
+        return false;
+      }
+    }
+    lst_node<T> *chain_first = nullptr, *chain_last = nullptr;
+    size_t nbr = 0;
+    for (; first != last; ++first) {
+      auto &&item = [&first]() -> decltype(auto) {
+        if constexpr (Move)
+          return std::ranges::iter_move(first);
+        else
+          return *first;
+      }();
+      lst_node<T> *node;
+      if constexpr (std::same_as<std::remove_cvref_t<decltype(item)>, T>)
+        node = new_node(std::forward<decltype(item)>(item));
+      else
+        node = new_node(T(std::forward<decltype(item)>(item))); // (converted first)
+      if (node == nullptr) {
+        while (chain_first != nullptr) {
+          auto *const next_node = chain_first->next;
+          free_node(chain_first);
+          chain_first = next_node;
+        }
+        return false;
+      }
+      node->prev = chain_last;
+      if (chain_last != nullptr)
+        chain_last->next = node; // chain's last node takes ownership of the new node
+      else
+        chain_first = node;
+      chain_last = node;
+      nbr++;
+    }
+    if (chain_first != nullptr) {
+      link_chain_before(pos_node, chain_first, chain_last);
+      count += nbr;
+    }
+    return true;
+  }
+
+  /**
+   * Items are moved out of rng when it is an rvalue container (i.e., a range that owns its
+   * elements), otherwise they are copied.
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename R>
+  bool dbl_lnk_lst<T, Alloc, Stats>::link_new_range(lst_node<T> *const pos_node, R &&rng) noexcept {
+    constexpr bool move = not std::is_lvalue_reference_v<R> && not std::ranges::borrowed_range<R>;
+    size_t nbr_hint = 0;
+    if constexpr (std::ranges::sized_range<R>)
+      nbr_hint = static_cast<size_t>(std::ranges::size(rng));
+    return link_new_chain<move>(pos_node, std::ranges::begin(rng), std::ranges::end(rng), nbr_hint);
+  }
+
+  /**
+   * Inserts copies of the items of rng into container where will be at head of list (in the
+   * same order as in rng). The nodes are allocated as a batch and linked in as a whole.
+   * @tparam T item's type
+   * @param rng items to be copy-inserted (or move-inserted when rng is an rvalue container)
+   * @return returns false when fails to allocate memory - none of the items are then inserted
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <lst_compatible_range<T> R>
+  bool dbl_lnk_lst<T, Alloc, Stats>::insert_range(R &&rng) noexcept {
+    stats_rec.on_op(lst_op::insert_range);
+    return link_new_range(head, std::forward<R>(rng));
+  }
+
+  /**
+   * Same as insert_range() above but for the items of [first, last).
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <std::input_iterator It, std::sentinel_for<It> S>
+    requires std::constructible_from<T, std::iter_reference_t<It>>
+  bool dbl_lnk_lst<T, Alloc, Stats>::insert_range(It first, S last) noexcept {
+    stats_rec.on_op(lst_op::insert_range);
+    return link_new_chain<false>(head, std::move(first), std::move(last));
+  }
+
+  /**
+   * Starting from head of list, iterates list forward, looking to match on the pos specified item;
+   * will insert copies of the items of rng in front of the found pos item. If the pos item is not
+   * found then will fall back to appending the items at the end of the list.
+   * @tparam T item's type
+   * @param rng items to be copy-inserted (or move-inserted when rng is an rvalue container)
+   * @param pos item to be inserted in front of
+   * @return returns false when fails to allocate memory - none of the items are then inserted
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <lst_compatible_range<T> R>
+  bool dbl_lnk_lst<T, Alloc, Stats>::insert_range_at(R &&rng, const T&pos) noexcept {
+    stats_rec.on_op(lst_op::insert_range_at);
+    return link_new_range(find_first(pos), std::forward<R>(rng));
+  }
+
+  /**
+   * Same as insert_range_at() above but for the items of [first, last).
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <std::input_iterator It, std::sentinel_for<It> S>
+    requires std::constructible_from<T, std::iter_reference_t<It>>
+  bool dbl_lnk_lst<T, Alloc, Stats>::insert_range_at(It first, S last, const T&pos) noexcept {
+    stats_rec.on_op(lst_op::insert_range_at);
+    return link_new_chain<false>(find_first(pos), std::move(first), std::move(last));
+  }
+
+  /**
+   * Appends copies of the items of rng into container where will be at tail of list. The nodes
+   * are allocated as a batch and linked in as a whole.
+   * @tparam T item's type
+   * @param rng items to be copy-inserted (or move-inserted when rng is an rvalue container)
+   * @return returns false when fails to allocate memory - none of the items are then appended
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <lst_compatible_range<T> R>
+  bool dbl_lnk_lst<T, Alloc, Stats>::append_range(R &&rng) noexcept {
+    stats_rec.on_op(lst_op::append_range);
+    return link_new_range(nullptr, std::forward<R>(rng));
+  }
+
+  /**
+   * Same as append_range() above but for the items of [first, last).
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <std::input_iterator It, std::sentinel_for<It> S>
+    requires std::constructible_from<T, std::iter_reference_t<It>>
+  bool dbl_lnk_lst<T, Alloc, Stats>::append_range(It first, S last) noexcept {
+    stats_rec.on_op(lst_op::append_range);
+    return link_new_chain<false>(nullptr, std::move(first), std::move(last));
+  }
+
+  /**
+   * Removes all items in container, freeing their memory. When the node allocator is a pool
+   * that isn't shared with any other container (see pool_allocator) then the pool's slabs are
+   * given back in one go instead of freeing node by node (and for trivially destructible T the
+   * list isn't walked at all).
+   * @tparam T item's type
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  void dbl_lnk_lst<T, Alloc, Stats>::clear() noexcept {
+    stats_rec.on_op(lst_op::clear);
+    stats_rec.on_clear(count);
+    auto *const first = head;
+    head = tail = nullptr;
+    count = 0;
+    free_chain(first);
+  }
+
+  /**
+   * @return snapshot of the operation statistics recorded since construction (or the last
+   *         reset_stats()), along with the node count and node memory currently in use
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  lst_stats dbl_lnk_lst<T, Alloc, Stats>::stats() const noexcept requires Stats::enabled {
+    auto snapshot = stats_rec.counters;
+    snapshot.nodes_in_use = count;
+    snapshot.bytes_in_use = count * sizeof(lst_node<T>);
+    return snapshot;
+  }
+
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <bool R, typename U>
+  auto dbl_lnk_lst<T, Alloc, Stats>::insert_node_at(lst_node<T> *const pos_node, U &&item, const bool before) noexcept
+    -> basic_iterator<R, false>
+  {
+    auto *const node = new_node(std::forward<U>(item));
+    if (node == nullptr)
+      return basic_iterator<R, false>{nullptr, this};
+    if (pos_node == nullptr) {
+      if (before)
+        append_at_tail(node);
+      else
+        insert_at_head(node);
+    } else if (before) {
+      link_before(pos_node, node);
+    } else {
+      link_after(pos_node, node);
+    }
+    count++;
+    return basic_iterator<R, false>{node, this};
+  }
+
+  /**
+   * Inserts copy of item into container in front of (i.e., on the head side of) the node referred
+   * to by pos - no scan of the list takes place. If pos is an end iterator then appends at tail
+   * of list.
+   * @tparam T item's type
+   * @param pos iterator referring to node to be inserted in front of
+   * @param item to be copy-inserted
+   * @return iterator referring to the inserted item (advancing in same direction as pos); is
+   *         an end iterator when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <bool R, bool C>
+  auto dbl_lnk_lst<T, Alloc, Stats>::insert_before(basic_iterator<R, C> pos, const T& item) noexcept
+    -> basic_iterator<R, false> requires std::copy_constructible<T>
+  {
+    stats_rec.on_op(lst_op::insert_before);
+    return insert_node_at<R>(pos.node, item, true);
+  }
+
+  /**
+   * Inserts by moving item into container (thus taking ownership) in front of (i.e., on the head
+   * side of) the node referred to by pos - no scan of the list takes place. If pos is an end
+   * iterator then appends at tail of list.
+   * @tparam T item's type
+   * @param pos iterator referring to node to be inserted in front of
+   * @param item to be move-inserted
+   * @return iterator referring to the inserted item (advancing in same direction as pos); is
+   *         an end iterator when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <bool R, bool C>
+  auto dbl_lnk_lst<T, Alloc, Stats>::insert_before(basic_iterator<R, C> pos, T &&item) noexcept
+    -> basic_iterator<R, false>
+  {
+    stats_rec.on_op(lst_op::insert_before);
+    return insert_node_at<R>(pos.node, std::move(item), true);
+  }
+
+  /**
+   * Inserts copy of item into container right after (i.e., on the tail side of) the node referred
+   * to by pos - no scan of the list takes place. If pos is an end iterator then inserts at head
+   * of list.
+   * @tparam T item's type
+   * @param pos iterator referring to node to be inserted after
+   * @param item to be copy-inserted
+   * @return iterator referring to the inserted item (advancing in same direction as pos); is
+   *         an end iterator when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <bool R, bool C>
+  auto dbl_lnk_lst<T, Alloc, Stats>::insert_after(basic_iterator<R, C> pos, const T& item) noexcept
+    -> basic_iterator<R, false> requires std::copy_constructible<T>
+  {
+    stats_rec.on_op(lst_op::insert_after);
+    return insert_node_at<R>(pos.node, item, false);
+  }
+
+  /**
+   * Inserts by moving item into container (thus taking ownership) right after (i.e., on the tail
+   * side of) the node referred to by pos - no scan of the list takes place. If pos is an end
+   * iterator then inserts at head of list.
+   * @tparam T item's type
+   * @param pos iterator referring to node to be inserted after
+   * @param item to be move-inserted
+   * @return iterator referring to the inserted item (advancing in same direction as pos); is
+   *         an end iterator when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <bool R, bool C>
+  auto dbl_lnk_lst<T, Alloc, Stats>::insert_after(basic_iterator<R, C> pos, T &&item) noexcept
+    -> basic_iterator<R, false>
+  {
+    stats_rec.on_op(lst_op::insert_after);
+    return insert_node_at<R>(pos.node, std::move(item), false);
+  }
+
+  /**
+   * Removes the item referred to by pos from list - no scan of the list takes place.
+   * @tparam T item's type
+   * @param pos iterator referring to item to be removed
+   * @return iterator referring to the item that followed pos (in pos's direction of iteration)
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <bool R, bool C>
+  auto dbl_lnk_lst<T, Alloc, Stats>::erase(basic_iterator<R, C> pos) noexcept -> basic_iterator<R, false> {
+    stats_rec.on_op(lst_op::erase);
+    auto *const node = pos.node;
+    if (node == nullptr)
+      return basic_iterator<R, false>{nullptr, this};
+    const basic_iterator<R, false> next_it{R ? node->prev : node->next, this};
+    unlink(node);
+    free_node(node);
+    count--;
+    return next_it;
+  }
+
+  /**
+   * Removes the items [first, last) from list, iterating in first's direction.
+   * @tparam T item's type
+   * @return last
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <bool R, bool C>
+  auto dbl_lnk_lst<T, Alloc, Stats>::erase(basic_iterator<R, C> first, const basic_iterator<R, C> last) noexcept
+    -> basic_iterator<R, false>
+  {
+    while (first != last && first.node != nullptr)
+      first = erase(first);
+    return basic_iterator<R, false>{last.node, this};
+  }
+
+  /**
+   * Unlinks the item that pos refers to from list and hands its node out - nothing is freed
+   * (nor is the item moved) until the handle is dropped.
+   * @tparam T item's type
+   * @return node handle owning the item's node (empty if pos is end())
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <bool R, bool C>
+  auto dbl_lnk_lst<T, Alloc, Stats>::extract(basic_iterator<R, C> pos) noexcept -> node_type {
+    stats_rec.on_op(lst_op::extract);
+    auto *const node = pos.node;
+    if (node == nullptr)
+      return node_type{};
+    unlink(node);
+    count--;
+    return node_type{node, node_alloc};
+  }
+
+  /**
+   * Unlinks a value specified matched item (the first match starting from head of list) from
+   * list and hands its node out.
+   * @tparam T item's type
+   * @param value item to be extracted
+   * @return node handle owning the item's node (empty if there's no match)
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  auto dbl_lnk_lst<T, Alloc, Stats>::extract(const T&value) noexcept -> node_type {
+    return extract(iterator{find_first(value), this});
+  }
+
+  /**
+   * Takes the node out of nh for linking into this list - as is when nh's allocator is equal to
+   * the list's, otherwise (the node can't be freed by this list's allocator) the item is moved
+   * into a new node and nh's node is freed.
+   * @return the node to link in, or null if nh is empty or fails to allocate memory
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  auto dbl_lnk_lst<T, Alloc, Stats>::adopt_node(node_type &nh) noexcept -> lst_node<T>* {
+    if (nh.empty())
+      return nullptr;
+    if (*nh.alloc == node_alloc)
+      return nh.release();
+    auto *const node = new_node(std::move(nh.value()));
+    if (node != nullptr)
+      nh.reset();
+    return node;
+  }
+
+  /**
+   * Links the node owned by nh in at head of list - no allocation, no move of its item (given
+   * the node handle came from a list with an equal allocator).
+   * @tparam T item's type
+   * @param nh node handle (left empty on success)
+   * @return returns false when nh is empty (or fails to allocate memory, see adopt_node())
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::insert(node_type &&nh) noexcept {
+    stats_rec.on_op(lst_op::insert);
+    auto *const node = adopt_node(nh);
+    if (node != nullptr) {
+      insert_at_head(node);
+      count++;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Links the node owned by nh in at tail of list - no allocation, no move of its item (given
+   * the node handle came from a list with an equal allocator).
+   * @tparam T item's type
+   * @param nh node handle (left empty on success)
+   * @return returns false when nh is empty (or fails to allocate memory, see adopt_node())
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  bool dbl_lnk_lst<T, Alloc, Stats>::append(node_type &&nh) noexcept {
+    stats_rec.on_op(lst_op::append);
+    auto *const node = adopt_node(nh);
+    if (node != nullptr) {
+      append_at_tail(node);
+      count++;
+      return true;
+    }
     return false;
   }
 
   /**
-   * Removes all items in container, freeing their memory.
+   * Transfers all items of other into this list in front of pos (at tail of list if pos is
+   * end()) by relinking - O(1), nothing is allocated, copied or moved. The lists' allocators
+   * must compare equal.
    * @tparam T item's type
    */
-  template <typename T> requires lst_elm_type_constraints<T>
-  void dbl_lnk_lst<T>::clear() noexcept {
-    for (auto *node = tail; node != nullptr; node = bkwd(node)) {
-      if (node->next) {
-        node->next.reset(nullptr);
-        count--;
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  void dbl_lnk_lst<T, Alloc, Stats>::splice(const_iterator pos, dbl_lnk_lst &other) noexcept {
+    assert(node_alloc == other.node_alloc); // (we trust but verify)
+    if (&other == this || other.head == nullptr)
+      return;
+    link_chain_before(pos.node, other.head, other.tail);
+    count += other.count;
+    other.head = other.tail = nullptr;
+    other.count = 0;
+  }
+
+  /**
+   * Transfers the item referred to by it from other (which may be this list) into this list in
+   * front of pos (at tail of list if pos is end()) by relinking - O(1). The lists' allocators
+   * must compare equal.
+   * @tparam T item's type
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  void dbl_lnk_lst<T, Alloc, Stats>::splice(const_iterator pos, dbl_lnk_lst &other, const_iterator it) noexcept {
+    assert(node_alloc == other.node_alloc); // (we trust but verify)
+    auto *const node = it.node;
+    if (node == nullptr || node == pos.node)
+      return;
+    other.unlink(node);
+    other.count--;
+    link_chain_before(pos.node, node, node);
+    count++;
+  }
+
+  /**
+   * Transfers the items [first, last) - in head to tail order - from other into this list in
+   * front of pos (at tail of list if pos is end()) by relinking. The relinking is O(1); when
+   * other is a different list the transferred items are counted, which is O(distance(first, last)).
+   * The lists' allocators must compare equal, and pos must not be within [first, last).
+   * @tparam T item's type
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  void dbl_lnk_lst<T, Alloc, Stats>::splice(const_iterator pos, dbl_lnk_lst &other, const_iterator first,
+                                            const_iterator last) noexcept {
+    assert(node_alloc == other.node_alloc); // (we trust but verify)
+    if (first.node == nullptr || first == last)
+      return;
+    auto *const last_node = last.node != nullptr ? last.node->prev : other.tail;
+    if (&other != this) {
+      size_t n = 1;
+      for (auto *node = first.node; node != last_node; node = node->next)
+        n++;
+      other.count -= n;
+      count += n;
+    }
+    other.unlink_chain(first.node, last_node);
+    link_chain_before(pos.node, first.node, last_node);
+  }
+
+  /**
+   * Merges the two sorted chains a and b (linked by next only, null terminated) - on equal items
+   * the one from a comes first (so is stable when a's items precede b's).
+   * @return first node of the merged chain
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename Compare>
+  auto dbl_lnk_lst<T, Alloc, Stats>::merge_chains(lst_node<T> *a, lst_node<T> *b, Compare &comp) noexcept
+    -> lst_node<T>*
+  {
+    lst_node<T> *first = nullptr;
+    auto **link = &first; // the next pointer to be linked to
+    while (a != nullptr && b != nullptr) {
+      if (comp(b->value, a->value)) {
+        *link = b;
+        b = b->next;
+      } else {
+        *link = a;
+        a = a->next;
       }
+      link = &(*link)->next;
     }
-    tail = nullptr;
-    if (head) {
-      head.reset(nullptr);
-      count--;
+    *link = a != nullptr ? a : b;
+    return first;
+  }
+
+  /**
+   * Bottom-up merge sort of a chain linked by next only (null terminated): each node is merged
+   * into a ladder of bins, bin i holding a sorted run of 2^i nodes (or none), then the bins are
+   * merged together - O(n log n) comparisons, no memory is allocated.
+   * @return first node of the sorted chain
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename Compare>
+  auto dbl_lnk_lst<T, Alloc, Stats>::sort_chain(lst_node<T> *first, Compare &comp) noexcept -> lst_node<T>* {
+    lst_node<T> *bins[64]{};
+    size_t top = 0; // number of bins in use
+    while (first != nullptr) {
+      auto *carry = first;
+      first = first->next;
+      carry->next = nullptr;
+      size_t i = 0;
+      for (; i < top && bins[i] != nullptr; i++) {
+        carry = merge_chains(bins[i], carry, comp); // (bin items precede the carry's)
+        bins[i] = nullptr;
+      }
+      bins[i] = carry;
+      if (i == top)
+        top++;
+    }
+    lst_node<T> *sorted = nullptr;
+    for (size_t i = 0; i < top; i++) {
+      if (bins[i] != nullptr)
+        sorted = merge_chains(bins[i], sorted, comp); // (higher bins hold earlier items)
     }
+    return sorted;
+  }
+
+  /**
+   * Makes the chain linked by next, starting at first, the list's chain of nodes - setting
+   * the prev links, head and tail.
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  void dbl_lnk_lst<T, Alloc, Stats>::relink_chain(lst_node<T> *const first) noexcept {
+    head = tail = first;
+    if (first == nullptr)
+      return;
+    first->prev = nullptr;
+    for (; tail->next != nullptr; tail = tail->next)
+      tail->next->prev = tail;
+  }
+
+  /**
+   * Invokes f(i) for each i in [0, nbr) - all but f(0) on threads of their own; should a thread
+   * fail to start then its call is made on the calling thread instead.
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename F>
+  void dbl_lnk_lst<T, Alloc, Stats>::run_parallel(const size_t nbr, F &&f) noexcept {
+    std::vector<std::thread> threads{};
+    try {
+      threads.reserve(nbr);
+    } catch (...) {}
+    for (size_t i = 1; i < nbr; i++) {
+      try {
+        threads.emplace_back(f, i);
+      } catch (...) {
+        f(i);
+      }
+    }
+    f(0);
+    for (auto &thrd: threads)
+      thrd.join();
+  }
+
+  /**
+   * Sorts the items of the container by relinking the existing nodes (no item is copied or
+   * moved, no memory is allocated) - a stable bottom-up merge sort, O(n log n).
+   * @tparam T item's type
+   * @param comp strict weak ordering of two items (std::less<> when not specified)
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename Compare>
+  void dbl_lnk_lst<T, Alloc, Stats>::sort(Compare comp) noexcept {
+    if (count > 1)
+      relink_chain(sort_chain(head, comp));
+  }
+
+  /**
+   * Same as sort() but the list is cut into nbr_threads segments which are sorted concurrently,
+   * then merged back together (also concurrently, pairwise). Stays stable. Segments are kept
+   * to at least min_parallel_sort_segment items - so a short list is sorted on the calling
+   * thread alone.
+   * @tparam T item's type
+   * @param comp strict weak ordering of two items (std::less<> when not specified) - is
+   *             invoked from several threads at once
+   * @param nbr_threads number of threads to sort with (hardware concurrency when zero)
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename Compare>
+  void dbl_lnk_lst<T, Alloc, Stats>::parallel_sort(Compare comp, size_t nbr_threads) noexcept {
+    if (nbr_threads == 0)
+      nbr_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    nbr_threads = std::min(nbr_threads, count / min_parallel_sort_segment);
+    std::vector<lst_node<T>*> segments{};
+    try {
+      segments.resize(nbr_threads);
+    } catch (...) {
+      nbr_threads = 0;
+    }
+    if (nbr_threads < 2) {
+      sort(comp);
+      return;
+    }
+    // cut the list into segments, the last one taking the remainder
+    auto *node = head;
+    for (size_t i = 0; i < nbr_threads; i++) {
+      segments[i] = node;
+      if (i + 1 == nbr_threads)
+        break;
+      for (size_t n = 1; n < count / nbr_threads; n++)
+        node = node->next;
+      auto *const next_node = node->next;
+      node->next = nullptr;
+      node = next_node;
+    }
+    run_parallel(nbr_threads, [&segments, &comp](const size_t i) noexcept {
+      auto seg_comp = comp;
+      segments[i] = sort_chain(segments[i], seg_comp);
+    });
+    // merge neighbouring segments pairwise until one is left
+    for (size_t stride = 1; stride < nbr_threads; stride *= 2) {
+      run_parallel((nbr_threads + 2 * stride - 1) / (2 * stride), [&segments, &comp, stride, nbr_threads](const size_t i) noexcept {
+        const auto a = 2 * stride * i, b = a + stride;
+        if (b < nbr_threads) {
+          auto seg_comp = comp;
+          segments[a] = merge_chains(segments[a], segments[b], seg_comp);
+        }
+      });
+    }
+    relink_chain(segments[0]);
+  }
+
+  /**
+   * Merges the items of other into this list, both lists being sorted per comp, by relinking the
+   * nodes - O(n + m), nothing is allocated, copied or moved. On equal items the ones of this list
+   * come first. The lists' allocators must compare equal; other is left empty.
+   * @tparam T item's type
+   * @param comp strict weak ordering the lists are sorted by (std::less<> when not specified)
+   */
+  template <typename T, typename Alloc, typename Stats> requires lst_elm_type_constraints<T>
+  template <typename Compare>
+  void dbl_lnk_lst<T, Alloc, Stats>::merge(dbl_lnk_lst &other, Compare comp) noexcept {
+    assert(node_alloc == other.node_alloc); // (we trust but verify)
+    if (&other == this || other.head == nullptr)
+      return;
+    relink_chain(merge_chains(head, other.head, comp));
+    count += other.count;
+    other.head = other.tail = nullptr;
+    other.count = 0;
+  }
+
+  /**
+   * Same as dbl_lnk_lst but nodes are obtained from a std::pmr::memory_resource, e.g.:
+   *
+   *     std::pmr::unsynchronized_pool_resource rsrc{};
+   *     cust_coll::pmr::dbl_lnk_lst<int> lst{&rsrc};
+   */
+  namespace pmr {
+    template <typename T, typename Stats = no_lst_stats> requires lst_elm_type_constraints<T>
+    using dbl_lnk_lst = cust_coll::dbl_lnk_lst<T, std::pmr::polymorphic_allocator<T>, Stats>;
   }
 
 } // cust_coll
 
-#endif //DBL_LNK_LST_HPP
\ No newline at end of file
+#endif //DBL_LNK_LST_HPP
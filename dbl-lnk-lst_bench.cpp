@@ -0,0 +1,649 @@
+//
+// Created by rogerv on 5/20/24.
+//
+// Benchmarks of dbl_lnk_lst against the std containers; results can be exported as JSON for
+// tracking over time, e.g.:
+//
+//   dbl-lnk-lst_bench --benchmark_out=bench.json --benchmark_out_format=json
+//   dbl-lnk-lst_bench --benchmark_filter='BM_tail_append<.*int>'
+//
+#include <list>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include "some_elm.hpp"
+#include "dbl-lnk-lst.hpp"
+#include "compact-dbl-lnk-lst.hpp"
+#include "unrolled-lnk-lst.hpp"
+#include "lst-snapshot.hpp"
+#include "ranked-dbl-lnk-lst.hpp"
+#include "lst-parallel.hpp"
+#include "small-dbl-lnk-lst.hpp"
+using cust_coll::dbl_lnk_lst;
+using cust_coll::compact_dbl_lnk_lst;
+using cust_coll::unrolled_lnk_lst;
+using cust_coll::fingerprinted_lnk_lst;
+using cust_coll::ranked_dbl_lnk_lst;
+using cust_coll::small_dbl_lnk_lst;
+
+template <typename T>
+using pooled_dbl_lnk_lst = dbl_lnk_lst<T, cust_coll::pool_allocator<T>>;
+
+static int64_t nbr_heap_allocs = 0;
+
+/**
+ * A std::allocator that counts the allocations made through it (into nbr_heap_allocs).
+ */
+template <typename T>
+struct counting_allocator : std::allocator<T> {
+  using value_type = T;
+  template <typename U> struct rebind { using other = counting_allocator<U>; };
+  counting_allocator() noexcept = default;
+  template <typename U> counting_allocator(const counting_allocator<U>&) noexcept {}
+  T* allocate(size_t n) { nbr_heap_allocs++; return std::allocator<T>::allocate(n); }
+  friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept { return true; }
+};
+
+/**
+ * A 64 byte trivially copyable element type.
+ */
+struct pod64 {
+  int64_t v[8]{};
+  bool operator==(const pod64 &oth) const { return v[0] == oth.v[0]; }
+};
+static_assert(sizeof(pod64) == 64);
+
+struct pod64_hash {
+  size_t operator()(const pod64 &v) const noexcept { return std::hash<int64_t>{}(v.v[0]); }
+};
+
+struct some_elm_hash {
+  size_t operator()(const some_elm &elm) const noexcept { return std::hash<std::string>{}(elm.s); }
+};
+
+static constexpr int64_t MIN_SIZE = 10;
+static constexpr int64_t MAX_SIZE = 10'000'000;
+static constexpr int64_t MAX_SOME_ELM_SIZE = 1'000'000;    // (10^7 random strings per container is too much RAM)
+static constexpr int64_t MAX_QUADRATIC_SIZE = 100'000;     // (std::vector head insert is O(n^2))
+
+template <typename T> T make_val(int64_t i);
+template <> int make_val<int>(int64_t i) { return static_cast<int>(i); }
+template <> pod64 make_val<pod64>(int64_t i) { return pod64{{i, i, i, i, i, i, i, i}}; }
+template <> some_elm make_val<some_elm>(int64_t) { return some_elm{}; }
+
+/**
+ * @return n distinct values of type T (generated once and cached across benchmarks)
+ */
+template <typename T>
+static const T* values(const int64_t n) {
+  static std::vector<T> vals{};
+  while (static_cast<int64_t>(vals.size()) < n)
+    vals.push_back(make_val<T>(static_cast<int64_t>(vals.size())));
+  return vals.data();
+}
+
+/**
+ * @return a value that is not one of those returned by values()
+ */
+template <typename T>
+static T absent_val() { return make_val<T>(-1); }
+
+template <typename T> int64_t max_size() { return MAX_SIZE; }
+template <> int64_t max_size<some_elm>() { return MAX_SOME_ELM_SIZE; }
+
+static inline void accum(int64_t &sum, const int v) { sum += v; }
+static inline void accum(int64_t &sum, const pod64 &v) { sum += v.v[0]; }
+static inline void accum(int64_t &sum, const some_elm &v) { sum += static_cast<int64_t>(v.s.size()); }
+
+// uniform operations over dbl_lnk_lst and the std containers
+
+template <typename C, typename T>
+static void push_front(C &c, const T &v) {
+  if constexpr (requires { c.insert_at(v, v); })
+    c.insert(v);
+  else if constexpr (requires { c.push_front(v); })
+    c.push_front(v);
+  else
+    c.insert(c.begin(), v);
+}
+
+template <typename C, typename T>
+static void push_back(C &c, const T &v) {
+  if constexpr (requires { c.append(v); })
+    c.append(v);
+  else
+    c.push_back(v);
+}
+
+template <typename C, typename T>
+static void append_range(C &c, const T *const first, const T *const last) {
+  if constexpr (requires { c.append_range(first, last); })
+    c.append_range(first, last);
+  else
+    c.insert(c.end(), first, last);
+}
+
+template <typename C, typename T>
+static void insert_at(C &c, const T &v, const T &pos) {
+  if constexpr (requires { c.insert_at(v, pos); })
+    c.insert_at(v, pos);
+  else
+    c.insert(std::find(c.begin(), c.end(), pos), v);
+}
+
+template <typename C, typename T>
+static void append_at(C &c, const T &v, const T &pos) {
+  if constexpr (requires { c.append_at(v, pos); }) {
+    c.append_at(v, pos);
+  } else {
+    auto it = std::find(c.rbegin(), c.rend(), pos);
+    c.insert(it != c.rend() ? it.base() : c.end(), v);
+  }
+}
+
+template <typename C, typename T>
+static void delete_at(C &c, const T &pos) {
+  if constexpr (requires { c.delete_at(pos); }) {
+    c.delete_at(pos);
+  } else if (auto it = std::find(c.begin(), c.end(), pos); it != c.end()) {
+    c.erase(it);
+  }
+}
+
+template <typename C, typename T>
+static std::unique_ptr<C> filled(const int64_t n) {
+  auto c = std::make_unique<C>();
+  const T *const vals = values<T>(n);
+  for (int64_t i = 0; i < n; i++)
+    push_back(*c, vals[i]);
+  return c;
+}
+
+// benchmarks
+
+template <typename C, typename T>
+static void BM_head_insert(benchmark::State &state) {
+  const auto n = state.range(0);
+  const T *const vals = values<T>(n);
+  for (auto _ : state) {
+    auto c = std::make_unique<C>();
+    for (int64_t i = 0; i < n; i++)
+      push_front(*c, vals[i]);
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename C, typename T>
+static void BM_tail_append(benchmark::State &state) {
+  const auto n = state.range(0);
+  const T *const vals = values<T>(n);
+  for (auto _ : state) {
+    auto c = std::make_unique<C>();
+    for (int64_t i = 0; i < n; i++)
+      push_back(*c, vals[i]);
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * Same load as BM_tail_append but as one batch (append_range() / range insert).
+ */
+template <typename C, typename T>
+static void BM_bulk_append(benchmark::State &state) {
+  const auto n = state.range(0);
+  const T *const vals = values<T>(n);
+  for (auto _ : state) {
+    auto c = std::make_unique<C>();
+    append_range(*c, vals, vals + n);
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * range(0) is the list size, range(1) is the depth (percent from head) of the pos item.
+ */
+template <typename C, typename T>
+static void BM_insert_at(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto c = filled<C, T>(n);
+  const T &pos = values<T>(n)[n * state.range(1) / 100];
+  const T item = absent_val<T>();
+  for (auto _ : state) {
+    insert_at(*c, item, pos);
+    state.PauseTiming();
+    delete_at(*c, item);
+    state.ResumeTiming();
+  }
+}
+
+template <typename C, typename T>
+static void BM_append_at(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto c = filled<C, T>(n);
+  const T &pos = values<T>(n)[n * state.range(1) / 100];
+  const T item = absent_val<T>();
+  for (auto _ : state) {
+    append_at(*c, item, pos);
+    state.PauseTiming();
+    delete_at(*c, item);
+    state.ResumeTiming();
+  }
+}
+
+template <typename C, typename T>
+static void BM_delete_at(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto c = filled<C, T>(n);
+  const T *const vals = values<T>(n);
+  const auto idx = n * state.range(1) / 100;
+  for (auto _ : state) {
+    delete_at(*c, vals[idx]);
+    state.PauseTiming();
+    if (idx + 1 < n)
+      insert_at(*c, vals[idx], vals[idx + 1]);
+    else
+      push_back(*c, vals[idx]);
+    state.ResumeTiming();
+  }
+}
+
+template <typename C, typename T>
+static void BM_forward_iterate(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto c = filled<C, T>(n);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    std::for_each(c->begin(), c->end(), [&sum](const T &v) { accum(sum, v); });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename C, typename T>
+static void BM_reverse_iterate(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto c = filled<C, T>(n);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    std::for_each(c->rbegin(), c->rend(), [&sum](const T &v) { accum(sum, v); });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * Forward iteration the way the former dbl_lnk_lst iterator advanced - through a function pointer
+ * (opaque to the optimizer) on each ++ - as a baseline for BM_forward_iterate.
+ */
+template <typename C, typename T>
+static void BM_fn_ptr_iterate(benchmark::State &state) {
+  using iter_t = typename C::iterator;
+  const auto n = state.range(0);
+  const auto c = filled<C, T>(n);
+  iter_t& (*advance)(iter_t&) noexcept = [](iter_t &it) noexcept -> iter_t& { return ++it; };
+  benchmark::DoNotOptimize(advance);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = c->begin(); it != c->end(); advance(it))
+      accum(sum, *it);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename C, typename T>
+static void BM_clear(benchmark::State &state) {
+  const auto n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto c = filled<C, T>(n);
+    state.ResumeTiming();
+    c->clear();
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename C, typename T>
+static void BM_destroy(benchmark::State &state) {
+  const auto n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto c = filled<C, T>(n);
+    state.ResumeTiming();
+    c.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * Sorts a list of n shuffled ints (the refill in between is not timed).
+ */
+template <typename C, bool Parallel = false>
+static void BM_sort(benchmark::State &state) {
+  const auto n = state.range(0);
+  std::vector<int> shuffled(values<int>(n), values<int>(n) + n);
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{42});
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto c = std::make_unique<C>();
+    append_range(*c, shuffled.data(), shuffled.data() + n);
+    state.ResumeTiming();
+    if constexpr (Parallel)
+      c->parallel_sort();
+    else
+      c->sort();
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * Forward iteration over a list of n ints that was sorted from shuffled order - sort() relinks the
+ * nodes, so list order no longer follows memory order. With Compact the nodes are first renumbered
+ * into list order by compact_dbl_lnk_lst::compact().
+ */
+template <typename C, bool Compact = false>
+static void BM_sorted_iterate(benchmark::State &state) {
+  const auto n = state.range(0);
+  std::vector<int> shuffled(values<int>(n), values<int>(n) + n);
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{42});
+  C c{};
+  append_range(c, shuffled.data(), shuffled.data() + n);
+  c.sort();
+  if constexpr (Compact)
+    c.compact();
+  for (auto _ : state) {
+    int64_t sum = 0;
+    std::for_each(c.begin(), c.end(), [&sum](const int v) { accum(sum, v); });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * Restores a list of n ints from a snapshot file (as at service startup) - by streaming it in
+ * chunks, or with Mmap by mapping the file. Compare with BM_tail_append (rebuilding item by item).
+ */
+template <typename C, bool Mmap = false>
+static void BM_snapshot_load(benchmark::State &state) {
+  const auto n = state.range(0);
+  FILE *const file = std::tmpfile();
+  {
+    C c{};
+    append_range(c, values<int>(n), values<int>(n) + n);
+    cust_coll::save_snapshot(c, fileno(file));
+  }
+  for (auto _ : state) {
+    ::lseek(fileno(file), 0, SEEK_SET);
+    auto c = std::make_unique<C>();
+    if constexpr (Mmap)
+      benchmark::DoNotOptimize(cust_coll::load_snapshot_mmap(*c, fileno(file)));
+    else
+      benchmark::DoNotOptimize(cust_coll::load_snapshot(*c, fileno(file)));
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  std::fclose(file);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * Deletes n/10 values (spread evenly through a list of n ints) - with Bulk by a single
+ * delete_many() pass, else by a delete_at() per value (each rescanning from head).
+ */
+template <typename C, bool Bulk = false>
+static void BM_delete_many(benchmark::State &state) {
+  const auto n = state.range(0);
+  std::vector<int> doomed{};
+  for (int64_t i = 0; i < n; i += 10)
+    doomed.push_back(values<int>(n)[i]);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto c = std::make_unique<C>();
+    append_range(*c, values<int>(n), values<int>(n) + n);
+    state.ResumeTiming();
+    if constexpr (Bulk) {
+      benchmark::DoNotOptimize(c->delete_many(doomed));
+    } else {
+      for (const int v : doomed)
+        benchmark::DoNotOptimize(c->delete_at(v));
+    }
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(doomed.size()));
+}
+
+/**
+ * Moves the head item of one list of n items to the tail of another, back and forth - with
+ * Extract by extract() + append() of the node handle, else by a copy append() + erase().
+ */
+template <typename C, typename T, bool Extract = false>
+static void BM_transfer(benchmark::State &state) {
+  const auto n = state.range(0);
+  auto src = filled<C, T>(n);
+  auto dst = std::make_unique<C>(src->get_allocator());  // (shares a pool allocator's pool)
+  for (auto _ : state) {
+    if (src->is_empty())
+      std::swap(src, dst);
+    if constexpr (Extract) {
+      dst->append(src->extract(src->begin()));
+    } else {
+      dst->append(*src->begin());
+      src->erase(src->begin());
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Reads the item at a random index of a list of n ints - via at() where the container has it,
+ * else by walking an iterator there from begin().
+ */
+template <typename C>
+static void BM_index_access(benchmark::State &state) {
+  const auto n = state.range(0);
+  auto c = filled<C, int>(n);
+  std::mt19937_64 gen{42};
+  std::uniform_int_distribution<int64_t> dist{0, n - 1};
+  int64_t sum = 0;
+  for (auto _ : state) {
+    const auto i = static_cast<size_t>(dist(gen));
+    if constexpr (requires { c->at(i); })
+      accum(sum, c->at(i));
+    else
+      accum(sum, *std::next(c->begin(), static_cast<std::ptrdiff_t>(i)));
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Sums a CPU heavy function (range(1) rounds of mixing) of every item of a list of n ints - with
+ * Parallel by parallel_transform_reduce() on the default pool, else serially.
+ */
+template <typename C, bool Parallel = false>
+static void BM_transform_reduce(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto rounds = state.range(1);
+  auto c = filled<C, int>(n);
+  const auto heavy = [rounds](const int v) {
+    auto h = static_cast<uint64_t>(v);
+    for (int64_t r = 0; r < rounds; r++)
+      h = (h ^ (h >> 31)) * 0x9E3779B97F4A7C15ull;
+    return h;
+  };
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    if constexpr (Parallel) {
+      sum = cust_coll::parallel_transform_reduce(*c, uint64_t{0}, std::plus<>{}, heavy);
+    } else {
+      for (const int v : *c)
+        sum += heavy(v);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * Builds, walks and destroys 10'000 short lists of ints - of 1 to range(0) items each - as for a
+ * list per graph vertex or per hash bucket. Reports the heap allocations made per list.
+ */
+template <typename C>
+static void BM_many_small_lists(benchmark::State &state) {
+  constexpr int64_t nbr_lsts = 10'000;
+  const auto max_items = state.range(0);
+  std::mt19937_64 gen{42};
+  std::uniform_int_distribution<int64_t> dist{1, max_items};
+  std::vector<int64_t> lens(nbr_lsts);
+  for (auto &len : lens)
+    len = dist(gen);
+  int64_t sum = 0;
+  nbr_heap_allocs = 0;
+  for (auto _ : state) {
+    std::deque<C> lsts(nbr_lsts);
+    for (int64_t i = 0; i < nbr_lsts; i++) {
+      for (int64_t j = 0; j < lens[i]; j++)
+        push_back(lsts[i], static_cast<int>(j));
+    }
+    for (const auto &c : lsts) {
+      for (const int v : c)
+        accum(sum, v);
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * nbr_lsts);
+  state.counters["allocs_per_lst"] = benchmark::Counter(static_cast<double>(nbr_heap_allocs) /
+                                                        static_cast<double>(state.iterations() * nbr_lsts));
+}
+
+// registration
+
+template <typename T>
+static void sizes(benchmark::internal::Benchmark *b) {
+  for (int64_t n = MIN_SIZE; n <= max_size<T>(); n *= 10)
+    b->Arg(n);
+}
+
+template <typename T>
+static void quadratic_sizes(benchmark::internal::Benchmark *b) {
+  for (int64_t n = MIN_SIZE; n <= std::min(max_size<T>(), MAX_QUADRATIC_SIZE); n *= 10)
+    b->Arg(n);
+}
+
+template <typename T>
+static void depth_sizes(benchmark::internal::Benchmark *b) {
+  for (int64_t n = MIN_SIZE; n <= max_size<T>(); n *= 10) {
+    for (const int64_t depth : {10, 50, 90})
+      b->Args({n, depth});
+  }
+}
+
+#define BENCH_LISTS(func, T, size_fn)                                          \
+  BENCHMARK_TEMPLATE(func, dbl_lnk_lst<T>, T)->Apply(size_fn<T>);              \
+  BENCHMARK_TEMPLATE(func, pooled_dbl_lnk_lst<T>, T)->Apply(size_fn<T>);       \
+  BENCHMARK_TEMPLATE(func, compact_dbl_lnk_lst<T>, T)->Apply(size_fn<T>);      \
+  BENCHMARK_TEMPLATE(func, std::list<T>, T)->Apply(size_fn<T>);                \
+  BENCHMARK_TEMPLATE(func, std::deque<T>, T)->Apply(size_fn<T>)
+
+#define BENCH_ALL(func, T, size_fn, vector_size_fn)                            \
+  BENCH_LISTS(func, T, size_fn);                                               \
+  BENCHMARK_TEMPLATE(func, std::vector<T>, T)->Apply(vector_size_fn<T>)
+
+#define BENCH_ELM_TYPE(T)                                                      \
+  BENCH_ALL(BM_head_insert, T, sizes, quadratic_sizes);                        \
+  BENCH_ALL(BM_tail_append, T, sizes, sizes);                                  \
+  BENCH_ALL(BM_bulk_append, T, sizes, sizes);                                  \
+  BENCH_ALL(BM_insert_at, T, depth_sizes, depth_sizes);                        \
+  BENCH_ALL(BM_append_at, T, depth_sizes, depth_sizes);                        \
+  BENCH_ALL(BM_delete_at, T, depth_sizes, depth_sizes);                        \
+  BENCH_ALL(BM_forward_iterate, T, sizes, sizes);                              \
+  BENCH_ALL(BM_reverse_iterate, T, sizes, sizes);                              \
+  BENCH_ALL(BM_clear, T, sizes, sizes);                                        \
+  BENCH_ALL(BM_destroy, T, sizes, sizes)
+
+BENCHMARK_TEMPLATE(BM_sort, dbl_lnk_lst<int>)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_sort, pooled_dbl_lnk_lst<int>)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_sort, dbl_lnk_lst<int>, true)->Apply(sizes<int>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_sort, compact_dbl_lnk_lst<int>)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_sort, std::list<int>)->Apply(sizes<int>);
+
+BENCHMARK_TEMPLATE(BM_sorted_iterate, dbl_lnk_lst<int>)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_sorted_iterate, pooled_dbl_lnk_lst<int>)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_sorted_iterate, compact_dbl_lnk_lst<int>)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_sorted_iterate, compact_dbl_lnk_lst<int>, true)->Apply(sizes<int>);
+
+BENCHMARK_TEMPLATE(BM_snapshot_load, dbl_lnk_lst<int>)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_snapshot_load, dbl_lnk_lst<int>, true)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_snapshot_load, pooled_dbl_lnk_lst<int>)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_snapshot_load, pooled_dbl_lnk_lst<int>, true)->Apply(sizes<int>);
+
+BENCHMARK_TEMPLATE(BM_delete_many, dbl_lnk_lst<int>)->RangeMultiplier(10)->Range(100, 100'000);
+BENCHMARK_TEMPLATE(BM_delete_many, dbl_lnk_lst<int>, true)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_delete_many, pooled_dbl_lnk_lst<int>, true)->Apply(sizes<int>);
+
+BENCHMARK_TEMPLATE(BM_transfer, dbl_lnk_lst<some_elm>, some_elm)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_transfer, dbl_lnk_lst<some_elm>, some_elm, true)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_transfer, pooled_dbl_lnk_lst<int>, int)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_transfer, pooled_dbl_lnk_lst<int>, int, true)->Arg(1000);
+
+BENCHMARK_TEMPLATE(BM_index_access, dbl_lnk_lst<int>)->RangeMultiplier(10)->Range(MIN_SIZE, 100'000);
+BENCHMARK_TEMPLATE(BM_index_access, ranked_dbl_lnk_lst<int>)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_index_access, std::vector<int>)->Apply(sizes<int>);
+
+BENCHMARK_TEMPLATE(BM_transform_reduce, dbl_lnk_lst<int>)->ArgsProduct({{10'000, 1'000'000}, {1, 100}});
+BENCHMARK_TEMPLATE(BM_transform_reduce, dbl_lnk_lst<int>, true)->ArgsProduct({{10'000, 1'000'000}, {1, 100}})->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_many_small_lists, dbl_lnk_lst<int, counting_allocator<int>>)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(BM_many_small_lists, small_dbl_lnk_lst<int, 8, counting_allocator<int>>)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(BM_many_small_lists, std::list<int, counting_allocator<int>>)->Arg(4)->Arg(8)->Arg(16);
+
+// positional search: plain element compares vs per node fingerprints
+#define BENCH_SEARCH(func, T, Hash)                                            \
+  BENCHMARK_TEMPLATE(func, unrolled_lnk_lst<T>, T)->Apply(depth_sizes<T>);     \
+  BENCHMARK_TEMPLATE(func, fingerprinted_lnk_lst<T, Hash>, T)->Apply(depth_sizes<T>)
+
+BENCH_SEARCH(BM_delete_at, int, std::hash<int>);
+BENCH_SEARCH(BM_delete_at, pod64, pod64_hash);
+BENCH_SEARCH(BM_delete_at, some_elm, some_elm_hash);
+BENCH_SEARCH(BM_append_at, some_elm, some_elm_hash);
+
+BENCHMARK_TEMPLATE(BM_fn_ptr_iterate, dbl_lnk_lst<int>, int)->Apply(sizes<int>);
+BENCHMARK_TEMPLATE(BM_fn_ptr_iterate, pooled_dbl_lnk_lst<int>, int)->Apply(sizes<int>);
+
+BENCH_ELM_TYPE(int);
+BENCH_ELM_TYPE(pod64);
+BENCH_ELM_TYPE(some_elm);
+
+int main(int argc, char **argv) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
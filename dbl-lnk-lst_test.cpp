@@ -1,7 +1,11 @@
 //
 // Created by rogerv on 4/29/24.
 //
+#include <limits>
 #include <vector>
+#include <string>
+#include <ranges>
+#include <iterator>
 #include <algorithm>
 #include <gtest/gtest.h>
 #include "some_elm.hpp"
@@ -281,4 +285,609 @@ TEST(DblLnkListAssertions, ClearDblLnkListContainer) {
   EXPECT_EQ(lst.size(), 0);
   EXPECT_TRUE(lst.is_empty());
   EXPECT_EQ(some_elm::count, 0);
-}
\ No newline at end of file
+}
+TEST(DblLnkListAssertions, PoolAllocatedNodes) {
+  std::vector<some_elm> strs{ITEM_NBR};
+  EXPECT_EQ(strs.size(), ITEM_NBR);
+  some_elm::count = 0;
+  dbl_lnk_lst<some_elm, cust_coll::pool_allocator<some_elm, 64>> lst{};  // <<=== dbl-lnk-list
+  for (const auto &elm: strs) {
+    auto r = lst.append(elm);
+    EXPECT_TRUE(r);
+    some_elm::count += 1;
+  }
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  EXPECT_EQ(lst.get_allocator().in_use(), ITEM_NBR);
+  auto r = lst.delete_at(strs[3]);
+  EXPECT_TRUE(r);
+  EXPECT_EQ(lst.get_allocator().in_use(), ITEM_NBR - 1);
+  r = lst.insert_at(strs[3], strs[4]);  // recycles the freed node slot
+  EXPECT_TRUE(r);
+  some_elm::count += 1;
+  EXPECT_EQ(lst.get_allocator().in_use(), ITEM_NBR);
+  auto strs_it = strs.begin();
+  auto lst_it = lst.begin();
+  while (strs_it != strs.end() and lst_it != lst.end()) {
+    auto ve = strs_it++;
+    auto le = lst_it++;
+    EXPECT_EQ(ve->s, le->s);
+  }
+  lst.clear();  // gives back the pool slabs in one go
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(lst.get_allocator().in_use(), 0);
+  EXPECT_EQ(some_elm::count, 0);
+  r = lst.append(strs[0]);
+  EXPECT_TRUE(r);
+  EXPECT_EQ(lst.size(), 1);
+}
+
+TEST(DblLnkListAssertions, PmrAllocatedNodes) {
+  std::pmr::unsynchronized_pool_resource rsrc{};
+  cust_coll::pmr::dbl_lnk_lst<int> lst{&rsrc};  // <<=== dbl-lnk-list
+  for (int i = 0; i < ITEM_NBR; i++) {
+    auto r = lst.append(i);
+    EXPECT_TRUE(r);
+  }
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  EXPECT_EQ(lst.get_allocator().resource(), &rsrc);
+  auto r = lst.delete_at(ITEM_NBR - 1);
+  EXPECT_TRUE(r);
+  r = lst.append_at(-1, 0);
+  EXPECT_TRUE(r);
+  int i = ITEM_NBR - 2;
+  for (auto it = lst.rbegin(); i > 0; ++it) {
+    EXPECT_EQ(*it, i--);
+  }
+  EXPECT_EQ(*lst.begin(), 0);
+  EXPECT_EQ(*(++lst.begin()), -1);
+  lst.clear();
+  EXPECT_TRUE(lst.is_empty());
+}
+
+TEST(DblLnkListAssertions, InsertEraseAtIterator) {
+  dbl_lnk_lst<int> lst{};  // <<=== dbl-lnk-list
+  for (int i = 0; i < ITEM_NBR; i++) {
+    auto r = lst.append(i);
+    EXPECT_TRUE(r);
+  }
+  // read-modify-write pass: after each even item insert its negation, erase each odd item
+  for (auto it = lst.begin(); it != lst.end();) {
+    if (*it % 2 == 0) {
+      auto ins_it = lst.insert_after(it, -*it);
+      EXPECT_EQ(*ins_it, -*it);
+      it = ++ins_it;
+    } else {
+      it = lst.erase(it);
+    }
+  }
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  int i = 0;
+  for (auto it = lst.begin(); it != lst.end(); i += 2) {
+    EXPECT_EQ(*it++, i);
+    EXPECT_EQ(*it++, -i);
+  }
+  auto it = lst.insert_before(lst.begin(), -1);
+  EXPECT_EQ(*lst.begin(), -1);
+  EXPECT_EQ(*++it, 0);
+  it = lst.insert_before(lst.end(), ITEM_NBR);
+  EXPECT_EQ(*lst.rbegin(), ITEM_NBR);
+  // reverse iterator erase returns iterator advancing backwards
+  auto rit = lst.erase(lst.rbegin());
+  EXPECT_EQ(*rit, -(ITEM_NBR - 2));
+  rit = lst.erase(rit, lst.rend());
+  EXPECT_TRUE(rit == lst.rend());
+  EXPECT_TRUE(lst.is_empty());
+}
+
+TEST(DblLnkListAssertions, SpliceNodesAndRanges) {
+  dbl_lnk_lst<int> lst{};    // <<=== dbl-lnk-list
+  dbl_lnk_lst<int> other{};  // <<=== dbl-lnk-list
+  for (int i = 0; i < 10; i++) {
+    lst.append(i);
+    other.append(i + 10);
+  }
+  // single node: move 15 in front of 3
+  auto pos = lst.begin();
+  for (int i = 0; i < 3; i++)
+    ++pos;
+  auto src = other.begin();
+  for (int i = 0; i < 5; i++)
+    ++src;
+  lst.splice(pos, other, src);
+  EXPECT_EQ(lst.size(), 11);
+  EXPECT_EQ(other.size(), 9);
+  std::vector<int> expect{0, 1, 2, 15, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_TRUE(std::equal(lst.begin(), lst.end(), expect.begin()));
+  // range: move [11, 14) to the end
+  auto first = other.begin();
+  ++first;
+  auto last = first;
+  for (int i = 0; i < 3; i++)
+    ++last;
+  lst.splice(lst.end(), other, first, last);
+  EXPECT_EQ(lst.size(), 14);
+  EXPECT_EQ(other.size(), 6);
+  expect.insert(expect.end(), {11, 12, 13});
+  EXPECT_TRUE(std::equal(lst.begin(), lst.end(), expect.begin()));
+  EXPECT_TRUE(std::equal(lst.rbegin(), lst.rend(), expect.rbegin()));
+  // within the same list: move head item to tail
+  lst.splice(lst.end(), lst, lst.begin());
+  expect.push_back(expect.front());
+  expect.erase(expect.begin());
+  EXPECT_TRUE(std::equal(lst.begin(), lst.end(), expect.begin()));
+  // whole list: in front of head
+  lst.splice(lst.begin(), other);
+  EXPECT_TRUE(other.is_empty());
+  EXPECT_TRUE(other.begin() == other.end());
+  EXPECT_EQ(lst.size(), 20);
+  expect.insert(expect.begin(), {10, 14, 16, 17, 18, 19});
+  EXPECT_TRUE(std::equal(lst.begin(), lst.end(), expect.begin()));
+  EXPECT_TRUE(std::equal(lst.rbegin(), lst.rend(), expect.rbegin()));
+}
+
+TEST(DblLnkListAssertions, RangeConstructAndBatchInsert) {
+  std::vector<some_elm> strs{ITEM_NBR};
+  dbl_lnk_lst<some_elm> lst{strs};  // <<=== dbl-lnk-list
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  EXPECT_TRUE(std::equal(lst.begin(), lst.end(), strs.begin()));
+  EXPECT_TRUE(std::equal(lst.rbegin(), lst.rend(), strs.rbegin()));
+  // rvalue container - its items get moved into the list
+  auto moved_strs = strs;
+  dbl_lnk_lst<some_elm> moved_lst{std::move(moved_strs)};  // <<=== dbl-lnk-list
+  EXPECT_EQ(moved_lst.size(), ITEM_NBR);
+  EXPECT_TRUE(std::equal(moved_lst.begin(), moved_lst.end(), strs.begin()));
+  EXPECT_TRUE(std::all_of(moved_strs.begin(), moved_strs.end(), [](const some_elm &elm) { return elm.s.empty(); }));
+
+  const std::vector<int> ints{3, 4, 5};
+  dbl_lnk_lst<int> int_lst{ints.begin(), ints.end()};  // <<=== dbl-lnk-list
+  EXPECT_TRUE(int_lst.insert_range(std::vector<int>{0, 1, 2}));
+  EXPECT_TRUE(int_lst.append_range(std::views::iota(9, 12)));
+  EXPECT_TRUE(int_lst.insert_range_at(std::views::iota(6, 9), 9));
+  EXPECT_TRUE(int_lst.insert_range_at(ints.begin(), ints.begin() + 1, -1)); // no match so is appended
+  EXPECT_TRUE(int_lst.append_range(ints.end(), ints.end()));
+  EXPECT_EQ(int_lst.size(), 13);
+  std::vector<int> expect{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 3};
+  EXPECT_TRUE(std::equal(int_lst.begin(), int_lst.end(), expect.begin()));
+  EXPECT_TRUE(std::equal(int_lst.rbegin(), int_lst.rend(), expect.rbegin()));
+
+  dbl_lnk_lst<std::string> str_lst{std::vector<const char*>{"a", "b"}};  // <<=== dbl-lnk-list
+  EXPECT_EQ(*str_lst.begin(), "a");
+  EXPECT_EQ(*str_lst.rbegin(), "b");
+}
+
+TEST(DblLnkListAssertions, BatchInsertIntoPool) {
+  cust_coll::pool_allocator<int, 16> alloc{};
+  dbl_lnk_lst<int, cust_coll::pool_allocator<int, 16>> lst{std::views::iota(0, ITEM_NBR), alloc};  // <<=== dbl-lnk-list
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  EXPECT_EQ(lst.get_allocator().in_use(), ITEM_NBR);
+  EXPECT_TRUE(lst.delete_at(5));
+  EXPECT_TRUE(lst.append_range(std::views::iota(ITEM_NBR, ITEM_NBR * 2)));
+  EXPECT_EQ(lst.size(), ITEM_NBR * 2 - 1);
+  EXPECT_EQ(lst.get_allocator().in_use(), ITEM_NBR * 2 - 1);
+  int i = 0;
+  for (auto it = lst.begin(); it != lst.end(); ++it, ++i) {
+    if (i == 5)
+      ++i;
+    EXPECT_EQ(*it, i);
+  }
+  EXPECT_EQ(i, ITEM_NBR * 2);
+  lst.clear();
+  EXPECT_EQ(lst.get_allocator().in_use(), 0);
+}
+
+TEST(DblLnkListAssertions, PoolSlotsSizedPerAllocatedType) {
+  cust_coll::pool_allocator<int, 16> alloc{};
+  int *const p = alloc.allocate(1);  // (an int allocated from the pool ahead of any list node)
+  dbl_lnk_lst<int, cust_coll::pool_allocator<int, 16>> lst{std::views::iota(0, ITEM_NBR), alloc};  // <<=== dbl-lnk-list
+  EXPECT_EQ(lst.get_allocator(), alloc);
+  EXPECT_EQ(alloc.in_use(), ITEM_NBR + 1);  // (the nodes are pooled as well, not left to the heap)
+  alloc.deallocate(p, 1);
+  EXPECT_EQ(alloc.in_use(), ITEM_NBR);
+  EXPECT_TRUE(lst.delete_at(7));
+  EXPECT_TRUE(lst.insert(7));
+  EXPECT_EQ(alloc.in_use(), ITEM_NBR);
+  lst.clear();
+  EXPECT_EQ(alloc.in_use(), 0);
+  // room for so many slots that a slab's byte size would overflow is refused
+  EXPECT_THROW(alloc.reserve(std::numeric_limits<size_t>::max() / sizeof(int) + 2), std::bad_alloc);
+  EXPECT_TRUE(lst.append(1));
+}
+
+TEST(DblLnkListAssertions, SortAndMergeInPlace) {
+  std::vector<std::pair<int, int>> pairs{};  // (key, original position) - to check for stability
+  for (int i = 0; i < ITEM_NBR; i++)
+    pairs.emplace_back(rand() % 100, i);
+  const auto by_key = [](const auto &a, const auto &b) { return a.first < b.first; };
+  dbl_lnk_lst<std::pair<int, int>> lst{pairs};  // <<=== dbl-lnk-list
+  const auto *const head_node_value = &*lst.begin();
+  lst.sort(by_key);
+  std::stable_sort(pairs.begin(), pairs.end(), by_key);
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  EXPECT_TRUE(std::equal(lst.begin(), lst.end(), pairs.begin()));
+  EXPECT_TRUE(std::equal(lst.rbegin(), lst.rend(), pairs.rbegin()));
+  // nodes were relinked, not reallocated
+  bool found = false;
+  for (auto &item: lst)
+    found = found || &item == head_node_value;
+  EXPECT_TRUE(found);
+
+  dbl_lnk_lst<int> empty_lst{};  // <<=== dbl-lnk-list
+  empty_lst.sort();
+  EXPECT_TRUE(empty_lst.is_empty());
+  dbl_lnk_lst<int> desc_lst{std::views::iota(0, ITEM_NBR)};  // <<=== dbl-lnk-list
+  desc_lst.sort(std::greater<>{});
+  EXPECT_EQ(*desc_lst.begin(), ITEM_NBR - 1);
+  EXPECT_EQ(*desc_lst.rbegin(), 0);
+
+  dbl_lnk_lst<int> evens{}, odds{};  // <<=== dbl-lnk-list
+  for (int i = 0; i < ITEM_NBR; i += 2) {
+    evens.append(i);
+    odds.append(i + 1);
+  }
+  evens.merge(odds);
+  EXPECT_TRUE(odds.is_empty());
+  EXPECT_TRUE(odds.begin() == odds.end());
+  EXPECT_EQ(evens.size(), ITEM_NBR);
+  int i = 0;
+  for (auto it = evens.begin(); it != evens.end(); ++it)
+    EXPECT_EQ(*it, i++);
+  for (auto it = evens.rbegin(); it != evens.rend(); ++it)
+    EXPECT_EQ(*it, --i);
+}
+
+TEST(DblLnkListAssertions, ParallelSort) {
+  std::vector<std::pair<int, int>> pairs{};
+  for (int i = 0; i < ITEM_NBR * 10; i++)
+    pairs.emplace_back(rand() % 1000, i);
+  const auto by_key = [](const auto &a, const auto &b) { return a.first < b.first; };
+  for (const size_t nbr_threads : {0, 1, 3, 8}) {
+    dbl_lnk_lst<std::pair<int, int>> lst{pairs};  // <<=== dbl-lnk-list
+    lst.parallel_sort(by_key, nbr_threads);
+    auto sorted = pairs;
+    std::stable_sort(sorted.begin(), sorted.end(), by_key);
+    EXPECT_EQ(lst.size(), sorted.size());
+    EXPECT_TRUE(std::equal(lst.begin(), lst.end(), sorted.begin()));
+    EXPECT_TRUE(std::equal(lst.rbegin(), lst.rend(), sorted.rbegin()));
+  }
+}
+
+static_assert(std::bidirectional_iterator<dbl_lnk_lst<int>::iterator>);
+static_assert(std::bidirectional_iterator<dbl_lnk_lst<int>::const_iterator>);
+static_assert(std::bidirectional_iterator<dbl_lnk_lst<int>::reverse_iterator>);
+static_assert(std::bidirectional_iterator<dbl_lnk_lst<int>::const_reverse_iterator>);
+static_assert(std::ranges::bidirectional_range<dbl_lnk_lst<int>>);
+static_assert(std::ranges::bidirectional_range<const dbl_lnk_lst<int>>);
+static_assert(sizeof(dbl_lnk_lst<int>::iterator) == 2 * sizeof(void*));
+
+TEST(DblLnkListAssertions, BidirectionalIteratorsAndRanges) {
+  dbl_lnk_lst<int> lst{std::views::iota(0, ITEM_NBR)};  // <<=== dbl-lnk-list
+  const auto &c_lst = lst;
+  EXPECT_EQ(std::distance(c_lst.begin(), c_lst.end()), ITEM_NBR);
+  EXPECT_EQ(*std::prev(lst.end()), ITEM_NBR - 1);
+  EXPECT_EQ(*std::prev(lst.rend()), 0);
+  EXPECT_EQ(*std::next(c_lst.cbegin(), 10), 10);
+  auto it = lst.begin();
+  ++it;
+  EXPECT_EQ(*it--, 1);
+  EXPECT_TRUE(it == lst.begin());
+  auto rit = lst.rbegin();
+  EXPECT_EQ(*++rit, ITEM_NBR - 2);
+  EXPECT_EQ(*--rit, ITEM_NBR - 1);
+  // iterator converts to const_iterator
+  dbl_lnk_lst<int>::const_iterator c_it = lst.begin();
+  EXPECT_TRUE(c_it == lst.cbegin());
+  EXPECT_TRUE(lst.begin() == c_it);
+  // std algorithms and views
+  EXPECT_EQ(std::ranges::find(lst, 42), std::next(lst.begin(), 42));
+  EXPECT_TRUE(std::ranges::equal(lst | std::views::reverse, c_lst | std::views::reverse));
+  EXPECT_EQ(*(lst | std::views::reverse).begin(), ITEM_NBR - 1);
+  int i = 0;
+  for (const int item : c_lst | std::views::filter([](int v) { return v % 2 == 0; })) {
+    EXPECT_EQ(item, i);
+    i += 2;
+  }
+  std::ranges::for_each(lst, [](int &v) { v = -v; });
+  EXPECT_EQ(*lst.rbegin(), -(ITEM_NBR - 1));
+  // positional operations accept const iterators and keep direction
+  auto ins_it = lst.insert_after(lst.crbegin(), 1);
+  EXPECT_EQ(*ins_it, 1);
+  EXPECT_EQ(*++ins_it, -(ITEM_NBR - 1));
+  EXPECT_EQ(*lst.rbegin(), 1);
+  auto next_it = lst.erase(lst.cbegin());
+  EXPECT_TRUE(next_it == lst.begin());
+  EXPECT_EQ(*next_it, -1);
+}
+
+static_assert(std::is_nothrow_move_constructible_v<dbl_lnk_lst<some_elm>>);
+static_assert(std::is_nothrow_move_assignable_v<dbl_lnk_lst<some_elm>>);
+static_assert(std::is_nothrow_swappable_v<dbl_lnk_lst<some_elm>>);
+
+static dbl_lnk_lst<int> make_batch(const int first, const int last) {
+  dbl_lnk_lst<int> batch{std::views::iota(first, last)};  // <<=== dbl-lnk-list
+  return batch;
+}
+
+TEST(DblLnkListAssertions, MoveSwapAndConcat) {
+  auto lst = make_batch(0, ITEM_NBR);
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  const auto *const first_item = &*lst.begin();
+  auto moved_lst{std::move(lst)};
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_TRUE(lst.begin() == lst.end());
+  EXPECT_EQ(moved_lst.size(), ITEM_NBR);
+  EXPECT_EQ(&*moved_lst.begin(), first_item); // the very same nodes
+  EXPECT_TRUE(lst.append(-1)); // moved-from list remains usable
+  lst = std::move(moved_lst);
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  EXPECT_EQ(&*lst.begin(), first_item);
+  EXPECT_TRUE(moved_lst.is_empty());
+
+  std::vector<dbl_lnk_lst<int>> batches{};
+  for (int i = 1; i <= 10; i++)
+    batches.push_back(make_batch(i * ITEM_NBR, (i + 1) * ITEM_NBR));
+  for (auto &batch: batches)
+    lst.concat(std::move(batch));
+  EXPECT_EQ(lst.size(), ITEM_NBR * 11);
+  EXPECT_TRUE(std::all_of(batches.begin(), batches.end(), [](const auto &batch) { return batch.is_empty(); }));
+  EXPECT_TRUE(std::ranges::equal(lst, std::views::iota(0, ITEM_NBR * 11)));
+  EXPECT_TRUE(std::ranges::equal(lst | std::views::reverse, std::views::iota(0, ITEM_NBR * 11) | std::views::reverse));
+
+  auto tail_lst = make_batch(-3, 0);
+  swap(lst, tail_lst);
+  EXPECT_EQ(lst.size(), 3);
+  EXPECT_EQ(tail_lst.size(), ITEM_NBR * 11);
+  lst.splice_back(tail_lst);
+  EXPECT_TRUE(tail_lst.is_empty());
+  EXPECT_TRUE(std::ranges::equal(lst, std::views::iota(-3, ITEM_NBR * 11)));
+  lst.splice_back(tail_lst);  // (splicing an empty list is a no-op)
+  EXPECT_EQ(lst.size(), ITEM_NBR * 11 + 3);
+}
+
+TEST(DblLnkListAssertions, MoveAssignAcrossMemoryResources) {
+  std::pmr::unsynchronized_pool_resource rsrc{}, oth_rsrc{};
+  cust_coll::pmr::dbl_lnk_lst<int> lst{&rsrc};  // <<=== dbl-lnk-list
+  cust_coll::pmr::dbl_lnk_lst<int> other{std::views::iota(0, ITEM_NBR), &oth_rsrc};  // <<=== dbl-lnk-list
+  lst.append(-1);
+  lst = std::move(other);  // polymorphic_allocator doesn't propagate - items are moved into new nodes
+  EXPECT_EQ(lst.get_allocator().resource(), &rsrc);
+  EXPECT_TRUE(other.is_empty());
+  EXPECT_TRUE(std::ranges::equal(lst, std::views::iota(0, ITEM_NBR)));
+  cust_coll::pmr::dbl_lnk_lst<int> same_rsrc_lst{std::views::iota(0, 3), &rsrc};  // <<=== dbl-lnk-list
+  const auto *const first_item = &*same_rsrc_lst.begin();
+  lst = std::move(same_rsrc_lst);  // equal allocators - nodes are taken over
+  EXPECT_EQ(&*lst.begin(), first_item);
+  EXPECT_EQ(lst.size(), 3);
+}
+
+static bool fail_allocs = false;
+
+/**
+ * std::allocator that throws std::bad_alloc while fail_allocs is set.
+ */
+template <typename T>
+struct failing_alloc : std::allocator<T> {
+  failing_alloc() noexcept = default;
+  template <typename U> failing_alloc(const failing_alloc<U>&) noexcept {}
+  template <typename U> struct rebind { using other = failing_alloc<U>; };
+  T* allocate(size_t n) {
+    if (fail_allocs)
+      throw std::bad_alloc{};
+    return std::allocator<T>::allocate(n);
+  }
+};
+
+static_assert(sizeof(dbl_lnk_lst<int>) == 3 * sizeof(void*)); // (no_lst_stats takes up no space)
+
+TEST(DblLnkListAssertions, OperationStats) {
+  using cust_coll::lst_op;
+  using cust_coll::lst_stats;
+  dbl_lnk_lst<int, failing_alloc<int>, cust_coll::lst_stats_collector> lst{std::views::iota(0, 100)};  // <<=== dbl-lnk-list
+  EXPECT_EQ(lst.stats().op_count(lst_op::append_range), 1);
+  EXPECT_TRUE(lst.insert_at(-1, 50));   // hit after visiting 51 nodes
+  EXPECT_TRUE(lst.append_at(-2, 999));  // miss after visiting all 101 nodes
+  EXPECT_TRUE(lst.delete_at(0));        // hit on first node
+  EXPECT_FALSE(lst.delete_at(999));     // miss after visiting all 101 nodes
+  lst.append(100);
+  lst.insert(-3);
+  lst.erase(lst.begin());
+  fail_allocs = true;
+  EXPECT_FALSE(lst.append(101));
+  EXPECT_FALSE(lst.insert_at(101, 1));
+  fail_allocs = false;
+
+  auto snapshot = lst.stats();
+  EXPECT_EQ(snapshot.op_count(lst_op::insert_at), 2);
+  EXPECT_EQ(snapshot.op_count(lst_op::append_at), 1);
+  EXPECT_EQ(snapshot.op_count(lst_op::delete_at), 2);
+  EXPECT_EQ(snapshot.op_count(lst_op::append), 2);
+  EXPECT_EQ(snapshot.op_count(lst_op::insert), 1);
+  EXPECT_EQ(snapshot.op_count(lst_op::erase), 1);
+  EXPECT_EQ(snapshot.op_count(lst_op::clear), 0);
+  EXPECT_EQ(snapshot.pos_hits, 2);
+  EXPECT_EQ(snapshot.pos_misses, 2);
+  EXPECT_EQ(snapshot.nodes_scanned, 51 + 101 + 1 + 101);
+  EXPECT_EQ(snapshot.scan_lengths[lst_stats::scan_bucket(51)], 1);
+  EXPECT_EQ(snapshot.scan_lengths[lst_stats::scan_bucket(101)], 2);
+  EXPECT_EQ(snapshot.scan_lengths[1], 1);
+  EXPECT_EQ(snapshot.alloc_failures, 2);
+  EXPECT_EQ(snapshot.nodes_in_use, lst.size());
+  EXPECT_EQ(snapshot.bytes_in_use, lst.size() * sizeof(cust_coll::lst_node<int>));
+  EXPECT_EQ(lst_stats::scan_bucket(0), 0);
+  EXPECT_EQ(lst_stats::scan_bucket(size_t{1} << 40), lst_stats::nbr_scan_buckets - 1);
+
+  const auto nbr_items = lst.size();
+  lst.clear();
+  snapshot = lst.stats();
+  EXPECT_EQ(snapshot.op_count(lst_op::clear), 1);
+  EXPECT_EQ(snapshot.nodes_cleared, nbr_items);
+  EXPECT_EQ(snapshot.bytes_in_use, 0);
+  lst.reset_stats();
+  EXPECT_EQ(lst.stats().op_count(lst_op::clear), 0);
+  EXPECT_EQ(lst.stats().pos_hits, 0);
+}
+
+TEST(DblLnkListAssertions, SinglePassBulkRemoval) {
+  dbl_lnk_lst<int> lst{std::views::iota(0, 100)};  // <<=== dbl-lnk-list
+  EXPECT_EQ(lst.remove_if([](const int v) { return v % 2 == 0; }), 50);
+  EXPECT_EQ(lst.size(), 50);
+  const auto odds = std::views::iota(0, 50) | std::views::transform([](int i) { return i * 2 + 1; });
+  EXPECT_TRUE(std::ranges::equal(lst, odds));
+  EXPECT_TRUE(std::ranges::equal(lst | std::views::reverse, odds | std::views::reverse));
+  EXPECT_EQ(lst.remove_if([](const int v) { return v == 1 || v == 99; }), 2);  // (head and tail)
+  EXPECT_EQ(*lst.begin(), 3);
+  EXPECT_EQ(*lst.rbegin(), 97);
+  EXPECT_EQ(lst.remove_if([](const int v) { return v > 1000; }), 0);
+  EXPECT_EQ(lst.size(), 48);
+
+  lst.append(7);
+  lst.insert(7);
+  lst.append_at(7, 51);
+  EXPECT_EQ(lst.remove(7), 4);
+  EXPECT_EQ(lst.remove(7), 0);
+  EXPECT_EQ(std::ranges::count(lst, 7), 0);
+  EXPECT_EQ(lst.size(), 47);
+
+  EXPECT_EQ(lst.remove_if([](const int) { return true; }), 47);
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(lst.begin(), lst.end());
+  EXPECT_EQ(lst.rbegin(), lst.rend());
+  EXPECT_TRUE(lst.append(1));
+  EXPECT_EQ(*lst.rbegin(), 1);
+
+  dbl_lnk_lst<some_elm, cust_coll::pool_allocator<some_elm>> pooled{std::vector<some_elm>(ITEM_NBR)};  // <<=== dbl-lnk-list
+  EXPECT_EQ(pooled.remove_if([](const some_elm &elm) { return elm.s.size() % 2 == 0; }) +
+            pooled.remove_if([](const some_elm&) { return true; }), ITEM_NBR);  // (slabs given back)
+  EXPECT_TRUE(pooled.is_empty());
+  EXPECT_TRUE(pooled.append(some_elm{}));
+}
+
+struct some_elm_hash {
+  size_t operator()(const some_elm &elm) const noexcept { return std::hash<std::string>{}(elm.s); }
+};
+
+TEST(DblLnkListAssertions, DeleteManyMatchesDeleteAtPerValue) {
+  std::vector<int> items(ITEM_NBR), doomed(ITEM_NBR / 10);
+  for (auto &item : items)
+    item = rand() % 1000;  // (plenty of duplicates)
+  for (auto &item : doomed)
+    item = rand() % 1200;  // (some not in the list at all)
+  dbl_lnk_lst<int> lst{items};  // <<=== dbl-lnk-list
+  dbl_lnk_lst<int> oracle{items};  // <<=== dbl-lnk-list
+  size_t nbr_deleted = 0;
+  for (const auto item : doomed)
+    nbr_deleted += oracle.delete_at(item) ? 1 : 0;
+  EXPECT_EQ(lst.delete_many(doomed), nbr_deleted);
+  EXPECT_EQ(lst.size(), oracle.size());
+  EXPECT_TRUE(std::ranges::equal(lst, oracle));
+  EXPECT_TRUE(std::ranges::equal(lst | std::views::reverse, oracle | std::views::reverse));
+  EXPECT_EQ(lst.delete_many(std::vector<int>{}), 0);
+
+  std::vector<some_elm> strs{100};
+  dbl_lnk_lst<some_elm> elms{strs};  // <<=== dbl-lnk-list
+  const std::vector<some_elm> picked{strs[0], strs[50], strs[99], some_elm{}};
+  EXPECT_EQ(elms.delete_many(picked, some_elm_hash{}), 3);
+  EXPECT_EQ(elms.size(), 97);
+  EXPECT_EQ(elms.begin()->s, strs[1].s);
+  EXPECT_EQ(elms.rbegin()->s, strs[98].s);
+}
+
+/**
+ * An element type that is neither default constructible nor cheap to build twice.
+ */
+struct no_default_elm {
+  int id;
+  std::string tag;
+  no_default_elm(const int id, std::string tag) : id{id}, tag{std::move(tag)} {}
+  bool operator==(const no_default_elm&) const = default;
+};
+
+template <typename L, typename U>
+concept can_append = requires(L &lst, U &&item) { lst.append(std::forward<U>(item)); };
+
+using unique_ptr_lst = dbl_lnk_lst<std::unique_ptr<int>>;
+static_assert(not can_append<unique_ptr_lst, const std::unique_ptr<int>&>);  // (copying in requires copy construction)
+static_assert(can_append<unique_ptr_lst, std::unique_ptr<int>>);
+
+TEST(DblLnkListAssertions, EmplaceMoveOnlyAndNonDefaultConstructible) {
+  unique_ptr_lst ptrs{};  // <<=== dbl-lnk-list
+  EXPECT_TRUE(ptrs.emplace_back(new int{3}));
+  EXPECT_TRUE(ptrs.emplace_front(std::make_unique<int>(2)));
+  EXPECT_TRUE(ptrs.append(std::make_unique<int>(1)));
+  EXPECT_TRUE(ptrs.insert(std::make_unique<int>(4)));
+  EXPECT_TRUE(ptrs.emplace_after(*ptrs.begin(), new int{5}));  // (matched by pointer value)
+  auto deref = [](const std::unique_ptr<int> &p) { return *p; };
+  EXPECT_TRUE(std::ranges::equal(ptrs | std::views::transform(deref), std::vector{4, 5, 2, 3, 1}));
+  ptrs.sort([](const auto &a, const auto &b) { return *a < *b; });
+  EXPECT_TRUE(std::ranges::equal(ptrs | std::views::transform(deref), std::vector{1, 2, 3, 4, 5}));
+  EXPECT_EQ(ptrs.remove_if([](const auto &p) { return *p % 2 == 0; }), 2);
+  unique_ptr_lst moved{std::move(ptrs)};  // <<=== dbl-lnk-list
+  moved.erase(moved.begin());
+  EXPECT_TRUE(std::ranges::equal(moved | std::views::transform(deref), std::vector{3, 5}));
+
+  dbl_lnk_lst<no_default_elm> elms{};  // <<=== dbl-lnk-list
+  EXPECT_TRUE(elms.emplace_back(2, "two"));
+  EXPECT_TRUE(elms.emplace_front(0, "zero"));
+  EXPECT_TRUE(elms.emplace_at(no_default_elm{2, "two"}, 1, "one"));
+  EXPECT_TRUE(elms.emplace_after(no_default_elm{2, "two"}, 3, "three"));
+  EXPECT_TRUE(elms.emplace_at(no_default_elm{9, "absent"}, 4, "four"));  // (no match - appended)
+  EXPECT_TRUE(elms.append(no_default_elm{5, "five"}));
+  std::vector<int> ids{};
+  for (const auto &elm : elms)
+    ids.push_back(elm.id);
+  EXPECT_EQ(ids, (std::vector{0, 1, 2, 3, 4, 5}));
+  EXPECT_EQ(elms.rbegin()->tag, "five");
+  EXPECT_TRUE(elms.delete_at(no_default_elm{3, "three"}));
+  EXPECT_EQ(elms.size(), 5);
+}
+
+TEST(DblLnkListAssertions, ExtractAndReinsertNodeHandles) {
+  using cust_coll::pool_allocator;
+  std::vector<some_elm> strs{10};
+  dbl_lnk_lst<some_elm> pending{strs};  // <<=== dbl-lnk-list
+  dbl_lnk_lst<some_elm> active{};  // <<=== dbl-lnk-list
+  const auto *const first_item = &*pending.begin();
+  auto nh = pending.extract(pending.begin());
+  ASSERT_FALSE(nh.empty());
+  EXPECT_EQ(&nh.value(), first_item);
+  EXPECT_EQ(pending.size(), 9);
+  nh.value().s += "-active";  // (mutable while detached)
+  EXPECT_TRUE(active.append(std::move(nh)));
+  EXPECT_TRUE(nh.empty());
+  EXPECT_EQ(&*active.begin(), first_item);  // (same node - no allocation, no move)
+  EXPECT_EQ(active.begin()->s, strs[0].s + "-active");
+  EXPECT_FALSE(active.append(std::move(nh)));  // (empty handle)
+
+  auto by_value = pending.extract(strs[5]);
+  ASSERT_TRUE(by_value);
+  EXPECT_TRUE(active.insert(std::move(by_value)));
+  EXPECT_EQ(active.begin()->s, strs[5].s);
+  EXPECT_FALSE(pending.extract(strs[5]));  // (no longer there)
+  EXPECT_FALSE(pending.extract(pending.end()));
+  auto last = pending.extract(pending.rbegin());
+  EXPECT_EQ(last.value().s, strs[9].s);
+  EXPECT_EQ(pending.rbegin()->s, strs[8].s);
+  EXPECT_EQ(pending.size(), 7);
+  EXPECT_EQ(active.size(), 2);
+
+  decltype(last) moved{std::move(last)};
+  EXPECT_TRUE(last.empty());
+  moved = pending.extract(pending.begin());  // (prior node is freed)
+  EXPECT_EQ(moved.value().s, strs[1].s);
+  EXPECT_EQ(pending.size(), 6);
+
+  // across lists with unequal allocators the item is moved into a node of the receiving list
+  using pooled_lst = dbl_lnk_lst<some_elm, pool_allocator<some_elm>>;
+  pooled_lst pool_a{std::vector<some_elm>(3)};  // <<=== dbl-lnk-list
+  pooled_lst pool_b{};  // <<=== dbl-lnk-list
+  const auto sav = *pool_a.begin();
+  EXPECT_TRUE(pool_b.append(pool_a.extract(pool_a.begin())));
+  EXPECT_EQ(pool_b.begin()->s, sav.s);
+  EXPECT_EQ(pool_a.size(), 2);
+
+  cust_coll::pmr::dbl_lnk_lst<int> pmr_lst{std::views::iota(0, 5)};  // <<=== dbl-lnk-list
+  auto pmr_nh = pmr_lst.extract(2);
+  pmr_nh = pmr_lst.extract(3);  // (polymorphic_allocator is re-emplaced, not assigned)
+  EXPECT_TRUE(pmr_lst.insert(std::move(pmr_nh)));
+  EXPECT_TRUE(std::ranges::equal(pmr_lst, std::vector{3, 0, 1, 4}));
+}
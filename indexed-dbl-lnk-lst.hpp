@@ -0,0 +1,276 @@
+//
+// Created by rogerv on 5/16/24.
+//
+#ifndef INDEXED_DBL_LNK_LST_HPP
+#define INDEXED_DBL_LNK_LST_HPP
+
+#include <functional>
+#include <unordered_map>
+#include "dbl-lnk-lst.hpp"
+
+namespace cust_coll {
+
+  /**
+   * A dbl_lnk_lst that also maintains a hashed index of its element values, so that the
+   * positional operations insert_at/append_at/delete_at locate their pos item in O(1) average
+   * time instead of scanning the list.
+   *
+   * Semantics are the same as dbl_lnk_lst - insert_at and delete_at act on the first pos match
+   * starting from head of list, append_at on the first match starting from tail of list. The
+   * index tracks first and last occurrence of each distinct value. Where a value occurs more than
+   * once, keeping those up to date costs a walk of the list: a node linked in at head or tail of
+   * list, or next to an occurrence of its own value, costs O(1), any other a walk to the nearest
+   * other occurrence of its value; delete_at walks from the deleted node to the next occurrence
+   * of its value. So values repeated densely (many duplicates) stay cheap, whereas a value whose
+   * few occurrences lie far apart costs up to O(n) per operation.
+   *
+   * Elements must not be modified (via iterator) in a way that changes their equality or hash
+   * while contained in the list.
+   *
+   * @tparam T type of element contained by container - as constrained by
+   *           concept lst_elm_type_constraints
+   * @tparam Hash hash function object for T (consistent with T::operator==)
+   * @tparam Alloc allocator type - is rebound to allocate the list nodes and the index entries
+   */
+  template <typename T, typename Hash = std::hash<T>, typename Alloc = std::allocator<T>>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  class indexed_dbl_lnk_lst : protected dbl_lnk_lst<T, Alloc> {
+  protected:
+    using base = dbl_lnk_lst<T, Alloc>;
+    using node_t = lst_node<T>;
+    using key_t = std::reference_wrapper<const T>; // refers to the value of the first occurrence
+    struct occurrences {
+      node_t *first; // non-owning plain pointer
+      node_t *last;  // non-owning plain pointer
+      size_t nbr;
+    };
+    struct key_hash {
+      [[no_unique_address]] Hash hash{};
+      size_t operator()(const key_t &k) const noexcept { return hash(k.get()); }
+    };
+    struct key_equal {
+      bool operator()(const key_t &a, const key_t &b) const noexcept { return a.get() == b.get(); }
+    };
+    using index_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<std::pair<const key_t, occurrences>>;
+    using index_t = std::unordered_map<key_t, occurrences, key_hash, key_equal, index_alloc_t>;
+    index_t index;
+    void rekey(typename index_t::iterator it, node_t *first) noexcept;
+    bool index_add(node_t *node) noexcept;
+    void index_remove(node_t *node) noexcept;
+    template <typename U> bool insert_node(U &&item, node_t *pos_node, bool before) noexcept;
+  public:
+    using typename base::allocator_type;
+    using typename base::iterator;
+    using typename base::const_iterator;
+    using typename base::reverse_iterator;
+    using typename base::const_reverse_iterator;
+    indexed_dbl_lnk_lst() noexcept(std::is_nothrow_default_constructible_v<base> &&
+                                   std::is_nothrow_default_constructible_v<index_t>) = default;
+    explicit indexed_dbl_lnk_lst(const Alloc &alloc) noexcept : base{alloc}, index{index_alloc_t{alloc}} {}
+    ~indexed_dbl_lnk_lst() noexcept { clear(); }
+    using base::size;
+    using base::is_empty;
+    using base::get_allocator;
+    bool insert(const T& item) noexcept { return insert_node(item, this->head, true); }
+    bool insert(T &&item) noexcept { return insert_node(std::move(item), this->head, true); }
+    bool insert_at(const T& item, const T&pos) noexcept;
+    bool insert_at(T &&item, const T&pos) noexcept;
+    bool append(const T& item) noexcept { return insert_node(item, this->tail, false); }
+    bool append(T &&item) noexcept { return insert_node(std::move(item), this->tail, false); }
+    bool append_at(const T& item, const T&pos) noexcept;
+    bool append_at(T &&item, const T&pos) noexcept;
+    bool delete_at(const T&pos) noexcept;
+    bool contains(const T&pos) const noexcept { return index.contains(std::cref(pos)); }
+    void clear() noexcept { index.clear(); base::clear(); }
+    using base::begin;
+    using base::end;
+    using base::cbegin;
+    using base::cend;
+    using base::rbegin;
+    using base::rend;
+    using base::crbegin;
+    using base::crend;
+  };
+
+  /**
+   * Changes the first occurrence of an index entry - the entry's key is re-pointed at the value
+   * of the new first occurrence (relinking the entry's hash node; no memory is allocated).
+   */
+  template <typename T, typename Hash, typename Alloc>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  void indexed_dbl_lnk_lst<T, Hash, Alloc>::rekey(typename index_t::iterator it, node_t *const first) noexcept {
+    auto nh = index.extract(it);
+    nh.key() = std::cref(first->value);
+    nh.mapped().first = first;
+    index.insert(std::move(nh)); // same element count as before extract so won't rehash
+  }
+
+  /**
+   * Records a newly linked node in the index.
+   * @return false when fails to allocate memory for a new index entry
+   */
+  template <typename T, typename Hash, typename Alloc>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  bool indexed_dbl_lnk_lst<T, Hash, Alloc>::index_add(node_t *const node) noexcept {
+    typename index_t::iterator it;
+    bool inserted;
+    try {
+      std::tie(it, inserted) = index.try_emplace(std::cref(node->value), occurrences{node, node, 1});
+    } catch (...) {
+      return false;
+    }
+    if (not inserted) {
+      auto &occ = it->second;
+      occ.nbr++;
+      if (node->prev == nullptr || node->next == occ.first) {
+        rekey(it, node);
+      } else if (node->next == nullptr || node->prev == occ.last) {
+        occ.last = node;
+      } else {
+        // the nearest other occurrence, walking outward from node both ways, is its neighbour in
+        // order of occurrence - node is a new first (last) when that is the first (last) one
+        for (auto *fwd = node->next, *bwd = node->prev;;) {
+          if (fwd != nullptr) {
+            if (fwd->value == node->value) {
+              if (fwd == occ.first)
+                rekey(it, node);
+              break;
+            }
+            fwd = fwd->next;
+          }
+          if (bwd != nullptr) {
+            if (bwd->value == node->value) {
+              if (bwd == occ.last)
+                occ.last = node;
+              break;
+            }
+            bwd = bwd->prev;
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Drops a node, about to be unlinked, from the index - the node must be the first occurrence
+   * of its value (which is always the case for delete_at); the next occurrence, if any, is found
+   * by walking on from it.
+   */
+  template <typename T, typename Hash, typename Alloc>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  void indexed_dbl_lnk_lst<T, Hash, Alloc>::index_remove(node_t *const node) noexcept {
+    auto it = index.find(std::cref(node->value));
+    assert(it != index.end() && it->second.first == node); // (we trust but verify)
+    if (auto &occ = it->second; --occ.nbr == 0) {
+      index.erase(it);
+    } else {
+      auto *next_dup = node->next;
+      while (not (next_dup->value == node->value))
+        next_dup = next_dup->next;
+      rekey(it, next_dup);
+    }
+  }
+
+  /**
+   * Allocates a node for item and links it in before (or after) pos_node - when pos_node is
+   * null then item is appended at tail of list.
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T, typename Hash, typename Alloc>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  template <typename U>
+  bool indexed_dbl_lnk_lst<T, Hash, Alloc>::insert_node(U &&item, node_t *const pos_node, const bool before) noexcept {
+    auto *const node = this->new_node(std::forward<U>(item));
+    if (node == nullptr)
+      return false;
+    if (pos_node == nullptr)
+      this->append_at_tail(node);
+    else if (before)
+      this->link_before(pos_node, node);
+    else
+      this->link_after(pos_node, node);
+    if (not index_add(node)) {
+      this->unlink(node);
+      this->free_node(node);
+      return false;
+    }
+    this->count++;
+    return true;
+  }
+
+  /**
+   * Looks up the first occurrence of the pos specified item (starting from head of list) via the
+   * index; will copy item into the container in front of it. If the pos item is not found
+   * then will fall back to appending the item at the end of the list.
+   * @tparam T item's type
+   * @param item to be copy-inserted
+   * @param pos item to be inserted in front of
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T, typename Hash, typename Alloc>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  bool indexed_dbl_lnk_lst<T, Hash, Alloc>::insert_at(const T& item, const T&pos) noexcept {
+    const auto it = index.find(std::cref(pos));
+    return insert_node(item, it != index.end() ? it->second.first : nullptr, true);
+  }
+
+  /**
+   * Same as insert_at() above but moves item into the container (thus taking ownership).
+   */
+  template <typename T, typename Hash, typename Alloc>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  bool indexed_dbl_lnk_lst<T, Hash, Alloc>::insert_at(T &&item, const T&pos) noexcept {
+    const auto it = index.find(std::cref(pos));
+    return insert_node(std::move(item), it != index.end() ? it->second.first : nullptr, true);
+  }
+
+  /**
+   * Looks up the last occurrence of the pos specified item (i.e., first starting from tail of
+   * list) via the index; will copy item into the container right after it. If the pos item is
+   * not found then will fall back to appending the item at the end of the list.
+   * @tparam T item's type
+   * @param item to be copy-inserted
+   * @param pos item to be inserted after
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T, typename Hash, typename Alloc>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  bool indexed_dbl_lnk_lst<T, Hash, Alloc>::append_at(const T& item, const T&pos) noexcept {
+    const auto it = index.find(std::cref(pos));
+    return insert_node(item, it != index.end() ? it->second.last : nullptr, false);
+  }
+
+  /**
+   * Same as append_at() above but moves item into the container (thus taking ownership).
+   */
+  template <typename T, typename Hash, typename Alloc>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  bool indexed_dbl_lnk_lst<T, Hash, Alloc>::append_at(T &&item, const T&pos) noexcept {
+    const auto it = index.find(std::cref(pos));
+    return insert_node(std::move(item), it != index.end() ? it->second.last : nullptr, false);
+  }
+
+  /**
+   * Removes a pos specified matched item from list (the first match starting from head of list).
+   * @tparam T item's type
+   * @param pos item to be removed
+   * @return returns true if item was matched and removed from list
+   */
+  template <typename T, typename Hash, typename Alloc>
+    requires lst_elm_type_constraints<T> && std::is_invocable_r_v<size_t, const Hash&, const T&>
+  bool indexed_dbl_lnk_lst<T, Hash, Alloc>::delete_at(const T&pos) noexcept {
+    const auto it = index.find(std::cref(pos));
+    if (it == index.end())
+      return false;
+    auto *const node = it->second.first;
+    index_remove(node);
+    this->unlink(node);
+    this->free_node(node);
+    this->count--;
+    return true;
+  }
+
+} // cust_coll
+
+#endif //INDEXED_DBL_LNK_LST_HPP
@@ -0,0 +1,147 @@
+//
+// Created by rogerv on 5/16/24.
+//
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "indexed-dbl-lnk-lst.hpp"
+using cust_coll::indexed_dbl_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+
+struct some_elm_hash {
+  size_t operator()(const some_elm &elm) const noexcept { return std::hash<std::string>{}(elm.s); }
+};
+
+static void random_ops_vs_oracle(const int nbr_values) {
+  indexed_dbl_lnk_lst<int> lst{};  // <<=== indexed-dbl-lnk-list
+  std::list<int> oracle{};
+  for (int i = 0; i < ITEM_NBR; i++) {
+    const int val = rand() % nbr_values;
+    const int pos = rand() % nbr_values;
+    switch (rand() % 5) {
+      case 0: {
+        EXPECT_TRUE(lst.insert(val));
+        oracle.push_front(val);
+        break;
+      }
+      case 1: {
+        EXPECT_TRUE(lst.append(val));
+        oracle.push_back(val);
+        break;
+      }
+      case 2: {
+        EXPECT_TRUE(lst.insert_at(val, pos));
+        oracle.insert(std::find(oracle.begin(), oracle.end(), pos), val);
+        break;
+      }
+      case 3: {
+        EXPECT_TRUE(lst.append_at(val, pos));
+        auto it = std::find(oracle.rbegin(), oracle.rend(), pos);
+        oracle.insert(it != oracle.rend() ? it.base() : oracle.end(), val); // (base() is one past the match)
+        break;
+      }
+      default: {
+        auto it = std::find(oracle.begin(), oracle.end(), pos);
+        EXPECT_EQ(lst.delete_at(pos), it != oracle.end());
+        if (it != oracle.end())
+          oracle.erase(it);
+      }
+    }
+  }
+  ASSERT_EQ(lst.size(), oracle.size());
+  EXPECT_TRUE(std::equal(lst.begin(), lst.end(), oracle.begin()));
+  EXPECT_TRUE(std::equal(lst.rbegin(), lst.rend(), oracle.rbegin()));
+  for (int pos = 0; pos < nbr_values; pos++) {
+    while (lst.delete_at(pos)) {}
+    EXPECT_FALSE(lst.contains(pos));
+  }
+  EXPECT_TRUE(lst.is_empty());
+}
+
+TEST(IndexedDblLnkListAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  indexed_dbl_lnk_lst<some_elm, some_elm_hash> lst{};  // <<=== indexed-dbl-lnk-list
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(lst.is_empty());
+}
+
+TEST(IndexedDblLnkListAssertions, InsertAtDeleteAtSomeElm) {
+  std::vector<some_elm> strs{ITEM_NBR};
+  some_elm::count = 0;
+  indexed_dbl_lnk_lst<some_elm, some_elm_hash> lst{};  // <<=== indexed-dbl-lnk-list
+  for (const auto &elm: strs) {
+    auto r = lst.append(elm);
+    EXPECT_TRUE(r);
+    some_elm::count += 1;
+  }
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  EXPECT_TRUE(lst.contains(strs[ITEM_NBR / 2]));
+  some_elm item{};
+  some_elm sav_item{item};
+  auto r = lst.insert_at(std::move(item), strs[ITEM_NBR / 2]);
+  EXPECT_TRUE(r);
+  some_elm::count += 1;
+  auto lst_it = lst.begin();
+  for (int i = 0; i < ITEM_NBR / 2; i++)
+    ++lst_it;
+  EXPECT_EQ(lst_it->s, sav_item.s);
+  EXPECT_EQ((++lst_it)->s, strs[ITEM_NBR / 2].s);
+  r = lst.delete_at(sav_item);
+  EXPECT_TRUE(r);
+  r = lst.delete_at(sav_item);
+  EXPECT_FALSE(r);
+  for (const auto &elm: strs) {
+    r = lst.delete_at(elm);
+    EXPECT_TRUE(r);
+  }
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(some_elm::count, 0);
+}
+
+TEST(IndexedDblLnkListAssertions, UniqueValuesVsStdList) {
+  random_ops_vs_oracle(ITEM_NBR * 10);
+}
+
+TEST(IndexedDblLnkListAssertions, DuplicateValuesVsStdList) {
+  random_ops_vs_oracle(64);
+}
+
+TEST(IndexedDblLnkListAssertions, DenseDuplicatesAroundMidList) {
+  random_ops_vs_oracle(3);
+
+  // a long list of a few values repeated over and over, with one marker item midway - items linked
+  // in beside the marker find their neighbouring duplicates a few nodes away (not at head or tail)
+  constexpr int nbr_values = 4, marker = -1;
+  indexed_dbl_lnk_lst<int> lst{};  // <<=== indexed-dbl-lnk-list
+  std::list<int> oracle{};
+  for (int i = 0; i < ITEM_NBR * 10; i++) {
+    if (i == ITEM_NBR * 5) {
+      EXPECT_TRUE(lst.append(marker));
+      oracle.push_back(marker);
+    }
+    EXPECT_TRUE(lst.append(i % nbr_values));
+    oracle.push_back(i % nbr_values);
+  }
+  const auto marker_it = std::find(oracle.begin(), oracle.end(), marker);
+  for (int i = 0; i < ITEM_NBR; i++) {
+    EXPECT_TRUE(lst.insert_at(i % nbr_values, marker));
+    oracle.insert(marker_it, i % nbr_values);
+    EXPECT_TRUE(lst.append_at(i % nbr_values, marker));
+    oracle.insert(std::next(marker_it), i % nbr_values);
+  }
+  // the first occurrence of each value is still tracked right - delete_at takes it
+  for (int i = 0; i < ITEM_NBR; i++) {
+    EXPECT_TRUE(lst.delete_at(i % nbr_values));
+    oracle.erase(std::find(oracle.begin(), oracle.end(), i % nbr_values));
+  }
+  ASSERT_EQ(lst.size(), oracle.size());
+  EXPECT_TRUE(std::equal(lst.begin(), lst.end(), oracle.begin()));
+  EXPECT_TRUE(lst.append_at(marker, marker));
+  EXPECT_TRUE(lst.delete_at(marker));
+  EXPECT_TRUE(lst.contains(marker));
+}
@@ -0,0 +1,267 @@
+//
+// Created by rogerv on 5/18/24.
+//
+#ifndef INTRUSIVE_DBL_LNK_LST_HPP
+#define INTRUSIVE_DBL_LNK_LST_HPP
+
+#include <cstddef>
+#include <concepts>
+#include <iterator>
+#include <type_traits>
+#include "lnk-anchor.hpp"
+
+namespace cust_coll {
+
+  /**
+   * Member hook that an object embeds in order to be linked into an intrusive_dbl_lnk_lst (an
+   * object can embed several hooks so as to be in several lists at once). The list records the
+   * embedding object's address in the hook as it links it in - so the object is reached from its
+   * hook without any assumption about T's layout.
+   */
+  struct lst_hook {
+    lst_hook *prev{nullptr};  // non-owning plain pointer
+    lst_hook *next{nullptr};  // non-owning plain pointer
+    void *owner{nullptr};     // non-owning plain pointer (the object embedding this hook)
+  };
+
+  /**
+   * An intrusive doubly-linked-list - the prev/next links live in the caller's objects (as a
+   * lst_hook member), so the container never allocates nor copies/moves the objects; insert,
+   * append and unlink-by-object-address are all O(1) and noexcept.
+   *
+   * The container doesn't own the objects - they must outlive their membership in the list,
+   * and an object can only be linked into one list per hook at a time.
+   *
+   *     struct elm { int val; cust_coll::lst_hook hook; };
+   *     cust_coll::intrusive_dbl_lnk_lst<elm, &elm::hook> lst{};
+   *
+   * @tparam T type of the linked objects
+   * @tparam Hook pointer to T's lst_hook data member used by this list
+   */
+  template <typename T, lst_hook T::*Hook>
+  class intrusive_dbl_lnk_lst : protected lnk_anchor<lst_hook> {
+  protected:
+    using anchor = lnk_anchor<lst_hook>;
+    size_t count{0};
+    static lst_hook* hook_of(T &obj) noexcept;
+    static T* owner_of(const lst_hook *hook) noexcept { return static_cast<T*>(hook->owner); }
+    lst_hook* find_first(const T&pos) const noexcept requires std::equality_comparable<T>;
+    lst_hook* find_last(const T&pos) const noexcept requires std::equality_comparable<T>;
+  public:
+    intrusive_dbl_lnk_lst()  noexcept = default;
+    intrusive_dbl_lnk_lst(const intrusive_dbl_lnk_lst&) = delete;
+    intrusive_dbl_lnk_lst& operator=(const intrusive_dbl_lnk_lst&) = delete;
+    ~intrusive_dbl_lnk_lst() noexcept { clear(); }
+    size_t size() const noexcept { return count; }
+    bool is_empty() const noexcept { return count == 0; }
+    void insert(T &obj) noexcept;
+    void insert_at(T &obj, const T&pos) noexcept requires std::equality_comparable<T>;
+    void append(T &obj) noexcept;
+    void append_at(T &obj, const T&pos) noexcept requires std::equality_comparable<T>;
+    bool delete_at(const T&pos) noexcept requires std::equality_comparable<T>;
+    void unlink(T &obj) noexcept;
+    void clear() noexcept;
+
+    /**
+     * Bidirectional iterator - Reverse iterates from tail to head, Const gives read-only access
+     * to the objects (same scheme as dbl_lnk_lst::basic_iterator).
+     */
+    template <bool Reverse, bool Const>
+    class basic_iterator {
+    public:
+      using iterator_concept  = std::bidirectional_iterator_tag;
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type  = T;
+      using pointer     = std::conditional_t<Const, const T*, T*>;
+      using reference   = std::conditional_t<Const, const T&, T&>;
+    protected:
+      lst_hook *node{nullptr};                  // non-owning plain pointer (null at end)
+      const intrusive_dbl_lnk_lst *lst{nullptr}; // non-owning plain pointer
+      friend class intrusive_dbl_lnk_lst;
+      template <bool, bool> friend class basic_iterator;
+      basic_iterator(lst_hook *n, const intrusive_dbl_lnk_lst *l) noexcept : node{n}, lst{l} {}
+    public:
+      basic_iterator() noexcept = default;
+      // a non-const iterator converts to its const counterpart
+      template <bool C = Const> requires C
+      basic_iterator(const basic_iterator<Reverse, false> &oth) noexcept : node{oth.node}, lst{oth.lst} {}
+      // Prefix increment
+      basic_iterator& operator++() noexcept {
+        node = Reverse ? node->prev : node->next;
+        return *this;
+      }
+      // Postfix increment
+      basic_iterator operator++(int) noexcept { basic_iterator tmp = *this; ++(*this); return tmp; }
+      // Prefix decrement (end() decrements to the last object in iteration order)
+      basic_iterator& operator--() noexcept {
+        if (node != nullptr)
+          node = Reverse ? node->next : node->prev;
+        else
+          node = Reverse ? lst->head : lst->tail;
+        return *this;
+      }
+      // Postfix decrement
+      basic_iterator operator--(int) noexcept { basic_iterator tmp = *this; --(*this); return tmp; }
+      friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.node == b.node; };
+      reference operator*() const noexcept { return *owner_of(node); }
+      pointer operator->() const noexcept { return owner_of(node); }
+    };
+    using iterator = basic_iterator<false, false>;
+    using const_iterator = basic_iterator<false, true>;
+    using reverse_iterator = basic_iterator<true, false>;
+    using const_reverse_iterator = basic_iterator<true, true>;
+    iterator begin() noexcept { return iterator{head, this}; }
+    iterator end() noexcept { return iterator{nullptr, this}; }
+    const_iterator begin() const noexcept { return const_iterator{head, this}; }
+    const_iterator end() const noexcept { return const_iterator{nullptr, this}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator{tail, this}; }
+    reverse_iterator rend() noexcept { return reverse_iterator{nullptr, this}; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{tail, this}; }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator{nullptr, this}; }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+  };
+
+  /**
+   * @return obj's hook for this list - stamped with obj's address, for owner_of() to get back to
+   *         obj once linked
+   */
+  template <typename T, lst_hook T::*Hook>
+  inline lst_hook* intrusive_dbl_lnk_lst<T, Hook>::hook_of(T &obj) noexcept {
+    auto *const hook = &(obj.*Hook);
+    hook->owner = &obj;
+    return hook;
+  }
+
+  template <typename T, lst_hook T::*Hook>
+  auto intrusive_dbl_lnk_lst<T, Hook>::find_first(const T&pos) const noexcept -> lst_hook*
+    requires std::equality_comparable<T>
+  {
+    for (auto *curr_node = head; curr_node != nullptr; curr_node = curr_node->next) {
+      if (*owner_of(curr_node) == pos)
+        return curr_node;
+    }
+    return nullptr;
+  }
+
+  template <typename T, lst_hook T::*Hook>
+  auto intrusive_dbl_lnk_lst<T, Hook>::find_last(const T&pos) const noexcept -> lst_hook*
+    requires std::equality_comparable<T>
+  {
+    for (auto *curr_node = tail; curr_node != nullptr; curr_node = curr_node->prev) {
+      if (*owner_of(curr_node) == pos)
+        return curr_node;
+    }
+    return nullptr;
+  }
+
+  /**
+   * Links obj into container where will be at head of list.
+   * @tparam T object's type
+   * @param obj to be linked (must not currently be linked via this Hook)
+   */
+  template <typename T, lst_hook T::*Hook>
+  void intrusive_dbl_lnk_lst<T, Hook>::insert(T &obj) noexcept {
+    insert_at_head(hook_of(obj));
+    count++;
+  }
+
+  /**
+   * Starting from head of list, iterates list forward, looking to match on the pos specified item;
+   * will link obj into the container in front of the found pos item. If the pos item is not found
+   * then will fall back to appending obj at the end of the list.
+   * @tparam T object's type
+   * @param obj to be linked (must not currently be linked via this Hook)
+   * @param pos item to be inserted in front of
+   */
+  template <typename T, lst_hook T::*Hook>
+  void intrusive_dbl_lnk_lst<T, Hook>::insert_at(T &obj, const T&pos) noexcept
+    requires std::equality_comparable<T>
+  {
+    if (auto *const pos_node = find_first(pos); pos_node != nullptr)
+      link_before(pos_node, hook_of(obj));
+    else
+      append_at_tail(hook_of(obj));
+    count++;
+  }
+
+  /**
+   * Links obj into container where will be at tail of list.
+   * @tparam T object's type
+   * @param obj to be linked (must not currently be linked via this Hook)
+   */
+  template <typename T, lst_hook T::*Hook>
+  void intrusive_dbl_lnk_lst<T, Hook>::append(T &obj) noexcept {
+    append_at_tail(hook_of(obj));
+    count++;
+  }
+
+  /**
+   * Starting from tail of list, iterates list backward, looking to match on the pos specified item;
+   * will link obj into the container right after the found pos item. If the pos item is not found
+   * then will fall back to appending obj at the end of the list.
+   * @tparam T object's type
+   * @param obj to be linked (must not currently be linked via this Hook)
+   * @param pos item to be inserted after
+   */
+  template <typename T, lst_hook T::*Hook>
+  void intrusive_dbl_lnk_lst<T, Hook>::append_at(T &obj, const T&pos) noexcept
+    requires std::equality_comparable<T>
+  {
+    if (auto *const pos_node = find_last(pos); pos_node != nullptr)
+      link_after(pos_node, hook_of(obj));
+    else
+      append_at_tail(hook_of(obj));
+    count++;
+  }
+
+  /**
+   * Unlinks a pos specified matched object from list (the object itself is left untouched).
+   * @tparam T object's type
+   * @param pos item to be unlinked
+   * @return returns true if item was matched and unlinked from list
+   */
+  template <typename T, lst_hook T::*Hook>
+  bool intrusive_dbl_lnk_lst<T, Hook>::delete_at(const T&pos) noexcept
+    requires std::equality_comparable<T>
+  {
+    if (auto *const node = find_first(pos); node != nullptr) {
+      anchor::unlink(node);
+      count--;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Unlinks obj from list by its address - O(1), no scan of the list takes place.
+   * @tparam T object's type
+   * @param obj to be unlinked (must currently be linked into this list)
+   */
+  template <typename T, lst_hook T::*Hook>
+  void intrusive_dbl_lnk_lst<T, Hook>::unlink(T &obj) noexcept {
+    anchor::unlink(hook_of(obj));
+    count--;
+  }
+
+  /**
+   * Unlinks all objects from container (resetting their hooks).
+   * @tparam T object's type
+   */
+  template <typename T, lst_hook T::*Hook>
+  void intrusive_dbl_lnk_lst<T, Hook>::clear() noexcept {
+    for (auto *node = head; node != nullptr;) {
+      auto *const next_node = node->next;
+      node->prev = node->next = nullptr;
+      node = next_node;
+    }
+    head = tail = nullptr;
+    count = 0;
+  }
+
+} // cust_coll
+
+#endif //INTRUSIVE_DBL_LNK_LST_HPP
@@ -0,0 +1,159 @@
+//
+// Created by rogerv on 5/18/24.
+//
+#include <vector>
+#include <ranges>
+#include <iterator>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "intrusive-dbl-lnk-lst.hpp"
+using cust_coll::intrusive_dbl_lnk_lst;
+using cust_coll::lst_hook;
+
+static constexpr auto ITEM_NBR = 10000;
+
+/**
+ * An object that can be in two intrusive lists at once.
+ */
+struct hooked_elm {
+  some_elm elm{};
+  lst_hook hook{};
+  lst_hook oth_hook{};
+  bool operator==(const hooked_elm &oth) const { return elm == oth.elm; }
+};
+
+TEST(IntrusiveDblLnkListAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  intrusive_dbl_lnk_lst<hooked_elm, &hooked_elm::hook> lst{};  // <<=== intrusive-dbl-lnk-list
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_TRUE(lst.begin() == lst.end());
+}
+
+TEST(IntrusiveDblLnkListAssertions, InsertAndAppendLinkInPlace) {
+  std::vector<hooked_elm> objs(ITEM_NBR);
+  intrusive_dbl_lnk_lst<hooked_elm, &hooked_elm::hook> lst{};  // <<=== intrusive-dbl-lnk-list
+  for (auto &obj: objs)
+    lst.insert(obj);
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  auto objs_it = objs.begin();
+  for (auto lst_it = lst.rbegin(); lst_it != lst.rend(); ++lst_it) {
+    EXPECT_EQ(&*lst_it, &*objs_it++); // the very same objects, not copies
+  }
+  lst.clear();
+  EXPECT_TRUE(lst.is_empty());
+  for (auto &obj: objs)
+    lst.append(obj);
+  objs_it = objs.begin();
+  for (auto &obj: lst) {
+    EXPECT_EQ(&obj, &*objs_it++);
+  }
+}
+
+TEST(IntrusiveDblLnkListAssertions, PositionalInsertAndDelete) {
+  std::vector<hooked_elm> objs(10);
+  hooked_elm item{};
+  intrusive_dbl_lnk_lst<hooked_elm, &hooked_elm::hook> lst{};  // <<=== intrusive-dbl-lnk-list
+  for (auto &obj: objs)
+    lst.append(obj);
+  lst.insert_at(item, objs[4]);
+  auto it = lst.begin();
+  for (int i = 0; i < 4; i++)
+    ++it;
+  EXPECT_EQ(&*it++, &item);
+  EXPECT_EQ(&*it, &objs[4]);
+  EXPECT_TRUE(lst.delete_at(item));
+  EXPECT_FALSE(lst.delete_at(item));
+  lst.append_at(item, objs[4]);
+  auto rit = lst.rbegin();
+  for (int i = 0; i < 5; i++)
+    ++rit;
+  EXPECT_EQ(&*rit++, &item);
+  EXPECT_EQ(&*rit, &objs[4]);
+  EXPECT_EQ(lst.size(), 11);
+}
+
+TEST(IntrusiveDblLnkListAssertions, UnlinkByAddressInTwoLists) {
+  std::vector<hooked_elm> objs(ITEM_NBR);
+  intrusive_dbl_lnk_lst<hooked_elm, &hooked_elm::hook> lst{};          // <<=== intrusive-dbl-lnk-list
+  intrusive_dbl_lnk_lst<hooked_elm, &hooked_elm::oth_hook> oth_lst{};  // <<=== intrusive-dbl-lnk-list
+  for (auto &obj: objs) {
+    lst.append(obj);
+    oth_lst.insert(obj);
+  }
+  for (size_t i = 0; i < objs.size(); i += 2)
+    lst.unlink(objs[i]);
+  for (size_t i = 1; i < objs.size(); i += 2)
+    oth_lst.unlink(objs[i]);
+  EXPECT_EQ(lst.size(), ITEM_NBR / 2);
+  EXPECT_EQ(oth_lst.size(), ITEM_NBR / 2);
+  size_t i = 1;
+  for (auto &obj: lst) {
+    EXPECT_EQ(&obj, &objs[i]);
+    i += 2;
+  }
+  i = 0;
+  for (auto it = oth_lst.rbegin(); it != oth_lst.rend(); ++it) {
+    EXPECT_EQ(&*it, &objs[i]);
+    i += 2;
+  }
+  lst.unlink(objs[1]);
+  lst.unlink(objs[ITEM_NBR - 1]);
+  EXPECT_EQ(&*lst.begin(), &objs[3]);
+  EXPECT_EQ(&*lst.rbegin(), &objs[ITEM_NBR - 3]);
+}
+
+TEST(IntrusiveDblLnkListAssertions, BidirectionalIterators) {
+  using lst_t = intrusive_dbl_lnk_lst<hooked_elm, &hooked_elm::hook>;
+  static_assert(std::bidirectional_iterator<lst_t::iterator>);
+  static_assert(std::bidirectional_iterator<lst_t::const_reverse_iterator>);
+  static_assert(std::ranges::bidirectional_range<lst_t>);
+  std::vector<hooked_elm> objs(10);
+  lst_t lst{};  // <<=== intrusive-dbl-lnk-list
+  for (auto &obj: objs)
+    lst.append(obj);
+  const auto &c_lst = lst;
+  EXPECT_EQ(&*std::prev(c_lst.end()), &objs.back());
+  EXPECT_EQ(&*std::prev(c_lst.rend()), &objs.front());
+  EXPECT_EQ(std::ranges::distance(c_lst), 10);
+  auto it = std::ranges::find(lst, objs[4]);
+  EXPECT_EQ(&*it, &objs[4]);
+  EXPECT_EQ(&*--it, &objs[3]);
+  std::vector<const hooked_elm*> rev{};
+  for (const auto &obj: lst | std::views::reverse)
+    rev.push_back(&obj);
+  EXPECT_EQ(rev.front(), &objs.back());
+  EXPECT_EQ(rev.back(), &objs.front());
+}
+
+/**
+ * An object that is not standard layout - polymorphic, with a base class of its own ahead of
+ * the hooks (the hook's offset within it is of no concern to the list).
+ */
+struct elm_base {
+  virtual ~elm_base() = default;
+  int val{0};
+};
+struct derived_hooked_elm : elm_base, hooked_elm {
+  lst_hook derived_hook{};
+  using hooked_elm::operator==;
+};
+
+TEST(IntrusiveDblLnkListAssertions, NonStandardLayoutObjects) {
+  static_assert(not std::is_standard_layout_v<derived_hooked_elm>);
+  std::vector<derived_hooked_elm> objs(10);
+  intrusive_dbl_lnk_lst<derived_hooked_elm, &derived_hooked_elm::derived_hook> lst{};  // <<=== intrusive-dbl-lnk-list
+  for (auto &obj: objs)
+    lst.insert(obj);
+  auto objs_it = objs.rbegin();
+  for (auto &obj: lst) {
+    EXPECT_EQ(&obj, &*objs_it++);
+  }
+  EXPECT_TRUE(lst.delete_at(objs[5]));
+  lst.append_at(objs[5], objs[0]);
+  EXPECT_EQ(&*lst.rbegin(), &objs[5]);
+  EXPECT_EQ(&*std::ranges::find(lst, objs[7]), &objs[7]);
+}
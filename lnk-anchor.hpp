@@ -0,0 +1,154 @@
+//
+// Created by rogerv on 5/18/24.
+//
+#ifndef LNK_ANCHOR_HPP
+#define LNK_ANCHOR_HPP
+
+#include <cassert>
+
+namespace cust_coll {
+
+  /**
+   * The head/tail anchor of a doubly-linked chain of nodes, along with the linking logic - is
+   * shared by the list containers (dbl_lnk_lst owns its nodes, intrusive_dbl_lnk_lst links nodes
+   * owned by the caller). Comments speak of a link taking ownership in the dbl_lnk_lst sense.
+   *
+   * None of these functions allocate or free memory.
+   *
+   * @tparam N node type - has plain pointer members prev and next
+   */
+  template <typename N>
+  class lnk_anchor {
+  protected:
+    N *head{nullptr};
+    N *tail{nullptr};
+    void insert_at_head(N *node) noexcept;
+    void append_at_tail(N *node) noexcept;
+    void link_before(N *pos_node, N *node) noexcept;
+    void link_after(N *pos_node, N *node) noexcept;
+    void unlink(N *node) noexcept;
+    void link_chain_before(N *pos_node, N *first, N *last) noexcept;
+    void unlink_chain(N *first, N *last) noexcept;
+  };
+
+  template <typename N>
+  inline void lnk_anchor<N>::insert_at_head(N *const node) noexcept {
+    node->prev = nullptr;
+    if (head != nullptr) {
+      head->prev = node;
+      node->next = head; // new node taking ownership of prior head node
+      head = node;       // head taking ownership of the new node
+    } else {
+      head = node;       // head taking ownership of the new node
+      tail = head;       // tail set to point at the last node
+    }
+  }
+
+  template <typename N>
+  inline void lnk_anchor<N>::append_at_tail(N *const node) noexcept {
+    if (tail != nullptr) {
+      node->prev = tail;
+      node->next = nullptr;
+      assert(tail->next == nullptr); // (we trust but verify)
+      tail->next = node; // taking ownership of the new node
+      tail = node; // newly appended node is now the tail node
+    } else {
+      insert_at_head(node);
+    }
+  }
+
+  /**
+   * Links node into the list in front of pos_node (which must be a node of this list).
+   */
+  template <typename N>
+  inline void lnk_anchor<N>::link_before(N *const pos_node, N *const node) noexcept {
+    if (auto *const prev_node = pos_node->prev; prev_node != nullptr) {
+      node->next = pos_node; // takes ownership of the pos node
+      node->prev = prev_node;
+      pos_node->prev = node;
+      prev_node->next = node; // prev_node takes ownership of the newly inserted node
+    } else {   // means pos_node is the head node
+      assert(pos_node == head); // (we trust but verify)
+      insert_at_head(node);
+    }
+  }
+
+  /**
+   * Links node into the list right after pos_node (which must be a node of this list).
+   */
+  template <typename N>
+  inline void lnk_anchor<N>::link_after(N *const pos_node, N *const node) noexcept {
+    if (auto *const next_node = pos_node->next; next_node != nullptr) {
+      node->next = next_node; // new node takes ownership of next node
+      node->prev = pos_node;
+      next_node->prev = node;
+      pos_node->next = node; // pos_node takes ownership of the newly inserted node
+    } else { // means pos_node is the tail node
+      assert(pos_node == tail); // (we trust but verify)
+      append_at_tail(node);
+    }
+  }
+
+  /**
+   * Unlinks node from the list - the caller becomes responsible for freeing it.
+   */
+  template <typename N>
+  inline void lnk_anchor<N>::unlink(N *const node) noexcept {
+    auto *const next_node = node->next;
+    auto *const prev_node = node->prev;
+    if (prev_node != nullptr) {
+      prev_node->next = next_node; // transfer ownership
+    } else {   // means node is the head node
+      assert(node == head); // (we trust but verify)
+      head = next_node; // transfer ownership
+    }
+    if (next_node != nullptr) {
+      next_node->prev = prev_node;
+    } else {   // means node is the tail node
+      assert(node == tail); // (we trust but verify)
+      tail = prev_node;
+    }
+    node->prev = node->next = nullptr;
+  }
+
+  /**
+   * Links the chain of nodes first..last (inclusive, already linked to each other) into the list
+   * in front of pos_node - or at tail of list when pos_node is null.
+   */
+  template <typename N>
+  void lnk_anchor<N>::link_chain_before(N *const pos_node, N *const first, N *const last) noexcept {
+    auto *const prev_node = pos_node != nullptr ? pos_node->prev : tail;
+    first->prev = prev_node;
+    last->next = pos_node; // chain's last node takes ownership of pos_node
+    if (prev_node != nullptr)
+      prev_node->next = first; // prev_node takes ownership of the chain
+    else
+      head = first;
+    if (pos_node != nullptr)
+      pos_node->prev = last;
+    else
+      tail = last;
+  }
+
+  /**
+   * Unlinks the chain of nodes first..last (inclusive) from the list - the chain's nodes remain
+   * linked to each other and the caller becomes responsible for them.
+   */
+  template <typename N>
+  void lnk_anchor<N>::unlink_chain(N *const first, N *const last) noexcept {
+    auto *const prev_node = first->prev;
+    auto *const next_node = last->next;
+    if (prev_node != nullptr)
+      prev_node->next = next_node; // transfer ownership
+    else
+      head = next_node;
+    if (next_node != nullptr)
+      next_node->prev = prev_node;
+    else
+      tail = prev_node;
+    first->prev = last->next = nullptr;
+  }
+
+} // cust_coll
+
+#endif //LNK_ANCHOR_HPP
@@ -0,0 +1,282 @@
+//
+// Created by rogerv on 5/26/24.
+//
+#ifndef LRU_CACHE_HPP
+#define LRU_CACHE_HPP
+
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <concepts>
+#include <functional>
+#include <unordered_map>
+#include "lnk-anchor.hpp"
+
+namespace cust_coll {
+
+  /**
+   * List node of lru_cache - owns its key/value entry, along with the number of bytes the entry
+   * is charged against the cache's byte capacity.
+   */
+  template <typename K, typename V>
+  struct lru_node {
+    std::pair<const K, V> entry;
+    size_t nbr_bytes{0};
+    lru_node<K, V> *prev{nullptr};  // non-owning plain pointer
+    lru_node<K, V> *next{nullptr};  // owning plain pointer (freed via the cache's node allocator)
+    template <typename KK, typename VV>
+    lru_node(KK &&key, VV &&value) : entry{std::forward<KK>(key), std::forward<VV>(value)} {}
+  };
+
+  /**
+   * Default entry sizing of lru_cache - every entry is charged its node's size.
+   */
+  struct lru_node_size {
+    template <typename K, typename V>
+    size_t operator()(const K&, const V&) const noexcept { return sizeof(lru_node<K, V>); }
+  };
+
+  /**
+   * Capacity of an lru_cache - once either limit is exceeded, least recently used entries are
+   * evicted until both are met again.
+   */
+  struct lru_capacity {
+    size_t max_entries{SIZE_MAX};
+    size_t max_bytes{SIZE_MAX};  // (as charged by the cache's EntrySize)
+  };
+
+  /**
+   * A least-recently-used cache - a doubly-linked list of entries ordered from most recently
+   * used (head) to least recently used (tail), plus a hashed index from key to list node:
+   *
+   * - get() finds the entry via the index, O(1) average, and relinks its node to head of list in
+   *   place - nothing is freed or allocated
+   * - put() of a new key links a new node at head of list, then evicts from tail of list while
+   *   over capacity, O(1) per entry evicted
+   *
+   * The evicted callback (when set) is handed each entry that is evicted for capacity's sake, just
+   * before it is destroyed.
+   *
+   * @tparam K key type
+   * @tparam V value type
+   * @tparam Hash hash function object for K
+   * @tparam KeyEqual equality function object for K (consistent with Hash)
+   * @tparam EntrySize function object (const K&, const V&) -> size_t giving the bytes charged per
+   *                   entry against lru_capacity::max_bytes (lru_node_size by default)
+   * @tparam Alloc allocator type - is rebound to allocate the list nodes and the index entries
+   */
+  template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+            typename EntrySize = lru_node_size, typename Alloc = std::allocator<std::pair<const K, V>>>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  class lru_cache : protected lnk_anchor<lru_node<K, V>> {
+  protected:
+    using node_t = lru_node<K, V>;
+    using anchor = lnk_anchor<node_t>;
+    using node_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<node_t>;
+    using node_alloc_traits = std::allocator_traits<node_alloc_t>;
+    using key_t = std::reference_wrapper<const K>; // refers to the key held by the node
+    struct key_hash {
+      [[no_unique_address]] Hash hash{};
+      size_t operator()(const key_t &k) const noexcept { return hash(k.get()); }
+    };
+    struct key_equal {
+      [[no_unique_address]] KeyEqual equal{};
+      bool operator()(const key_t &a, const key_t &b) const noexcept { return equal(a.get(), b.get()); }
+    };
+    using index_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<std::pair<const key_t, node_t*>>;
+    using index_t = std::unordered_map<key_t, node_t*, key_hash, key_equal, index_alloc_t>;
+    using anchor::head;  // owning plain pointer (most recently used)
+    using anchor::tail;  // non-owning plain pointer (least recently used)
+    using anchor::insert_at_head;
+    using anchor::unlink;
+    [[no_unique_address]] node_alloc_t node_alloc{};
+    [[no_unique_address]] EntrySize entry_size{};
+    index_t index;
+    lru_capacity cap;
+    size_t nbr_bytes{0};
+    std::function<void(const K&, V&)> evicted{};
+    void free_node(node_t *node) noexcept;
+    void evict_over_capacity() noexcept;
+    void touch(node_t *node) noexcept;
+    template <typename KK, typename VV> bool put_entry(KK &&key, VV &&value) noexcept;
+  public:
+    explicit lru_cache(size_t max_entries) noexcept : lru_cache(lru_capacity{max_entries, SIZE_MAX}) {}
+    explicit lru_cache(lru_capacity capacity, const Alloc &alloc = Alloc{}) noexcept
+      : node_alloc{alloc}, index{index_alloc_t{alloc}}, cap{capacity} {}
+    lru_cache(const lru_cache&) = delete;
+    lru_cache& operator=(const lru_cache&) = delete;
+    ~lru_cache() noexcept { clear(); }
+    size_t size() const noexcept { return index.size(); }
+    bool is_empty() const noexcept { return index.empty(); }
+    size_t bytes() const noexcept { return nbr_bytes; }
+    lru_capacity capacity() const noexcept { return cap; }
+    void set_capacity(lru_capacity capacity) noexcept { cap = capacity; evict_over_capacity(); }
+    void on_evicted(std::function<void(const K&, V&)> f) noexcept { evicted = std::move(f); }
+    V* get(const K& key) noexcept;
+    const V* peek(const K& key) const noexcept;
+    bool contains(const K& key) const noexcept { return index.contains(std::cref(key)); }
+    bool put(const K& key, const V& value) noexcept { return put_entry(key, value); }
+    bool put(const K& key, V &&value) noexcept { return put_entry(key, std::move(value)); }
+    bool put(K &&key, V &&value) noexcept { return put_entry(std::move(key), std::move(value)); }
+    bool erase(const K& key) noexcept;
+    void clear() noexcept;
+    template <typename F> void for_each(F &&f) const;
+  };
+
+  template <typename K, typename V, typename Hash, typename KeyEqual, typename EntrySize, typename Alloc>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  inline void lru_cache<K, V, Hash, KeyEqual, EntrySize, Alloc>::free_node(node_t *const node) noexcept {
+    nbr_bytes -= node->nbr_bytes;
+    node_alloc_traits::destroy(node_alloc, node);
+    node_alloc_traits::deallocate(node_alloc, node, 1);
+  }
+
+  /**
+   * Relinks node to head of list (it becomes the most recently used entry) - O(1), no allocation.
+   */
+  template <typename K, typename V, typename Hash, typename KeyEqual, typename EntrySize, typename Alloc>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  inline void lru_cache<K, V, Hash, KeyEqual, EntrySize, Alloc>::touch(node_t *const node) noexcept {
+    if (node != head) {
+      unlink(node);
+      insert_at_head(node);
+    }
+  }
+
+  /**
+   * Evicts least recently used entries from tail of list until within capacity - except for the
+   * most recently used entry, which always stays.
+   */
+  template <typename K, typename V, typename Hash, typename KeyEqual, typename EntrySize, typename Alloc>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  void lru_cache<K, V, Hash, KeyEqual, EntrySize, Alloc>::evict_over_capacity() noexcept {
+    while (tail != head && (index.size() > cap.max_entries || nbr_bytes > cap.max_bytes)) {
+      auto *const node = tail;
+      unlink(node);
+      index.erase(std::cref(node->entry.first));
+      if (evicted)
+        evicted(node->entry.first, node->entry.second);
+      free_node(node);
+    }
+  }
+
+  /**
+   * Looks up the entry of key; if found then it becomes the most recently used entry.
+   * @return pointer to the entry's value, or null when key isn't cached
+   */
+  template <typename K, typename V, typename Hash, typename KeyEqual, typename EntrySize, typename Alloc>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  V* lru_cache<K, V, Hash, KeyEqual, EntrySize, Alloc>::get(const K& key) noexcept {
+    const auto it = index.find(std::cref(key));
+    if (it == index.end())
+      return nullptr;
+    touch(it->second);
+    return &it->second->entry.second;
+  }
+
+  /**
+   * Same as get() but leaves the entry's recency as it is.
+   */
+  template <typename K, typename V, typename Hash, typename KeyEqual, typename EntrySize, typename Alloc>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  const V* lru_cache<K, V, Hash, KeyEqual, EntrySize, Alloc>::peek(const K& key) const noexcept {
+    const auto it = index.find(std::cref(key));
+    return it != index.end() ? &it->second->entry.second : nullptr;
+  }
+
+  /**
+   * Sets value as the entry of key, which becomes the most recently used entry - a new entry is
+   * linked in at head of list, then least recently used entries are evicted while over capacity.
+   * @return returns false when fails to allocate memory for a new entry
+   */
+  template <typename K, typename V, typename Hash, typename KeyEqual, typename EntrySize, typename Alloc>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  template <typename KK, typename VV>
+  bool lru_cache<K, V, Hash, KeyEqual, EntrySize, Alloc>::put_entry(KK &&key, VV &&value) noexcept {
+    if (const auto it = index.find(std::cref(key)); it != index.end()) {
+      auto *const node = it->second;
+      node->entry.second = std::forward<VV>(value);
+      nbr_bytes -= node->nbr_bytes;
+      node->nbr_bytes = entry_size(node->entry.first, node->entry.second);
+      nbr_bytes += node->nbr_bytes;
+      touch(node);
+      evict_over_capacity();
+      return true;
+    }
+    node_t *node;
+    try {
+      node = node_alloc_traits::allocate(node_alloc, 1);
+    } catch (...) {
+      return false;
+    }
+    node_alloc_traits::construct(node_alloc, node, std::forward<KK>(key), std::forward<VV>(value));
+    try {
+      index.emplace(std::cref(node->entry.first), node);
+    } catch (...) {
+      free_node(node);
+      return false;
+    }
+    node->nbr_bytes = entry_size(node->entry.first, node->entry.second);
+    nbr_bytes += node->nbr_bytes;
+    insert_at_head(node);
+    evict_over_capacity();
+    return true;
+  }
+
+  /**
+   * Removes the entry of key (the evicted callback isn't invoked).
+   * @return returns true if key was cached
+   */
+  template <typename K, typename V, typename Hash, typename KeyEqual, typename EntrySize, typename Alloc>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  bool lru_cache<K, V, Hash, KeyEqual, EntrySize, Alloc>::erase(const K& key) noexcept {
+    const auto it = index.find(std::cref(key));
+    if (it == index.end())
+      return false;
+    auto *const node = it->second;
+    index.erase(it);
+    unlink(node);
+    free_node(node);
+    return true;
+  }
+
+  /**
+   * Removes all entries (the evicted callback isn't invoked).
+   */
+  template <typename K, typename V, typename Hash, typename KeyEqual, typename EntrySize, typename Alloc>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  void lru_cache<K, V, Hash, KeyEqual, EntrySize, Alloc>::clear() noexcept {
+    index.clear();
+    for (auto *node = head; node != nullptr;) {
+      auto *const next_node = node->next;
+      free_node(node);
+      node = next_node;
+    }
+    head = tail = nullptr;
+  }
+
+  /**
+   * Visits every entry, from most recently used to least recently used, as (key, value) - recency
+   * is left as it is.
+   */
+  template <typename K, typename V, typename Hash, typename KeyEqual, typename EntrySize, typename Alloc>
+    requires std::is_invocable_r_v<size_t, const Hash&, const K&> &&
+             std::is_invocable_r_v<size_t, const EntrySize&, const K&, const V&>
+  template <typename F>
+  void lru_cache<K, V, Hash, KeyEqual, EntrySize, Alloc>::for_each(F &&f) const {
+    for (const auto *node = head; node != nullptr; node = node->next)
+      f(node->entry.first, node->entry.second);
+  }
+
+} // cust_coll
+
+#endif //LRU_CACHE_HPP
@@ -0,0 +1,81 @@
+//
+// Created by rogerv on 5/26/24.
+//
+// Benchmarks of lru_cache against the hand-rolled LRU pattern on dbl_lnk_lst (a hit is
+// delete_at() + insert() of the key - an O(n) scan, a free and an allocation), e.g.:
+//
+//   lru-cache_bench --benchmark_out=bench.json --benchmark_out_format=json
+//
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+#include "dbl-lnk-lst.hpp"
+#include "lru-cache.hpp"
+using cust_coll::dbl_lnk_lst;
+using cust_coll::lru_cache;
+
+/**
+ * LRU cache the naive way - recency is kept by a dbl_lnk_lst of keys (most recently used at
+ * head), values by a hash map.
+ */
+class naive_lru_cache {
+  const size_t capacity;
+  dbl_lnk_lst<int> recency{};
+  std::unordered_map<int, int64_t> values{};
+public:
+  explicit naive_lru_cache(size_t capacity) : capacity{capacity} {}
+  int64_t* get(const int key) {
+    const auto it = values.find(key);
+    if (it == values.end())
+      return nullptr;
+    recency.delete_at(key);
+    recency.insert(key);
+    return &it->second;
+  }
+  bool put(const int key, const int64_t value) {
+    if (const auto it = values.find(key); it != values.end()) {
+      it->second = value;
+      recency.delete_at(key);
+    } else if (values.size() == capacity) {
+      const int lru_key = *--recency.end();
+      recency.erase(--recency.end());
+      values.erase(lru_key);
+    }
+    values[key] = value;
+    return recency.insert(key);
+  }
+};
+
+/**
+ * range(0) is the cache capacity in entries. Keys are drawn uniformly from 1.25 * capacity
+ * distinct keys (so ~80% of gets hit); a miss is followed by a put of that key.
+ */
+template <typename C>
+static void BM_get_or_put(benchmark::State &state) {
+  const auto capacity = static_cast<int>(state.range(0));
+  C cache{static_cast<size_t>(capacity)};
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> key_dist{0, capacity + capacity / 4 - 1};
+  std::vector<int> keys(1 << 16);
+  for (auto &key : keys)
+    key = key_dist(gen);
+  for (const auto key : keys)
+    if (cache.get(key) == nullptr)
+      cache.put(key, key);
+  size_t i = 0;
+  for (auto _ : state) {
+    const int key = keys[i++ & (keys.size() - 1)];
+    if (auto *const val = cache.get(key); val != nullptr)
+      benchmark::DoNotOptimize(*val);
+    else
+      cache.put(key, key);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_get_or_put, lru_cache<int, int64_t>)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK_TEMPLATE(BM_get_or_put, naive_lru_cache)->RangeMultiplier(10)->Range(100, 100'000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,137 @@
+//
+// Created by rogerv on 5/26/24.
+//
+#include <list>
+#include <string>
+#include <vector>
+#include <random>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "lru-cache.hpp"
+using cust_coll::lru_cache;
+using cust_coll::lru_capacity;
+
+static constexpr auto ITEM_NBR = 10000;
+
+template <typename K, typename V>
+static std::vector<K> keys_of(const lru_cache<K, V> &cache) {
+  std::vector<K> keys{};
+  cache.for_each([&keys](const K &key, const V&) { keys.push_back(key); });
+  return keys;
+}
+
+TEST(LruCacheAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  lru_cache<int, some_elm> cache{10};  // <<=== lru-cache
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_TRUE(cache.is_empty());
+  EXPECT_EQ(cache.bytes(), 0);
+  EXPECT_EQ(cache.get(1), nullptr);
+  EXPECT_FALSE(cache.erase(1));
+}
+
+TEST(LruCacheAssertions, GetMovesToFrontPutEvictsFromTail) {
+  lru_cache<int, std::string> cache{3};  // <<=== lru-cache
+  std::vector<std::pair<int, std::string>> evictions{};
+  cache.on_evicted([&evictions](const int &key, std::string &value) {
+    evictions.emplace_back(key, std::move(value));
+  });
+  EXPECT_TRUE(cache.put(1, "one"));
+  EXPECT_TRUE(cache.put(2, "two"));
+  EXPECT_TRUE(cache.put(3, "three"));
+  EXPECT_EQ(keys_of(cache), (std::vector<int>{3, 2, 1}));
+  const auto *const one = cache.get(1);
+  ASSERT_NE(one, nullptr);
+  EXPECT_EQ(*one, "one");
+  EXPECT_EQ(keys_of(cache), (std::vector<int>{1, 3, 2}));
+  EXPECT_EQ(cache.get(1), one);  // (relinked in place - same node)
+  EXPECT_EQ(*cache.peek(2), "two");
+  EXPECT_EQ(keys_of(cache), (std::vector<int>{1, 3, 2}));  // (peek leaves recency as it is)
+
+  EXPECT_TRUE(cache.put(4, "four"));
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_FALSE(cache.contains(2));
+  ASSERT_EQ(evictions.size(), 1);
+  EXPECT_EQ(evictions[0], (std::pair<int, std::string>{2, "two"}));
+  EXPECT_TRUE(cache.put(3, "THREE"));  // (existing key - value replaced, nothing evicted)
+  EXPECT_EQ(evictions.size(), 1);
+  EXPECT_EQ(keys_of(cache), (std::vector<int>{3, 4, 1}));
+  EXPECT_EQ(*cache.get(3), "THREE");
+
+  EXPECT_TRUE(cache.erase(4));
+  EXPECT_EQ(keys_of(cache), (std::vector<int>{3, 1}));
+  cache.set_capacity(lru_capacity{1});
+  EXPECT_EQ(keys_of(cache), (std::vector<int>{3}));
+  EXPECT_EQ(evictions.back().first, 1);
+  cache.clear();
+  EXPECT_TRUE(cache.is_empty());
+  EXPECT_EQ(evictions.size(), 2);  // (clear doesn't evict)
+}
+
+/**
+ * Charges each entry its string's length.
+ */
+struct str_len_size {
+  size_t operator()(const int&, const std::string &s) const noexcept { return s.size(); }
+};
+
+TEST(LruCacheAssertions, ByteCapacity) {
+  lru_cache<int, std::string, std::hash<int>, std::equal_to<int>, str_len_size> cache{
+    lru_capacity{.max_bytes = 10}};  // <<=== lru-cache
+  EXPECT_TRUE(cache.put(1, std::string(4, 'a')));
+  EXPECT_TRUE(cache.put(2, std::string(4, 'b')));
+  EXPECT_EQ(cache.bytes(), 8);
+  EXPECT_TRUE(cache.put(3, std::string(4, 'c')));  // 12 bytes > 10 - entry 1 is evicted
+  EXPECT_EQ(cache.bytes(), 8);
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_TRUE(cache.put(2, std::string(1, 'b')));  // (shrinks - re-charged)
+  EXPECT_EQ(cache.bytes(), 5);
+  EXPECT_TRUE(cache.put(4, std::string(20, 'd')));  // larger than capacity - stays, all others go
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.bytes(), 20);
+  EXPECT_TRUE(cache.contains(4));
+}
+
+TEST(LruCacheAssertions, MatchesReferenceModel) {
+  constexpr int capacity = ITEM_NBR / 10;
+  lru_cache<int, int> cache{capacity};  // <<=== lru-cache
+  std::list<std::pair<int, int>> model{};  // most recently used first
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> key_dist{0, capacity * 2}, op_dist{0, 9};
+  for (int i = 0; i < ITEM_NBR * 10; i++) {
+    const int key = key_dist(gen);
+    const auto it = std::ranges::find(model, key, &std::pair<int, int>::first);
+    const int op = op_dist(gen);
+    if (op < 6) {
+      auto *const val = cache.get(key);
+      ASSERT_EQ(val != nullptr, it != model.end());
+      if (it != model.end()) {
+        EXPECT_EQ(*val, it->second);
+        model.splice(model.begin(), model, it);
+      }
+    } else if (op < 9) {
+      EXPECT_TRUE(cache.put(key, i));
+      if (it != model.end())
+        model.erase(it);
+      model.emplace_front(key, i);
+      if (model.size() > capacity)
+        model.pop_back();
+    } else {
+      EXPECT_EQ(cache.erase(key), it != model.end());
+      if (it != model.end())
+        model.erase(it);
+    }
+  }
+  ASSERT_EQ(cache.size(), model.size());
+  auto it = model.begin();
+  cache.for_each([&it](const int &key, const int &val) {
+    EXPECT_EQ(key, it->first);
+    EXPECT_EQ(val, it->second);
+    ++it;
+  });
+}
@@ -0,0 +1,102 @@
+//
+// Created by rogerv on 5/29/24.
+//
+#ifndef LST_FINGERPRINTS_HPP
+#define LST_FINGERPRINTS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace cust_coll {
+
+  /**
+   * Compares each of the N fingerprints at fps against fp - 32 at a time with AVX2, 16 at a time
+   * with SSE2 (whichever the build targets, e.g., -mavx2 or -march=native for the former), with a
+   * scalar loop for any remainder or when Simd is false.
+   * @return bit i is set if fps[i] == fp
+   */
+  template <size_t N, bool Simd = true> requires (N <= 64)
+  inline uint64_t fingerprint_match_mask(const uint8_t *const fps, const uint8_t fp) noexcept {
+    uint64_t mask = 0;
+    size_t i = 0;
+    if constexpr (Simd) {
+#if defined(__AVX2__)
+      const __m256i needle32 = _mm256_set1_epi8(static_cast<char>(fp));
+      for (; i + 32 <= N; i += 32) {
+        const __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(fps + i)), needle32);
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(eq))) << i;
+      }
+#endif
+#if defined(__SSE2__)
+      const __m128i needle16 = _mm_set1_epi8(static_cast<char>(fp));
+      for (; i + 16 <= N; i += 16) {
+        const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(fps + i)), needle16);
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(eq))) << i;
+      }
+#endif
+    }
+    for (; i < N; i++)
+      mask |= static_cast<uint64_t>(fps[i] == fp) << i;
+    return mask;
+  }
+
+  /**
+   * Search policy of unrolled_lnk_lst (the default) - no fingerprints are kept, a search calls
+   * T::operator== on every element.
+   */
+  struct no_fingerprints {
+    static constexpr bool enabled = false;
+    template <typename T> static uint8_t of(const T&) noexcept { return 0; }
+    template <size_t N> struct block {
+      void insert(size_t, size_t, uint8_t) noexcept {}
+      void erase(size_t, size_t) noexcept {}
+      void move_tail_to(size_t, size_t, block&, size_t) noexcept {}
+    };
+  };
+
+  /**
+   * Search policy of unrolled_lnk_lst - each node keeps a contiguous array of one byte fingerprints
+   * (the top byte of the mixed Hash of each of its elements), which a search compares against the
+   * fingerprint of the value sought, N at a time (see fingerprint_match_mask()), calling
+   * T::operator== only on the elements whose fingerprint matches.
+   * @tparam Hash hash function object for T (consistent with T::operator==)
+   */
+  template <typename Hash>
+  struct hash_fingerprints {
+    static constexpr bool enabled = true;
+    template <typename T> static uint8_t of(const T &item) noexcept {
+      const auto h = static_cast<uint64_t>(Hash{}(item)) * 0x9E3779B97F4A7C15ull;  // (std::hash is often the identity)
+      return static_cast<uint8_t>(h >> 56);
+    }
+    template <size_t N> struct block {
+      uint8_t fps[N]{};
+      // opens a slot at idx (of nbr fingerprints in use) for fp
+      void insert(const size_t idx, const size_t nbr, const uint8_t fp) noexcept {
+        std::memmove(fps + idx + 1, fps + idx, nbr - idx);
+        fps[idx] = fp;
+      }
+      // closes the slot at idx (of nbr fingerprints in use)
+      void erase(const size_t idx, const size_t nbr) noexcept {
+        std::memmove(fps + idx, fps + idx + 1, nbr - idx - 1);
+      }
+      // copies fingerprints [from, nbr) to the end of the dst_nbr fingerprints in use of dst
+      void move_tail_to(const size_t from, const size_t nbr, block &dst, const size_t dst_nbr) noexcept {
+        std::memcpy(dst.fps + dst_nbr, fps + from, nbr - from);
+      }
+      // bit i is set if fingerprint i (of nbr fingerprints in use) matches fp
+      uint64_t candidates(const size_t nbr, const uint8_t fp) const noexcept {
+        const auto in_use = nbr < 64 ? (uint64_t{1} << nbr) - 1 : ~uint64_t{0};
+        return fingerprint_match_mask<N>(fps, fp) & in_use;
+      }
+    };
+  };
+
+} // cust_coll
+
+#endif //LST_FINGERPRINTS_HPP
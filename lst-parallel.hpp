@@ -0,0 +1,288 @@
+//
+// Created by rogerv on 6/2/24.
+//
+#ifndef LST_PARALLEL_HPP
+#define LST_PARALLEL_HPP
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <ranges>
+#include <optional>
+#include <exception>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+namespace cust_coll {
+
+  /**
+   * A fixed pool of worker threads, each with its own deque of tasks - a worker takes tasks from
+   * the back of its own deque and, when that runs dry, steals from the front of the others'. A
+   * thread that submits a batch of tasks with run() helps work them off until the batch is done.
+   */
+  class work_stealing_pool {
+  protected:
+    struct task {
+      void (*fn)(void *ctx, size_t idx) noexcept;
+      void *ctx;  // non-owning plain pointer (to the batch the task belongs to)
+      size_t idx;
+    };
+    struct alignas(64) task_queue {  // (one cache line per queue lock)
+      std::mutex mtx{};
+      std::deque<task> tasks{};
+    };
+    template <typename F> struct batch {
+      F *f;  // non-owning plain pointer
+      std::atomic<size_t> pending;
+      std::mutex mtx{};
+      std::condition_variable done_cv{};
+      std::exception_ptr error{};  // (first exception thrown by f, guarded by mtx)
+      static void exec(void *ctx, size_t idx) noexcept;
+    };
+    std::vector<std::unique_ptr<task_queue>> queues{};  // one per worker, plus one for the callers of run()
+    std::vector<std::thread> workers{};
+    std::mutex idle_mtx{};
+    std::condition_variable idle_cv{};
+    std::atomic<int64_t> nbr_queued{0};
+    bool stopping{false};  // (guarded by idle_mtx)
+    bool try_pop(size_t self, task &t) noexcept;
+    void worker_loop(size_t self) noexcept;
+  public:
+    explicit work_stealing_pool(size_t nbr_workers = std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+    ~work_stealing_pool() noexcept;
+    // number of worker threads (a caller of run() makes one more)
+    size_t nbr_workers() const noexcept { return workers.size(); }
+    template <typename F> void run(size_t nbr_tasks, F &&f);
+  };
+
+  /**
+   * @return the pool shared by the parallel algorithms below when none is given - one worker per
+   *         hardware thread but one (for the calling thread)
+   */
+  inline work_stealing_pool& default_pool() {
+    static work_stealing_pool pool{};
+    return pool;
+  }
+
+  /**
+   * Starts the workers - should a thread fail to start then the pool makes do with fewer (its
+   * queue is still stolen from).
+   */
+  inline work_stealing_pool::work_stealing_pool(const size_t nbr_workers) {
+    for (size_t i = 0; i <= nbr_workers; i++)
+      queues.push_back(std::make_unique<task_queue>());
+    workers.reserve(nbr_workers);
+    for (size_t i = 0; i < nbr_workers; i++) {
+      try {
+        workers.emplace_back(&work_stealing_pool::worker_loop, this, i);
+      } catch (...) {}
+    }
+  }
+
+  inline work_stealing_pool::~work_stealing_pool() noexcept {
+    {
+      std::scoped_lock lk{idle_mtx};
+      stopping = true;
+    }
+    idle_cv.notify_all();
+    for (auto &thrd: workers)
+      thrd.join();
+  }
+
+  /**
+   * Takes a task from the back of queue self, else steals one from the front of another queue.
+   * @return false when all queues are empty
+   */
+  inline bool work_stealing_pool::try_pop(const size_t self, task &t) noexcept {
+    for (size_t k = 0; k < queues.size(); k++) {
+      auto &q = *queues[(self + k) % queues.size()];
+      std::scoped_lock lk{q.mtx};
+      if (not q.tasks.empty()) {
+        if (k == 0) {
+          t = q.tasks.back();
+          q.tasks.pop_back();
+        } else {
+          t = q.tasks.front();
+          q.tasks.pop_front();
+        }
+        nbr_queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  inline void work_stealing_pool::worker_loop(const size_t self) noexcept {
+    for (;;) {
+      if (task t; try_pop(self, t)) {
+        t.fn(t.ctx, t.idx);
+        continue;
+      }
+      std::unique_lock lk{idle_mtx};
+      idle_cv.wait(lk, [this] { return stopping || nbr_queued.load(std::memory_order_relaxed) > 0; });
+      if (stopping)
+        return;
+    }
+  }
+
+  /**
+   * Runs task idx of a batch - then counts it done, and the run that completes the batch wakes its
+   * submitter. Both happen with the batch lock held: the submitter takes that lock before it
+   * returns, so the batch (on its stack) can't go away before the last run lets go of it.
+   */
+  template <typename F>
+  void work_stealing_pool::batch<F>::exec(void *const ctx, const size_t idx) noexcept {
+    auto *const b = static_cast<batch*>(ctx);
+    std::exception_ptr error{};
+    try {
+      (*b->f)(idx);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    std::scoped_lock lk{b->mtx};
+    if (b->error == nullptr)
+      b->error = std::move(error);
+    if (b->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      b->done_cv.notify_all();
+  }
+
+  /**
+   * Invokes f(i) for each i in [0, nbr_tasks), spread over the workers' queues (f is invoked
+   * concurrently from different threads); the calling thread works off tasks too, returning once
+   * all have completed. Should any f(i) throw, then the first such exception is rethrown (after
+   * all have completed).
+   */
+  template <typename F>
+  void work_stealing_pool::run(const size_t nbr_tasks, F &&f) {
+    batch<std::remove_reference_t<F>> b{&f, nbr_tasks};
+    using batch_t = decltype(b);
+    const size_t self = queues.size() - 1;
+    int64_t nbr_pushed = 0;
+    for (size_t i = 0; i < nbr_tasks; i++) {
+      auto &q = *queues[i % queues.size()];
+      try {
+        std::scoped_lock lk{q.mtx};
+        q.tasks.push_back(task{&batch_t::exec, &b, i});
+        nbr_pushed++;
+      } catch (...) {
+        batch_t::exec(&b, i);  // (run it right here instead)
+      }
+    }
+    {
+      std::scoped_lock lk{idle_mtx};
+      nbr_queued.fetch_add(nbr_pushed, std::memory_order_relaxed);
+    }
+    idle_cv.notify_all();
+    while (b.pending.load(std::memory_order_acquire) != 0) {
+      if (task t; try_pop(self, t)) {
+        t.fn(t.ctx, t.idx);
+      } else {
+        std::unique_lock lk{b.mtx};
+        b.done_cv.wait(lk, [&b] { return b.pending.load(std::memory_order_acquire) == 0; });
+      }
+    }
+    std::scoped_lock lk{b.mtx};  // (waits out the last run still holding it - see batch::exec)
+    if (b.error != nullptr)
+      std::rethrow_exception(b.error);
+  }
+
+  /**
+   * Cuts a range into nbr_segments runs of (as near as can be) equal length, in one walk of it.
+   * @return the nbr_segments + 1 boundaries - the first is begin, the last is end
+   */
+  template <std::ranges::forward_range R>
+  std::vector<std::ranges::iterator_t<R>> split_points(R &rng, const size_t nbr_items, const size_t nbr_segments) {
+    std::vector<std::ranges::iterator_t<R>> bounds{};
+    bounds.reserve(nbr_segments + 1);
+    auto it = std::ranges::begin(rng);
+    bounds.push_back(it);
+    for (size_t i = 0; i < nbr_segments; i++) {
+      it = std::ranges::next(it, static_cast<std::ranges::range_difference_t<R>>(
+             nbr_items / nbr_segments + (i < nbr_items % nbr_segments ? 1 : 0)));
+      bounds.push_back(it);
+    }
+    return bounds;
+  }
+
+  /**
+   * @return number of segments to cut nbr_items into - about four per thread (for the stealing
+   *         to even out uneven work), no fewer than min_segment items to a segment
+   */
+  inline size_t nbr_segments_for(const size_t nbr_items, const size_t min_segment, const work_stealing_pool &pool) noexcept {
+    return std::min((pool.nbr_workers() + 1) * 4, nbr_items / std::max<size_t>(min_segment, 1));
+  }
+
+  /**
+   * Invokes f on every item of a list (any sized forward range - dbl_lnk_lst, unrolled_lnk_lst,
+   * std::list ...) in parallel - the list is cut into segments by one walk of it, then the
+   * segments are worked off on a work_stealing_pool. f is invoked concurrently from different
+   * threads, in no particular order, so must be safe to call so. Should f throw then the first
+   * exception is rethrown (once all segments are done - the rest of a segment is skipped).
+   * @param min_segment fewest items worth a task of their own - the lower the cost of f, the
+   *                    higher this should be (a short list is visited on the calling thread)
+   */
+  template <std::ranges::forward_range R, typename F>
+    requires std::ranges::sized_range<R> && std::invocable<F&, std::ranges::range_reference_t<R>>
+  void parallel_for_each(R &&rng, F f, const size_t min_segment = 1, work_stealing_pool &pool = default_pool()) {
+    const auto nbr_items = static_cast<size_t>(std::ranges::size(rng));
+    const size_t nbr_segments = nbr_segments_for(nbr_items, min_segment, pool);
+    if (nbr_segments < 2) {
+      for (auto &&item : rng)
+        std::invoke(f, item);
+      return;
+    }
+    const auto bounds = split_points(rng, nbr_items, nbr_segments);
+    pool.run(nbr_segments, [&bounds, &f](const size_t i) {
+      for (auto it = bounds[i]; it != bounds[i + 1]; ++it)
+        std::invoke(f, *it);
+    });
+  }
+
+  /**
+   * Applies transform to every item of a list (any sized forward range) and folds the results,
+   * with init, by reduce - in parallel, as for parallel_for_each(). Each segment is folded on its
+   * own, then the segment results in list order, so reduce need be associative (not commutative).
+   * transform and reduce are invoked concurrently from different threads.
+   * @return init reduced with the transform of every item (init for an empty list)
+   */
+  template <std::ranges::forward_range R, typename U, typename Reduce, typename Transform>
+    requires std::ranges::sized_range<R> &&
+             std::invocable<Transform&, std::ranges::range_reference_t<R>> &&
+             std::is_invocable_r_v<U, Reduce&, U, std::invoke_result_t<Transform&, std::ranges::range_reference_t<R>>> &&
+             std::is_invocable_r_v<U, Reduce&, U, U>
+  U parallel_transform_reduce(R &&rng, U init, Reduce reduce, Transform transform, const size_t min_segment = 1,
+                              work_stealing_pool &pool = default_pool()) {
+    const auto nbr_items = static_cast<size_t>(std::ranges::size(rng));
+    const size_t nbr_segments = nbr_segments_for(nbr_items, min_segment, pool);
+    if (nbr_segments < 2) {
+      for (auto &&item : rng)
+        init = std::invoke(reduce, std::move(init), std::invoke(transform, item));
+      return init;
+    }
+    const auto bounds = split_points(rng, nbr_items, nbr_segments);
+    std::vector<std::optional<U>> partials(nbr_segments);
+    pool.run(nbr_segments, [&](const size_t i) {
+      auto &acc = partials[i];
+      for (auto it = bounds[i]; it != bounds[i + 1]; ++it) {
+        if (acc.has_value())
+          acc = std::invoke(reduce, std::move(*acc), std::invoke(transform, *it));
+        else
+          acc.emplace(std::invoke(transform, *it));
+      }
+    });
+    for (auto &acc : partials) {
+      if (acc.has_value())
+        init = std::invoke(reduce, std::move(init), std::move(*acc));
+    }
+    return init;
+  }
+
+} // cust_coll
+
+#endif //LST_PARALLEL_HPP
@@ -0,0 +1,118 @@
+//
+// Created by rogerv on 6/2/24.
+//
+#include <list>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <ranges>
+#include <numeric>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "dbl-lnk-lst.hpp"
+#include "lst-parallel.hpp"
+using cust_coll::dbl_lnk_lst;
+using cust_coll::work_stealing_pool;
+
+static constexpr auto ITEM_NBR = 10000;
+static constexpr auto THREAD_NBR = 8;
+
+TEST(LstParallelAssertions, EmptyAndShortLists) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  work_stealing_pool pool{THREAD_NBR};
+  dbl_lnk_lst<some_elm> lst{};  // <<=== dbl-lnk-list
+  int nbr_visited = 0;
+  cust_coll::parallel_for_each(lst, [&nbr_visited](const some_elm&) { nbr_visited++; }, 1, pool);
+  EXPECT_EQ(nbr_visited, 0);
+  const auto total = cust_coll::parallel_transform_reduce(lst, size_t{7}, std::plus<>{},
+                                                          [](const some_elm &elm) { return elm.s.size(); }, 1, pool);
+  EXPECT_EQ(total, 7);
+
+  lst.append(some_elm{});
+  cust_coll::parallel_for_each(lst, [&nbr_visited](const some_elm&) { nbr_visited++; }, 1, pool);
+  EXPECT_EQ(nbr_visited, 1);
+}
+
+TEST(LstParallelAssertions, ForEachVisitsEveryItemOnce) {
+  work_stealing_pool pool{THREAD_NBR};
+  dbl_lnk_lst<int> lst{std::views::iota(0, ITEM_NBR)};  // <<=== dbl-lnk-list
+  std::vector<std::atomic<int>> visits(ITEM_NBR);
+  cust_coll::parallel_for_each(lst, [&visits](int &item) {
+    visits[item]++;
+    item *= 2;  // (items are writable through the list's non-const iterators)
+  }, 1, pool);
+  EXPECT_TRUE(std::ranges::all_of(visits, [](const auto &nbr) { return nbr == 1; }));
+  EXPECT_TRUE(std::ranges::equal(lst, std::views::iota(0, ITEM_NBR) | std::views::transform([](int i) { return i * 2; })));
+
+  // any sized forward range - and min_segment bounds the number of tasks
+  std::list<int> std_lst(lst.begin(), lst.end());
+  std::atomic<int64_t> sum{0};
+  cust_coll::parallel_for_each(std_lst, [&sum](const int item) { sum += item; }, ITEM_NBR / 3, pool);
+  EXPECT_EQ(sum, int64_t{ITEM_NBR} * (ITEM_NBR - 1));
+}
+
+TEST(LstParallelAssertions, TransformReduceMatchesSerial) {
+  work_stealing_pool pool{THREAD_NBR};
+  std::vector<some_elm> strs{ITEM_NBR};
+  const std::list<some_elm> lst(strs.begin(), strs.end());
+  const auto length = [](const some_elm &elm) { return elm.s.size(); };
+  EXPECT_EQ(cust_coll::parallel_transform_reduce(lst, size_t{0}, std::plus<>{}, length, 1, pool),
+            std::transform_reduce(strs.begin(), strs.end(), size_t{0}, std::plus<>{}, length));
+
+  // segment results are combined in list order - a non-commutative reduce gives the serial result
+  dbl_lnk_lst<some_elm> dbl_lst{strs};  // <<=== dbl-lnk-list
+  const auto concat = cust_coll::parallel_transform_reduce(dbl_lst, std::string{">"}, std::plus<>{},
+                                                           [](const some_elm &elm) { return elm.s; }, 1, pool);
+  std::string expected{">"};
+  for (const auto &elm : strs)
+    expected += elm.s;
+  EXPECT_EQ(concat, expected);
+
+  // the calling thread does all the work when the pool has no workers
+  work_stealing_pool no_workers{0};
+  EXPECT_EQ(cust_coll::parallel_transform_reduce(dbl_lst, std::string{">"}, std::plus<>{},
+                                                 [](const some_elm &elm) { return elm.s; }, 1, no_workers), expected);
+}
+
+TEST(LstParallelAssertions, FirstExceptionIsRethrown) {
+  work_stealing_pool pool{THREAD_NBR};
+  dbl_lnk_lst<int> lst{std::views::iota(0, ITEM_NBR)};  // <<=== dbl-lnk-list
+  EXPECT_THROW(cust_coll::parallel_for_each(lst, [](const int item) {
+    if (item == ITEM_NBR / 2)
+      throw std::runtime_error{"bad item"};
+  }, 1, pool), std::runtime_error);
+
+  // the pool is still good for more
+  std::atomic<int> nbr_visited{0};
+  cust_coll::parallel_for_each(lst, [&nbr_visited](const int) { nbr_visited++; }, 1, pool);
+  EXPECT_EQ(nbr_visited, ITEM_NBR);
+
+  // a task may itself run a parallel pass on the same pool
+  std::vector<dbl_lnk_lst<int>> lsts(THREAD_NBR);
+  for (auto &l : lsts)
+    l.append_range(std::views::iota(0, ITEM_NBR / THREAD_NBR));
+  std::atomic<int> nbr_nested{0};
+  cust_coll::parallel_for_each(lsts, [&](dbl_lnk_lst<int> &l) {
+    cust_coll::parallel_for_each(l, [&nbr_nested](const int) { nbr_nested++; }, 1, pool);
+  }, 1, pool);
+  EXPECT_EQ(nbr_nested, (ITEM_NBR / THREAD_NBR) * THREAD_NBR);
+}
+
+TEST(LstParallelAssertions, SmallBatchesBackToBack) {
+  // each batch lives on the stack of run() - the next batch takes up the same stack space right
+  // away, while the workers that completed the last one may still be letting go of it
+  work_stealing_pool pool{THREAD_NBR};
+  int64_t total = 0;
+  for (int i = 0; i < ITEM_NBR; i++) {
+    std::atomic<int> nbr_run{0};
+    pool.run(THREAD_NBR, [&nbr_run](const size_t) { nbr_run++; });
+    ASSERT_EQ(nbr_run, THREAD_NBR);
+    const std::vector<int> items{i, i + 1, i + 2};
+    total += cust_coll::parallel_transform_reduce(items, int64_t{0}, std::plus<>{},
+                                                  [](const int item) { return int64_t{item}; }, 1, pool);
+  }
+  EXPECT_EQ(total, int64_t{3} * ITEM_NBR * (ITEM_NBR - 1) / 2 + int64_t{3} * ITEM_NBR);
+}
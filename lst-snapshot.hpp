@@ -0,0 +1,309 @@
+//
+// Created by rogerv on 5/27/24.
+//
+#ifndef LST_SNAPSHOT_HPP
+#define LST_SNAPSHOT_HPP
+
+#include <new>
+#include <span>
+#include <memory>
+#include <array>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dbl-lnk-lst.hpp"
+
+namespace cust_coll {
+
+  /**
+   * Buffered writer of a snapshot to a file descriptor - bytes are written out in chunks of
+   * chunk_size. Any write error sticks (see good()).
+   */
+  class snapshot_writer {
+  public:
+    static constexpr size_t chunk_size = 64 * 1024;
+  protected:
+    const int fd;
+    size_t used{0};
+    bool ok{true};
+    std::array<std::byte, chunk_size> buf;
+  public:
+    explicit snapshot_writer(int fd) noexcept : fd{fd} {}
+    bool good() const noexcept { return ok; }
+    bool write(const void *data, size_t nbr) noexcept;
+    template <typename U> requires std::is_trivially_copyable_v<U>
+    bool write_value(const U &val) noexcept { return write(&val, sizeof(U)); }
+    bool flush() noexcept;
+  };
+
+  /**
+   * Buffered reader of a snapshot from a file descriptor - bytes are read in chunks of
+   * chunk_size. Reading past end of file, or a read error, sticks (see good()).
+   */
+  class snapshot_reader {
+  public:
+    static constexpr size_t chunk_size = 64 * 1024;
+  protected:
+    const int fd;
+    size_t pos{0};
+    size_t avail{0};
+    bool ok{true};
+    std::array<std::byte, chunk_size> buf;
+  public:
+    explicit snapshot_reader(int fd) noexcept : fd{fd} {}
+    bool good() const noexcept { return ok; }
+    bool read(void *data, size_t nbr) noexcept;
+    template <typename U> requires std::is_trivially_copyable_v<U>
+    bool read_value(U &val) noexcept { return read(&val, sizeof(U)); }
+  };
+
+  /**
+   * Customization point for the snapshot encoding of a not trivially copyable T - specialize
+   * with static member functions:
+   *
+   *     static bool save(snapshot_writer &w, const T &item) noexcept;
+   *     static bool load(snapshot_reader &r, T &item) noexcept;   // (item is default constructed)
+   *
+   * Trivially copyable T needs no specialization - its items are written as raw bytes.
+   */
+  template <typename T>
+  struct snapshot_traits;
+
+  /**
+   * std::string is encoded as its length followed by its characters.
+   */
+  template <>
+  struct snapshot_traits<std::string> {
+    static bool save(snapshot_writer &w, const std::string &item) noexcept {
+      return w.write_value(static_cast<uint64_t>(item.size())) && w.write(item.data(), item.size());
+    }
+    static bool load(snapshot_reader &r, std::string &item) noexcept {
+      uint64_t len;
+      if (not r.read_value(len))
+        return false;
+      try {
+        item.resize(len);
+      } catch (...) {
+        return false;
+      }
+      return r.read(item.data(), len);
+    }
+  };
+
+  template <typename T>
+  concept snapshot_serializable = std::is_trivially_copyable_v<T> || requires(snapshot_writer &w,
+                                                                              snapshot_reader &r,
+                                                                              const T &c_item, T &item) {
+    { snapshot_traits<T>::save(w, c_item) } -> std::same_as<bool>;
+    { snapshot_traits<T>::load(r, item) } -> std::same_as<bool>;
+  };
+
+  /**
+   * Header at start of a snapshot - is padded out to 64 bytes so that the raw items that follow
+   * are aligned when the file is mapped into memory. Integers are in native byte order.
+   */
+  struct snapshot_header {
+    static constexpr std::array<char, 8> snapshot_magic{'D', 'L', 'L', 'S', 'N', 'A', 'P', '\0'};
+    static constexpr uint32_t snapshot_version = 1;
+    static constexpr uint32_t raw_items = 1;  // flag - items are raw bytes (else snapshot_traits encoded)
+    std::array<char, 8> magic{snapshot_magic};
+    uint32_t version{snapshot_version};
+    uint32_t flags{0};
+    uint64_t elm_size{0};
+    uint64_t count{0};
+    std::byte padding[32]{};
+
+    template <typename T> static snapshot_header of(size_t count) noexcept {
+      snapshot_header hdr{};
+      hdr.flags = std::is_trivially_copyable_v<T> ? raw_items : 0;
+      hdr.elm_size = sizeof(T);
+      hdr.count = count;
+      return hdr;
+    }
+    template <typename T> bool is_snapshot_of() const noexcept {
+      const auto expected = of<T>(0);
+      return magic == snapshot_magic && version == snapshot_version && flags == expected.flags &&
+             elm_size == expected.elm_size;
+    }
+  };
+  static_assert(sizeof(snapshot_header) == 64 && std::is_trivially_copyable_v<snapshot_header>);
+
+  inline bool snapshot_writer::write(const void *const data, size_t nbr) noexcept {
+    auto *src = static_cast<const std::byte*>(data);
+    while (ok && nbr > 0) {
+      const auto n = std::min(nbr, chunk_size - used);
+      std::memcpy(buf.data() + used, src, n);
+      used += n;
+      src += n;
+      nbr -= n;
+      if (used == chunk_size)
+        flush();
+    }
+    return ok;
+  }
+
+  /**
+   * Writes out whatever is buffered - retries partial writes and interrupted system calls.
+   */
+  inline bool snapshot_writer::flush() noexcept {
+    for (size_t done = 0; ok && done < used;) {
+      const auto n = ::write(fd, buf.data() + done, used - done);
+      if (n < 0 && errno != EINTR)
+        ok = false;
+      else if (n > 0)
+        done += static_cast<size_t>(n);
+    }
+    used = 0;
+    return ok;
+  }
+
+  inline bool snapshot_reader::read(void *const data, size_t nbr) noexcept {
+    auto *dst = static_cast<std::byte*>(data);
+    while (ok && nbr > 0) {
+      if (pos == avail) {
+        const auto n = ::read(fd, buf.data(), chunk_size);
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n <= 0) {
+          ok = false;
+          break;
+        }
+        pos = 0;
+        avail = static_cast<size_t>(n);
+      }
+      const auto n = std::min(nbr, avail - pos);
+      std::memcpy(dst, buf.data() + pos, n);
+      pos += n;
+      dst += n;
+      nbr -= n;
+    }
+    return ok;
+  }
+
+  /**
+   * Writes a binary snapshot of the items of lst to fd (from its current file offset), streamed
+   * out in chunks - raw bytes for trivially copyable T, else as encoded by snapshot_traits<T>.
+   * @return returns false when fails to write the snapshot
+   */
+  template <snapshot_serializable T, typename Alloc, typename Stats>
+  bool save_snapshot(const dbl_lnk_lst<T, Alloc, Stats> &lst, const int fd) noexcept {
+    const std::unique_ptr<snapshot_writer> w{new (std::nothrow) snapshot_writer{fd}};
+    if (w == nullptr || not w->write_value(snapshot_header::of<T>(lst.size())))
+      return false;
+    for (const auto &item : lst) {
+      bool ok;
+      if constexpr (std::is_trivially_copyable_v<T>)
+        ok = w->write_value(item);
+      else
+        ok = snapshot_traits<T>::save(*w, item);
+      if (not ok)
+        return false;
+    }
+    return w->flush();
+  }
+
+  /**
+   * Makes room up front in a reservable node allocator (see pool_allocator) for nbr nodes, so
+   * restoring a list acquires at most one new slab rather than one per slab's worth of nodes.
+   */
+  template <typename T, typename Alloc>
+  void reserve_snapshot_nodes(const Alloc &alloc, const size_t nbr) noexcept {
+    using node_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<lst_node<T>>;
+    if constexpr (reservable_alloc<node_alloc_t>) {
+      try {
+        node_alloc_t{alloc}.reserve(nbr);
+      } catch (...) {} // (the nodes are then allocated as they come)
+    }
+  }
+
+  /**
+   * Reads a snapshot written by save_snapshot() from fd (from its current file offset) and appends
+   * its items at tail of lst. Items are read in chunks and each chunk is added via append_range()
+   * - allocated and linked to each other off to the side, then linked in as a whole - into a
+   * separate list that is spliced onto lst once the whole snapshot has been read, so lst is left
+   * as it was should the load fail. The header's item count is not trusted for more than the file
+   * could hold: room is made up front only for trivially copyable T read from a regular file, for
+   * no more items than fit its size (otherwise chunk by chunk, as append_range() goes).
+   * @return returns false when the snapshot is not one of T items, is truncated, or fails to
+   *         allocate memory
+   */
+  template <snapshot_serializable T, typename Alloc, typename Stats> requires std::default_initializable<T>
+  bool load_snapshot(dbl_lnk_lst<T, Alloc, Stats> &lst, const int fd) noexcept {
+    const std::unique_ptr<snapshot_reader> r{new (std::nothrow) snapshot_reader{fd}};
+    snapshot_header hdr{};
+    if (r == nullptr || not r->read_value(hdr) || not hdr.is_snapshot_of<T>())
+      return false;
+    constexpr size_t chunk_items = std::max<size_t>(snapshot_reader::chunk_size / sizeof(T), 1);
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (struct stat st{}; ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        const auto nbr_fit = static_cast<uint64_t>(st.st_size) / sizeof(T);
+        reserve_snapshot_nodes<T>(lst.get_allocator(), static_cast<size_t>(std::min(hdr.count, nbr_fit)));
+      }
+    }
+    dbl_lnk_lst<T, Alloc, Stats> loaded{lst.get_allocator()};
+    std::vector<T> chunk{};
+    for (auto remaining = hdr.count; remaining > 0;) {
+      const auto nbr = std::min<uint64_t>(remaining, chunk_items);
+      try {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+          chunk.resize(nbr);
+          if (not r->read(chunk.data(), nbr * sizeof(T)))
+            return false;
+        } else {
+          chunk.clear();
+          for (uint64_t i = 0; i < nbr; i++) {
+            if (not snapshot_traits<T>::load(*r, chunk.emplace_back()))
+              return false;
+          }
+        }
+      } catch (...) {
+        return false;
+      }
+      if (not loaded.append_range(std::move(chunk)))
+        return false;
+      remaining -= nbr;
+    }
+    lst.splice_back(loaded);
+    return true;
+  }
+
+  /**
+   * Same as load_snapshot() for trivially copyable T, but maps the snapshot file into memory (the
+   * snapshot must start at the beginning of the file) and appends all of its items at tail of lst
+   * with a single append_range() - no read buffering, no intermediate copy.
+   * @return returns false when fd can't be mapped, the snapshot is not one of T items, is truncated,
+   *         or fails to allocate memory (lst is then left as it was)
+   */
+  template <typename T, typename Alloc, typename Stats> requires std::is_trivially_copyable_v<T>
+  bool load_snapshot_mmap(dbl_lnk_lst<T, Alloc, Stats> &lst, const int fd) noexcept {
+    static_assert(alignof(T) <= sizeof(snapshot_header));
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(snapshot_header))
+      return false;
+    const auto file_size = static_cast<size_t>(st.st_size);
+    void *const addr = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED)
+      return false;
+    ::madvise(addr, file_size, MADV_SEQUENTIAL);
+    snapshot_header hdr{};
+    std::memcpy(&hdr, addr, sizeof(hdr));
+    bool ok = hdr.is_snapshot_of<T>() && hdr.count <= (file_size - sizeof(hdr)) / sizeof(T);
+    if (ok) {
+      reserve_snapshot_nodes<T>(lst.get_allocator(), hdr.count);
+      const auto *const first = reinterpret_cast<const T*>(static_cast<const std::byte*>(addr) + sizeof(hdr));
+      ok = lst.append_range(std::span<const T>{first, static_cast<size_t>(hdr.count)});
+    }
+    ::munmap(addr, file_size);
+    return ok;
+  }
+
+} // cust_coll
+
+#endif //LST_SNAPSHOT_HPP
@@ -0,0 +1,139 @@
+//
+// Created by rogerv on 5/27/24.
+//
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <ranges>
+#include <algorithm>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "lst-snapshot.hpp"
+using cust_coll::dbl_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+
+/**
+ * some_elm is encoded as its string.
+ */
+template <>
+struct cust_coll::snapshot_traits<some_elm> {
+  static bool save(snapshot_writer &w, const some_elm &item) noexcept {
+    return snapshot_traits<std::string>::save(w, item.s);
+  }
+  static bool load(snapshot_reader &r, some_elm &item) noexcept {
+    return snapshot_traits<std::string>::load(r, item.s);
+  }
+};
+
+/**
+ * A temporary file that is removed upon destruction.
+ */
+struct tmp_file {
+  FILE *const file{std::tmpfile()};
+  ~tmp_file() { std::fclose(file); }
+  int fd() const noexcept { return fileno(file); }
+  void rewind() const noexcept { ::lseek(fd(), 0, SEEK_SET); }
+};
+
+struct pod {
+  int64_t a;
+  double b;
+  bool operator==(const pod&) const = default;
+};
+
+TEST(LstSnapshotAssertions, EmptyListRoundTrip) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  tmp_file tmp{};
+  dbl_lnk_lst<some_elm> lst{};  // <<=== dbl-lnk-list
+  ASSERT_TRUE(cust_coll::save_snapshot(lst, tmp.fd()));
+  tmp.rewind();
+  dbl_lnk_lst<some_elm> loaded{};  // <<=== dbl-lnk-list
+  EXPECT_TRUE(cust_coll::load_snapshot(loaded, tmp.fd()));
+  EXPECT_TRUE(loaded.is_empty());
+}
+
+TEST(LstSnapshotAssertions, TriviallyCopyableRoundTrip) {
+  tmp_file tmp{};
+  const auto items = std::views::iota(0, ITEM_NBR * 10) |
+                     std::views::transform([](int i) { return pod{i, i * 0.5}; });
+  dbl_lnk_lst<pod> lst{items};  // <<=== dbl-lnk-list
+  ASSERT_TRUE(cust_coll::save_snapshot(lst, tmp.fd()));
+  EXPECT_EQ(::lseek(tmp.fd(), 0, SEEK_END), sizeof(cust_coll::snapshot_header) + lst.size() * sizeof(pod));
+
+  tmp.rewind();
+  dbl_lnk_lst<pod> loaded{};  // <<=== dbl-lnk-list
+  loaded.append(pod{-1, -1});
+  EXPECT_TRUE(cust_coll::load_snapshot(loaded, tmp.fd()));  // (appended after existing items)
+  EXPECT_EQ(loaded.size(), lst.size() + 1);
+  EXPECT_TRUE(std::ranges::equal(loaded | std::views::drop(1), lst));
+
+  dbl_lnk_lst<pod, cust_coll::pool_allocator<pod>> mapped{};  // <<=== dbl-lnk-list
+  EXPECT_TRUE(cust_coll::load_snapshot_mmap(mapped, tmp.fd()));
+  EXPECT_TRUE(std::ranges::equal(mapped, lst));
+}
+
+TEST(LstSnapshotAssertions, CustomizedRoundTrip) {
+  tmp_file tmp{};
+  std::vector<some_elm> strs{ITEM_NBR};
+  dbl_lnk_lst<some_elm> lst{strs};  // <<=== dbl-lnk-list
+  ASSERT_TRUE(cust_coll::save_snapshot(lst, tmp.fd()));
+  tmp.rewind();
+  cust_coll::pmr::dbl_lnk_lst<some_elm> loaded{};  // <<=== dbl-lnk-list
+  EXPECT_TRUE(cust_coll::load_snapshot(loaded, tmp.fd()));
+  EXPECT_TRUE(std::ranges::equal(loaded, strs));
+
+  dbl_lnk_lst<std::string> strings{};  // <<=== dbl-lnk-list
+  for (const auto &elm : strs)
+    strings.append(elm.s);
+  tmp_file str_tmp{};
+  ASSERT_TRUE(cust_coll::save_snapshot(strings, str_tmp.fd()));
+  str_tmp.rewind();
+  dbl_lnk_lst<std::string> loaded_strings{};  // <<=== dbl-lnk-list
+  EXPECT_TRUE(cust_coll::load_snapshot(loaded_strings, str_tmp.fd()));
+  EXPECT_TRUE(std::ranges::equal(loaded_strings, strings));
+}
+
+TEST(LstSnapshotAssertions, RejectsMismatchedOrTruncatedSnapshot) {
+  tmp_file tmp{};
+  dbl_lnk_lst<int> lst{std::views::iota(0, ITEM_NBR)};  // <<=== dbl-lnk-list
+  ASSERT_TRUE(cust_coll::save_snapshot(lst, tmp.fd()));
+
+  tmp.rewind();
+  dbl_lnk_lst<int64_t> wrong_type{};  // <<=== dbl-lnk-list
+  EXPECT_FALSE(cust_coll::load_snapshot(wrong_type, tmp.fd()));
+  EXPECT_FALSE(cust_coll::load_snapshot_mmap(wrong_type, tmp.fd()));
+
+  ASSERT_EQ(::ftruncate(tmp.fd(), sizeof(cust_coll::snapshot_header) + ITEM_NBR * sizeof(int) / 2), 0);
+  tmp.rewind();
+  dbl_lnk_lst<int> truncated{std::views::iota(0, 3)};  // <<=== dbl-lnk-list
+  EXPECT_FALSE(cust_coll::load_snapshot(truncated, tmp.fd()));
+  EXPECT_FALSE(cust_coll::load_snapshot_mmap(truncated, tmp.fd()));
+  EXPECT_TRUE(std::ranges::equal(truncated, std::views::iota(0, 3)));  // (left as it was)
+
+  tmp_file empty_tmp{};
+  EXPECT_FALSE(cust_coll::load_snapshot(truncated, empty_tmp.fd()));
+  EXPECT_FALSE(cust_coll::load_snapshot_mmap(truncated, empty_tmp.fd()));
+}
+
+TEST(LstSnapshotAssertions, RejectsCorruptItemCount) {
+  // a header claiming (far) more items than the file holds - or than memory could - makes no
+  // up front allocation on the strength of it
+  dbl_lnk_lst<pod, cust_coll::pool_allocator<pod>> lst{};  // <<=== dbl-lnk-list
+  for (const uint64_t count : {uint64_t{1} << 40, ~uint64_t{0} / 24 + 2, ~uint64_t{0}}) {
+    tmp_file tmp{};
+    const auto hdr = cust_coll::snapshot_header::of<pod>(count);
+    const pod items[3]{{1, 0.5}, {2, 1.0}, {3, 1.5}};
+    ASSERT_EQ(::write(tmp.fd(), &hdr, sizeof(hdr)), sizeof(hdr));
+    ASSERT_EQ(::write(tmp.fd(), items, sizeof(items)), sizeof(items));
+    tmp.rewind();
+    EXPECT_FALSE(cust_coll::load_snapshot(lst, tmp.fd()));
+    EXPECT_FALSE(cust_coll::load_snapshot_mmap(lst, tmp.fd()));
+    EXPECT_TRUE(lst.is_empty());
+    EXPECT_LE(lst.get_allocator().in_use(), 3);
+  }
+  EXPECT_TRUE(lst.append(pod{4, 2.0}));  // (the pool is still good)
+}
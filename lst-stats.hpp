@@ -0,0 +1,89 @@
+//
+// Created by rogerv on 5/25/24.
+//
+#ifndef LST_STATS_HPP
+#define LST_STATS_HPP
+
+#include <bit>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+namespace cust_coll {
+
+  /**
+   * Operations counted by a stats collecting list (see lst_stats_collector).
+   */
+  enum class lst_op : uint8_t {
+    insert, insert_at, append, append_at, delete_at,
+    insert_range, insert_range_at, append_range,
+    insert_before, insert_after, erase, clear,
+    remove_if, remove, delete_many, extract,
+    nbr_ops
+  };
+
+  /**
+   * Snapshot of a list's operation statistics, as returned by dbl_lnk_lst::stats().
+   *
+   * scan_lengths is a histogram of the number of nodes visited by each positional scan (the pos
+   * lookups of insert_at(), append_at(), delete_at() and insert_range_at()) - bucket 0 counts
+   * scans that visited no node (empty list), bucket i counts those that visited [2^(i-1), 2^i)
+   * nodes; the last bucket also takes anything longer.
+   */
+  struct lst_stats {
+    static constexpr size_t nbr_scan_buckets = 32;
+    std::array<uint64_t, static_cast<size_t>(lst_op::nbr_ops)> op_counts{};
+    std::array<uint64_t, nbr_scan_buckets> scan_lengths{};
+    uint64_t nodes_scanned{0};   // total over all positional scans
+    uint64_t pos_hits{0};        // positional scans that matched pos
+    uint64_t pos_misses{0};      // positional scans that fell through to the end of list
+    uint64_t alloc_failures{0};  // node allocations that failed (the false returns)
+    uint64_t nodes_cleared{0};   // total nodes freed by clear()
+    size_t nodes_in_use{0};
+    size_t bytes_in_use{0};      // node memory of the items currently in the list
+
+    uint64_t op_count(const lst_op op) const noexcept { return op_counts[static_cast<size_t>(op)]; }
+    static constexpr size_t scan_bucket(const size_t nbr_visited) noexcept {
+      return std::min<size_t>(std::bit_width(nbr_visited), nbr_scan_buckets - 1);
+    }
+  };
+
+  /**
+   * The default stats policy of dbl_lnk_lst - records nothing; being empty, it takes up no space
+   * in the list and its calls compile away.
+   */
+  struct no_lst_stats {
+    static constexpr bool enabled = false;
+    void on_op(lst_op) noexcept {}
+    void on_scan(size_t, bool) noexcept {}
+    void on_alloc_failure() noexcept {}
+    void on_clear(size_t) noexcept {}
+  };
+
+  /**
+   * Stats policy that counts into an lst_stats, e.g.:
+   *
+   *     cust_coll::dbl_lnk_lst<int, std::allocator<int>, cust_coll::lst_stats_collector> lst{};
+   *     ...
+   *     const auto snapshot = lst.stats();
+   *
+   * Counters are plain integers (same as the list, not thread-safe) - so take the snapshot on
+   * the thread that uses the list.
+   */
+  struct lst_stats_collector {
+    static constexpr bool enabled = true;
+    lst_stats counters{};
+    void on_op(const lst_op op) noexcept { counters.op_counts[static_cast<size_t>(op)]++; }
+    void on_scan(const size_t nbr_visited, const bool hit) noexcept {
+      counters.scan_lengths[lst_stats::scan_bucket(nbr_visited)]++;
+      counters.nodes_scanned += nbr_visited;
+      (hit ? counters.pos_hits : counters.pos_misses)++;
+    }
+    void on_alloc_failure() noexcept { counters.alloc_failures++; }
+    void on_clear(const size_t nbr_nodes) noexcept { counters.nodes_cleared += nbr_nodes; }
+  };
+
+} // cust_coll
+
+#endif //LST_STATS_HPP
@@ -0,0 +1,428 @@
+//
+// Created by rogerv on 5/28/24.
+//
+#ifndef MAPPED_DBL_LNK_LST_HPP
+#define MAPPED_DBL_LNK_LST_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dbl-lnk-lst.hpp"
+
+namespace cust_coll {
+
+  /**
+   * Header at start of the file of a mapped_dbl_lnk_lst - holds all of the list's state, so a list
+   * reopened from its file is ready for use as is. Links are file offsets (0 is null).
+   */
+  struct mapped_lst_header {
+    static constexpr std::array<char, 8> mapped_magic{'D', 'L', 'L', 'M', 'A', 'P', '\0', '\0'};
+    static constexpr uint32_t mapped_version = 1;
+    std::array<char, 8> magic{mapped_magic};
+    uint32_t version{mapped_version};
+    uint32_t elm_size{0};
+    uint64_t head{0};
+    uint64_t tail{0};
+    uint64_t free_head{0};  // first node of the free list (linked via next)
+    uint64_t used{0};       // offset of the region's never used remainder
+    uint64_t count{0};
+    std::byte padding[8]{};
+  };
+  static_assert(sizeof(mapped_lst_header) == 64 && std::is_trivially_copyable_v<mapped_lst_header>);
+
+  /**
+   * A doubly-linked-list whose nodes live in a memory mapped file - nodes link to each other by
+   * file offset instead of by pointer, so the file can be mapped at any address. Opening an existing
+   * file (after a restart, or from another process once this one has closed it) needs no
+   * deserialization: the list is usable as soon as the file is mapped.
+   *
+   * Nodes are allocated from the region following the file's header - freed nodes go onto a free
+   * list, and the file is grown (and remapped) when the region is used up. Iterators refer to their
+   * node by offset, so remain valid when the file grows.
+   *
+   * Has the insert/append/delete_at/iteration API of dbl_lnk_lst, plus open()/close()/sync(). Items
+   * are written into the mapping in place; sync() flushes them to the file. There is no journaling
+   * (a crash in the middle of an update can leave the links inconsistent) nor any inter-process
+   * locking (only one process is to have the file open at a time).
+   *
+   * @tparam T type of element contained by container - must be trivially copyable (is stored in the
+   *           file as is)
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  class mapped_dbl_lnk_lst {
+  protected:
+    struct mapped_node {
+      uint64_t prev;
+      uint64_t next;
+      T value;
+    };
+    static_assert(alignof(mapped_node) <= sizeof(mapped_lst_header));
+    static constexpr uint64_t first_node_off = sizeof(mapped_lst_header);
+    static constexpr size_t min_file_size = 64 * 1024;
+    int fd{-1};
+    std::byte *base{nullptr};  // owning plain pointer to the mapping
+    size_t file_size{0};
+    mapped_lst_header& hdr() const noexcept { return *reinterpret_cast<mapped_lst_header*>(base); }
+    mapped_node& node_at(uint64_t off) const noexcept { return *reinterpret_cast<mapped_node*>(base + off); }
+    bool remap(size_t new_size) noexcept;
+    uint64_t new_node(const T &item) noexcept;
+    void free_node(uint64_t off) noexcept;
+    void insert_at_head(uint64_t off) noexcept;
+    void append_at_tail(uint64_t off) noexcept;
+    void link_before(uint64_t pos_off, uint64_t off) noexcept;
+    void link_after(uint64_t pos_off, uint64_t off) noexcept;
+    void unlink(uint64_t off) noexcept;
+    uint64_t find_first(const T&pos) const noexcept;
+    uint64_t find_last(const T&pos) const noexcept;
+    bool insert_node(const T &item, uint64_t pos_off, bool before) noexcept;
+  public:
+    mapped_dbl_lnk_lst() noexcept = default;
+    mapped_dbl_lnk_lst(const mapped_dbl_lnk_lst&) = delete;
+    mapped_dbl_lnk_lst& operator=(const mapped_dbl_lnk_lst&) = delete;
+    ~mapped_dbl_lnk_lst() noexcept { close(); }
+    bool open(const char *path) noexcept;
+    void close() noexcept;
+    bool sync() const noexcept;
+    bool is_open() const noexcept { return base != nullptr; }
+    size_t file_bytes() const noexcept { return file_size; }
+    size_t size() const noexcept { return is_open() ? hdr().count : 0; }
+    bool is_empty() const noexcept { return size() == 0; }
+    bool insert(const T& item) noexcept { return insert_node(item, is_open() ? hdr().head : 0, true); }
+    bool insert_at(const T& item, const T&pos) noexcept { return insert_node(item, find_first(pos), true); }
+    bool append(const T& item) noexcept { return insert_node(item, 0, true); }
+    bool append_at(const T& item, const T&pos) noexcept { return insert_node(item, find_last(pos), false); }
+    bool delete_at(const T&pos) noexcept;
+    void clear() noexcept;
+
+    /**
+     * Bidirectional iterator - same scheme as dbl_lnk_lst::basic_iterator, but refers to its node
+     * by file offset (so survives growth of the file).
+     */
+    template <bool Reverse, bool Const>
+    class basic_iterator {
+    public:
+      using iterator_concept  = std::bidirectional_iterator_tag;
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type  = T;
+      using pointer     = std::conditional_t<Const, const T*, T*>;
+      using reference   = std::conditional_t<Const, const T&, T&>;
+    protected:
+      uint64_t off{0};                         // 0 at end
+      const mapped_dbl_lnk_lst *lst{nullptr};  // non-owning plain pointer
+      friend class mapped_dbl_lnk_lst;
+      template <bool, bool> friend class basic_iterator;
+      basic_iterator(uint64_t o, const mapped_dbl_lnk_lst *l) noexcept : off{o}, lst{l} {}
+    public:
+      basic_iterator() noexcept = default;
+      // a non-const iterator converts to its const counterpart
+      template <bool C = Const> requires C
+      basic_iterator(const basic_iterator<Reverse, false> &oth) noexcept : off{oth.off}, lst{oth.lst} {}
+      // Prefix increment
+      basic_iterator& operator++() noexcept {
+        off = Reverse ? lst->node_at(off).prev : lst->node_at(off).next;
+        return *this;
+      }
+      // Postfix increment
+      basic_iterator operator++(int) noexcept { basic_iterator tmp = *this; ++(*this); return tmp; }
+      // Prefix decrement (end() decrements to the last item in iteration order)
+      basic_iterator& operator--() noexcept {
+        if (off != 0)
+          off = Reverse ? lst->node_at(off).next : lst->node_at(off).prev;
+        else
+          off = Reverse ? lst->hdr().head : lst->hdr().tail;
+        return *this;
+      }
+      // Postfix decrement
+      basic_iterator operator--(int) noexcept { basic_iterator tmp = *this; --(*this); return tmp; }
+      friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.off == b.off; };
+      reference operator*() const noexcept { return lst->node_at(off).value; }
+      pointer operator->() const noexcept { return &lst->node_at(off).value; }
+    };
+    using iterator = basic_iterator<false, false>;
+    using const_iterator = basic_iterator<false, true>;
+    using reverse_iterator = basic_iterator<true, false>;
+    using const_reverse_iterator = basic_iterator<true, true>;
+    iterator begin() noexcept { return iterator{is_open() ? hdr().head : 0, this}; }
+    iterator end() noexcept { return iterator{0, this}; }
+    const_iterator begin() const noexcept { return const_iterator{is_open() ? hdr().head : 0, this}; }
+    const_iterator end() const noexcept { return const_iterator{0, this}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator{is_open() ? hdr().tail : 0, this}; }
+    reverse_iterator rend() noexcept { return reverse_iterator{0, this}; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{is_open() ? hdr().tail : 0, this}; }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator{0, this}; }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+  };
+
+  /**
+   * Opens (creating if need be) the list file at path and maps it - a new (empty) file is given a
+   * header and an initial node region; an existing file must hold a list of T.
+   * @return returns false when the file can't be opened/mapped or holds something else
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  bool mapped_dbl_lnk_lst<T>::open(const char *const path) noexcept {
+    close();
+    fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+      return false;
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+      close();
+      return false;
+    }
+    const bool is_new = st.st_size == 0;
+    if (is_new) {
+      if (::ftruncate(fd, min_file_size) != 0 || not remap(min_file_size)) {
+        close();
+        return false;
+      }
+      mapped_lst_header init{};
+      init.elm_size = sizeof(T);
+      init.used = first_node_off;
+      std::memcpy(base, &init, sizeof(init));
+      return true;
+    }
+    if (static_cast<size_t>(st.st_size) < sizeof(mapped_lst_header) || not remap(static_cast<size_t>(st.st_size))) {
+      close();
+      return false;
+    }
+    const auto &h = hdr();
+    if (h.magic != mapped_lst_header::mapped_magic || h.version != mapped_lst_header::mapped_version ||
+        h.elm_size != sizeof(T) || h.used > file_size) {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Unmaps and closes the list file - the items remain in the file.
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  void mapped_dbl_lnk_lst<T>::close() noexcept {
+    if (base != nullptr)
+      ::munmap(base, file_size);
+    if (fd >= 0)
+      ::close(fd);
+    base = nullptr;
+    file_size = 0;
+    fd = -1;
+  }
+
+  /**
+   * Flushes the mapping to the file (blocks until written).
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  bool mapped_dbl_lnk_lst<T>::sync() const noexcept {
+    return base != nullptr && ::msync(base, file_size, MS_SYNC) == 0;
+  }
+
+  /**
+   * Maps new_size bytes of the file - the new mapping is made before the old one is unmapped, so
+   * on failure the list stays mapped as it was.
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  bool mapped_dbl_lnk_lst<T>::remap(const size_t new_size) noexcept {
+    void *const addr = ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+      return false;
+    if (base != nullptr)
+      ::munmap(base, file_size);
+    base = static_cast<std::byte*>(addr);
+    file_size = new_size;
+    return true;
+  }
+
+  /**
+   * Takes a node - from the free list if possible, else from the region's never used remainder
+   * (growing the file by doubling when used up) - and copies item into it. item is copied aside
+   * first, as it may be an item of this list (which growing the file unmaps).
+   * @return offset of the new node, 0 when fails to grow the file
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  uint64_t mapped_dbl_lnk_lst<T>::new_node(const T &item) noexcept {
+    if (base == nullptr)
+      return 0;
+    const T item_copy = item;
+    uint64_t off = hdr().free_head;
+    if (off != 0) {
+      hdr().free_head = node_at(off).next;
+    } else {
+      if (hdr().used + sizeof(mapped_node) > file_size) {
+        const auto new_size = std::max(file_size * 2, static_cast<size_t>(hdr().used + sizeof(mapped_node)));
+        if (::ftruncate(fd, static_cast<off_t>(new_size)) != 0 || not remap(new_size))
+          return 0;
+      }
+      off = hdr().used;
+      hdr().used += sizeof(mapped_node);
+    }
+    auto &node = node_at(off);
+    node.prev = node.next = 0;
+    std::memcpy(&node.value, &item_copy, sizeof(T));
+    return off;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  inline void mapped_dbl_lnk_lst<T>::free_node(const uint64_t off) noexcept {
+    node_at(off).prev = 0;
+    node_at(off).next = hdr().free_head;
+    hdr().free_head = off;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  inline void mapped_dbl_lnk_lst<T>::insert_at_head(const uint64_t off) noexcept {
+    auto &h = hdr();
+    node_at(off).prev = 0;
+    node_at(off).next = h.head;
+    if (h.head != 0)
+      node_at(h.head).prev = off;
+    else
+      h.tail = off;
+    h.head = off;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  inline void mapped_dbl_lnk_lst<T>::append_at_tail(const uint64_t off) noexcept {
+    auto &h = hdr();
+    node_at(off).next = 0;
+    node_at(off).prev = h.tail;
+    if (h.tail != 0)
+      node_at(h.tail).next = off;
+    else
+      h.head = off;
+    h.tail = off;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  inline void mapped_dbl_lnk_lst<T>::link_before(const uint64_t pos_off, const uint64_t off) noexcept {
+    const auto prev_off = node_at(pos_off).prev;
+    if (prev_off == 0) {
+      assert(pos_off == hdr().head); // (we trust but verify)
+      insert_at_head(off);
+      return;
+    }
+    node_at(off).prev = prev_off;
+    node_at(off).next = pos_off;
+    node_at(prev_off).next = off;
+    node_at(pos_off).prev = off;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  inline void mapped_dbl_lnk_lst<T>::link_after(const uint64_t pos_off, const uint64_t off) noexcept {
+    const auto next_off = node_at(pos_off).next;
+    if (next_off == 0) {
+      assert(pos_off == hdr().tail); // (we trust but verify)
+      append_at_tail(off);
+      return;
+    }
+    node_at(off).prev = pos_off;
+    node_at(off).next = next_off;
+    node_at(next_off).prev = off;
+    node_at(pos_off).next = off;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  inline void mapped_dbl_lnk_lst<T>::unlink(const uint64_t off) noexcept {
+    auto &h = hdr();
+    const auto prev_off = node_at(off).prev;
+    const auto next_off = node_at(off).next;
+    if (prev_off != 0)
+      node_at(prev_off).next = next_off;
+    else
+      h.head = next_off;
+    if (next_off != 0)
+      node_at(next_off).prev = prev_off;
+    else
+      h.tail = prev_off;
+  }
+
+  /**
+   * @return offset of first node, starting from head of list, whose value matches pos (or 0)
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  uint64_t mapped_dbl_lnk_lst<T>::find_first(const T&pos) const noexcept {
+    for (auto off = is_open() ? hdr().head : 0; off != 0; off = node_at(off).next) {
+      if (node_at(off).value == pos)
+        return off;
+    }
+    return 0;
+  }
+
+  /**
+   * @return offset of first node, starting from tail of list, whose value matches pos (or 0)
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  uint64_t mapped_dbl_lnk_lst<T>::find_last(const T&pos) const noexcept {
+    for (auto off = is_open() ? hdr().tail : 0; off != 0; off = node_at(off).prev) {
+      if (node_at(off).value == pos)
+        return off;
+    }
+    return 0;
+  }
+
+  /**
+   * Copies item into a new node and links it in before (or after) the pos_off node - when pos_off
+   * is 0 then item is appended at tail of list.
+   * @return returns false when the list isn't open or fails to grow the file
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  bool mapped_dbl_lnk_lst<T>::insert_node(const T &item, const uint64_t pos_off, const bool before) noexcept {
+    const auto off = new_node(item);
+    if (off == 0)
+      return false;
+    if (pos_off == 0)
+      append_at_tail(off);
+    else if (before)
+      link_before(pos_off, off);
+    else
+      link_after(pos_off, off);
+    hdr().count++;
+    return true;
+  }
+
+  /**
+   * Removes a pos specified matched item from list (its node goes onto the free list).
+   * @tparam T item's type
+   * @param pos item to be removed
+   * @return returns true if item was matched and removed from list
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  bool mapped_dbl_lnk_lst<T>::delete_at(const T&pos) noexcept {
+    if (const auto off = find_first(pos); off != 0) {
+      unlink(off);
+      free_node(off);
+      hdr().count--;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Removes all items - the whole node region becomes unused again (the file keeps its size).
+   * @tparam T item's type
+   */
+  template <typename T> requires lst_elm_type_constraints<T> && std::is_trivially_copyable_v<T>
+  void mapped_dbl_lnk_lst<T>::clear() noexcept {
+    if (base == nullptr)
+      return;
+    auto &h = hdr();
+    h.head = h.tail = h.free_head = 0;
+    h.used = first_node_off;
+    h.count = 0;
+  }
+
+} // cust_coll
+
+#endif //MAPPED_DBL_LNK_LST_HPP
@@ -0,0 +1,157 @@
+//
+// Created by rogerv on 5/28/24.
+//
+#include <string>
+#include <vector>
+#include <ranges>
+#include <algorithm>
+#include <cstdlib>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "mapped-dbl-lnk-lst.hpp"
+using cust_coll::mapped_dbl_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+
+/**
+ * A temporary file path (the file itself is created by the list) that is removed upon destruction.
+ */
+struct tmp_path {
+  std::string path{[] {
+    char tmpl[] = "/tmp/mapped-dbl-lnk-lst_XXXXXX";
+    const int fd = ::mkstemp(tmpl);
+    ::close(fd);
+    ::unlink(tmpl);
+    return std::string{tmpl};
+  }()};
+  ~tmp_path() { ::unlink(path.c_str()); }
+  const char* c_str() const noexcept { return path.c_str(); }
+};
+
+struct pod {
+  int64_t a;
+  double b;
+  bool operator==(const pod&) const = default;
+};
+
+TEST(MappedDblLnkLstAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  mapped_dbl_lnk_lst<int> lst{};  // <<=== mapped-dbl-lnk-list
+  EXPECT_FALSE(lst.is_open());
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_FALSE(lst.append(1));  // (not open)
+  EXPECT_EQ(lst.begin(), lst.end());
+
+  tmp_path tmp{};
+  ASSERT_TRUE(lst.open(tmp.c_str()));
+  EXPECT_TRUE(lst.is_open());
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(lst.begin(), lst.end());
+  EXPECT_EQ(lst.rbegin(), lst.rend());
+  EXPECT_FALSE(lst.delete_at(1));
+}
+
+TEST(MappedDblLnkLstAssertions, InsertAppendDeleteAt) {
+  tmp_path tmp{};
+  mapped_dbl_lnk_lst<int> lst{};  // <<=== mapped-dbl-lnk-list
+  ASSERT_TRUE(lst.open(tmp.c_str()));
+  EXPECT_TRUE(lst.append(2));
+  EXPECT_TRUE(lst.insert(1));
+  EXPECT_TRUE(lst.append(4));
+  EXPECT_TRUE(lst.insert_at(3, 4));
+  EXPECT_TRUE(lst.append_at(5, 4));
+  EXPECT_TRUE(lst.insert_at(0, 1));
+  EXPECT_TRUE(lst.insert_at(6, 99));  // (no match - appended)
+  EXPECT_TRUE(std::ranges::equal(lst, std::vector{0, 1, 2, 3, 4, 5, 6}));
+  EXPECT_TRUE(std::ranges::equal(std::ranges::subrange(lst.crbegin(), lst.crend()),
+                                 std::vector{6, 5, 4, 3, 2, 1, 0}));
+  EXPECT_TRUE(lst.delete_at(0));
+  EXPECT_TRUE(lst.delete_at(6));
+  EXPECT_TRUE(lst.delete_at(3));
+  EXPECT_FALSE(lst.delete_at(3));
+  EXPECT_TRUE(std::ranges::equal(lst, std::vector{1, 2, 4, 5}));
+  EXPECT_EQ(lst.size(), 4);
+  auto it = lst.end();
+  EXPECT_EQ(*--it, 5);
+  *it = 50;  // (written in place into the mapping)
+  EXPECT_TRUE(std::ranges::equal(lst, std::vector{1, 2, 4, 50}));
+  lst.clear();
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(lst.begin(), lst.end());
+}
+
+TEST(MappedDblLnkLstAssertions, GrowsFileAndReopens) {
+  tmp_path tmp{};
+  const auto items = std::views::iota(0, ITEM_NBR * 10) |
+                     std::views::transform([](int i) { return pod{i, i * 0.5}; });
+  {
+    mapped_dbl_lnk_lst<pod> lst{};  // <<=== mapped-dbl-lnk-list
+    ASSERT_TRUE(lst.open(tmp.c_str()));
+    const auto initial_bytes = lst.file_bytes();
+    ASSERT_TRUE(lst.append(items[0]));
+    const auto first = lst.begin();
+    for (const auto &item : items | std::views::drop(1))
+      ASSERT_TRUE(lst.append(item));
+    EXPECT_GT(lst.file_bytes(), initial_bytes);
+    EXPECT_EQ(*first, (pod{0, 0}));  // (iterator survives the file being remapped)
+    EXPECT_TRUE(lst.sync());
+  }
+  mapped_dbl_lnk_lst<pod> reopened{};  // <<=== mapped-dbl-lnk-list
+  ASSERT_TRUE(reopened.open(tmp.c_str()));
+  EXPECT_EQ(reopened.size(), ITEM_NBR * 10);
+  EXPECT_TRUE(std::ranges::equal(reopened, items));
+
+  // freed nodes are reused before the file grows any further
+  const auto bytes = reopened.file_bytes();
+  for (int i = 0; i < ITEM_NBR; i++)
+    ASSERT_TRUE(reopened.delete_at(pod{i, i * 0.5}));
+  for (int i = 0; i < ITEM_NBR; i++)
+    ASSERT_TRUE(reopened.insert(pod{-i, -i * 0.5}));
+  EXPECT_EQ(reopened.file_bytes(), bytes);
+  EXPECT_EQ(reopened.size(), ITEM_NBR * 10);
+  EXPECT_EQ(*reopened.begin(), (pod{-(ITEM_NBR - 1), -(ITEM_NBR - 1) * 0.5}));
+}
+
+TEST(MappedDblLnkLstAssertions, AppendOwnItemAcrossFileGrowth) {
+  tmp_path tmp{};
+  mapped_dbl_lnk_lst<pod> lst{};  // <<=== mapped-dbl-lnk-list
+  ASSERT_TRUE(lst.open(tmp.c_str()));
+  ASSERT_TRUE(lst.append(pod{1, 0.5}));
+  ASSERT_TRUE(lst.append(pod{2, 1.0}));
+  // each add is passed an item of the list itself - and the file is remapped many times over
+  const auto initial_bytes = lst.file_bytes();
+  for (int i = 0; i < ITEM_NBR * 10; i++) {
+    switch (i % 3) {
+      case 0: ASSERT_TRUE(lst.append(*lst.begin())); break;
+      case 1: ASSERT_TRUE(lst.insert(*std::next(lst.begin()))); break;
+      default: ASSERT_TRUE(lst.append_at(*lst.begin(), *lst.begin()));
+    }
+  }
+  EXPECT_GT(lst.file_bytes(), initial_bytes);
+  EXPECT_EQ(lst.size(), ITEM_NBR * 10 + 2);
+  EXPECT_TRUE(std::ranges::all_of(lst, [](const pod &item) { return item == pod{1, 0.5} || item == pod{2, 1.0}; }));
+}
+
+TEST(MappedDblLnkLstAssertions, RejectsOtherFiles) {
+  tmp_path tmp{};
+  {
+    mapped_dbl_lnk_lst<int> lst{};  // <<=== mapped-dbl-lnk-list
+    ASSERT_TRUE(lst.open(tmp.c_str()));
+    EXPECT_TRUE(lst.append(1));
+  }
+  mapped_dbl_lnk_lst<int64_t> wrong_type{};  // <<=== mapped-dbl-lnk-list
+  EXPECT_FALSE(wrong_type.open(tmp.c_str()));
+  EXPECT_FALSE(wrong_type.is_open());
+
+  tmp_path garbage{};
+  FILE *const f = std::fopen(garbage.c_str(), "w");
+  ASSERT_NE(f, nullptr);
+  std::fputs("not a list", f);
+  std::fclose(f);
+  mapped_dbl_lnk_lst<int> lst{};  // <<=== mapped-dbl-lnk-list
+  EXPECT_FALSE(lst.open(garbage.c_str()));
+  EXPECT_FALSE(lst.open("/nonexistent-dir/lst"));
+}
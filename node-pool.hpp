@@ -0,0 +1,255 @@
+//
+// Created by rogerv on 5/12/24.
+//
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <memory>
+#include <new>
+#include <limits>
+#include <cstddef>
+#include <algorithm>
+#include <concepts>
+
+namespace cust_coll {
+
+  /**
+   * A slab pool of fixed-size slots. Slots are carved out of contiguous slabs (each holding
+   * slots_per_slab slots); freed slots go onto an intrusive free list and are handed out again
+   * before any new slab is carved into.
+   *
+   * The slot size is set once, by size_for(), ahead of any allocation (see slab_pools).
+   *
+   * Not thread-safe (same as the containers it serves).
+   */
+  class slab_pool {
+    struct free_slot { free_slot *next; };
+    struct slab_hdr  { slab_hdr *next; size_t align; };
+    const size_t slots_per_slab;
+    size_t slot_size{0};
+    size_t slot_align{0};
+    slab_hdr *slabs{nullptr};        // owning plain pointer to list of slabs
+    free_slot *free_list{nullptr};   // non-owning plain pointer to recycled slots
+    std::byte *bump{nullptr};        // next never-used slot in the most recent slab
+    std::byte *bump_end{nullptr};
+    size_t slots_in_use{0};
+    size_t slots_free{0};            // number of slots on free list
+
+    static size_t slots_offset(size_t align) noexcept {
+      return (sizeof(slab_hdr) + align - 1) / align * align;
+    }
+    void add_slab(const size_t nbr_slots) {
+      const auto offset = slots_offset(slot_align);
+      if (nbr_slots > (std::numeric_limits<size_t>::max() - offset) / slot_size)
+        throw std::bad_alloc{};  // (the slab's byte size would overflow)
+      auto *const raw = static_cast<std::byte*>(
+          ::operator new(offset + slot_size * nbr_slots, std::align_val_t{slot_align}));
+      auto *const slab = reinterpret_cast<slab_hdr*>(raw);
+      slab->next = slabs;
+      slab->align = slot_align;
+      slabs = slab;
+      bump = raw + offset;
+      bump_end = bump + slot_size * nbr_slots;
+    }
+  public:
+    explicit slab_pool(size_t slots_per_slab) noexcept : slots_per_slab{std::max<size_t>(slots_per_slab, 1)} {}
+    slab_pool(const slab_pool&) = delete;
+    slab_pool& operator=(const slab_pool&) = delete;
+    ~slab_pool() noexcept { release(); }
+
+    /**
+     * Sets the slot size of a pool not yet sized to that of objects of the given size and
+     * alignment.
+     * @return true when the pool's slots are now (or were already) sized for such objects
+     */
+    bool size_for(size_t size, size_t align) noexcept {
+      const auto align_for = std::max(align, alignof(free_slot));
+      const auto size_for = (std::max(size, sizeof(free_slot)) + align_for - 1) / align_for * align_for;
+      if (slot_size == 0) {
+        slot_size = size_for;
+        slot_align = align_for;
+      }
+      return slot_size == size_for && slot_align == align_for;
+    }
+    /**
+     * Hands out one slot, recycled from free list if possible, otherwise from the current slab.
+     * @return slot memory - throws std::bad_alloc when a new slab cannot be acquired
+     */
+    void* allocate() {
+      if (free_list != nullptr) {
+        auto *const slot = free_list;
+        free_list = slot->next;
+        slots_free--;
+        slots_in_use++;
+        return slot;
+      }
+      if (bump == bump_end)
+        add_slab(slots_per_slab);
+      auto *const slot = bump;
+      bump += slot_size;
+      slots_in_use++;
+      return slot;
+    }
+    /**
+     * Returns a slot to the free list (memory is retained by the pool).
+     */
+    void deallocate(void *const p) noexcept {
+      auto *const slot = static_cast<free_slot*>(p);
+      slot->next = free_list;
+      free_list = slot;
+      slots_free++;
+      slots_in_use--;
+    }
+    /**
+     * Makes sure the next nbr allocations are serviced without acquiring more than one new slab -
+     * when needed, the remainder of the current slab goes onto the free list and a slab large
+     * enough for the shortfall is carved. So a batch of allocations either fails up front or not
+     * at all; as free slots are handed out first, the batch is contiguous only insofar as it
+     * comes out of the new slab. Throws std::bad_alloc when the new slab cannot be acquired.
+     */
+    void reserve(const size_t nbr) {
+      if (slot_size == 0 || slots_free + static_cast<size_t>(bump_end - bump) / slot_size >= nbr)
+        return;
+      while (bump != bump_end) {
+        auto *const slot = reinterpret_cast<free_slot*>(bump);
+        bump += slot_size;
+        slot->next = free_list;
+        free_list = slot;
+        slots_free++;
+      }
+      add_slab(std::max(nbr - slots_free, slots_per_slab));
+    }
+    /**
+     * Gives back every slab at once - all outstanding slots become invalid.
+     */
+    void release() noexcept {
+      while (slabs != nullptr) {
+        auto *const slab = slabs;
+        slabs = slab->next;
+        ::operator delete(slab, std::align_val_t{slab->align});
+      }
+      free_list = nullptr;
+      bump = bump_end = nullptr;
+      slots_in_use = slots_free = 0;
+    }
+    size_t in_use() const noexcept { return slots_in_use; }
+  };
+
+  /**
+   * The slab_pool instances shared by a pool_allocator and all of its copies - one per distinct
+   * slot size, so each type an allocator is rebound to (e.g. the node type of a container) has a
+   * pool sized for it, whichever type allocates first.
+   */
+  class slab_pools {
+    static constexpr size_t max_pools = 4;
+    slab_pool pools[max_pools];
+  public:
+    explicit slab_pools(size_t slots_per_slab) noexcept
+      : pools{slab_pool{slots_per_slab}, slab_pool{slots_per_slab}, slab_pool{slots_per_slab}, slab_pool{slots_per_slab}} {}
+    /**
+     * @return the pool with slots sized for objects of the given size and alignment (sizing one
+     *         still unsized if need be), or null when all pools are sized for other objects
+     */
+    slab_pool* pool_for(const size_t size, const size_t align) noexcept {
+      for (auto &pool : pools) {
+        if (pool.size_for(size, align))
+          return &pool;
+      }
+      return nullptr;
+    }
+    size_t in_use() const noexcept {
+      size_t nbr = 0;
+      for (const auto &pool : pools)
+        nbr += pool.in_use();
+      return nbr;
+    }
+  };
+
+  /**
+   * A std::allocator compatible allocator that services single-object allocations from a
+   * shared slab_pool; is intended as the node allocator of dbl_lnk_lst:
+   *
+   *     dbl_lnk_lst<int, pool_allocator<int>> lst{};
+   *
+   * Copies (including rebound copies) share the same slab_pools, in which each type allocated
+   * gets a slab_pool of its own, sized for it upon construction or rebind. Array allocations (or
+   * a type in excess of the number of pools) fall back to the heap.
+   *
+   * @tparam T type allocated
+   * @tparam SlabNodes number of slots carved out of each slab
+   */
+  template <typename T, size_t SlabNodes = 256>
+  class pool_allocator {
+    template <typename U, size_t N> friend class pool_allocator;
+    std::shared_ptr<slab_pools> pools;
+    slab_pool *pool;  // non-owning plain pointer (null when T is left to the heap)
+  public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+    template <typename U> struct rebind { using other = pool_allocator<U, SlabNodes>; };
+
+    pool_allocator()
+      : pools{std::make_shared<slab_pools>(SlabNodes)}, pool{pools->pool_for(sizeof(T), alignof(T))} {}
+    pool_allocator(const pool_allocator&) noexcept = default;
+    template <typename U>
+    pool_allocator(const pool_allocator<U, SlabNodes> &oth) noexcept
+      : pools{oth.pools}, pool{pools->pool_for(sizeof(T), alignof(T))} {}
+    pool_allocator& operator=(const pool_allocator&) noexcept = default;
+
+    T* allocate(size_t n) {
+      if (n == 1 && pool != nullptr)
+        return static_cast<T*>(pool->allocate());
+      return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T *const p, size_t n) noexcept {
+      if (n == 1 && pool != nullptr)
+        pool->deallocate(p);
+      else
+        std::allocator<T>{}.deallocate(p, n);
+    }
+    /**
+     * Prepares the pool for n upcoming single-object allocations (see slab_pool::reserve).
+     */
+    void reserve(const size_t n) {
+      if (pool != nullptr)
+        pool->reserve(n);
+    }
+    /**
+     * @return true when no other allocator copy shares this pool (so is safe to release)
+     */
+    bool owns_pool_exclusively() const noexcept { return pools.use_count() == 1; }
+    /**
+     * Gives back all of the pool's slabs at once.
+     */
+    void release() noexcept {
+      if (pool != nullptr)
+        pool->release();
+    }
+    // number of slots in use across the shared pools (whatever the type they were allocated as)
+    size_t in_use() const noexcept { return pools->in_use(); }
+
+    friend bool operator==(const pool_allocator &a, const pool_allocator &b) noexcept { return a.pools == b.pools; }
+  };
+
+  /**
+   * Satisfied by a node allocator that can give back all of its memory in a single call.
+   */
+  template <typename A>
+  concept bulk_releasable_alloc = requires(A a, const A ca) {
+    { ca.owns_pool_exclusively() } noexcept -> std::same_as<bool>;
+    { a.release() } noexcept;
+  };
+
+  /**
+   * Satisfied by a node allocator that can prepare for a batch of single-object allocations.
+   */
+  template <typename A>
+  concept reservable_alloc = requires(A a, size_t n) {
+    a.reserve(n);
+  };
+
+} // cust_coll
+
+#endif //NODE_POOL_HPP
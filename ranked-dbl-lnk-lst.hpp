@@ -0,0 +1,392 @@
+//
+// Created by rogerv on 5/31/24.
+//
+#ifndef RANKED_DBL_LNK_LST_HPP
+#define RANKED_DBL_LNK_LST_HPP
+
+#include <array>
+#include <bit>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include "dbl-lnk-lst.hpp"
+
+namespace cust_coll {
+
+  /**
+   * A dbl_lnk_lst that also maintains an order-statistics index over its nodes - skip-list style
+   * express lanes, each lane recording the number of nodes it spans - so that accessing, inserting
+   * or erasing the item at a given index, and finding the index of an item, take O(log n)
+   * expected time instead of a walk of the list.
+   *
+   * Each node is promoted into the express lanes with probability 1/4 per level (so one node in
+   * four carries a tower of lanes, one in sixteen reaches the second level, and so on). The towers
+   * are kept beside the list (keyed by node) rather than in the nodes, so the lst_node chain is
+   * exactly that of dbl_lnk_lst. An operation locates the towers preceding a node by walking back
+   * along the list to the nearest tower (a walk of 4 nodes expected), then climbing the express
+   * lanes back to the head of list.
+   *
+   * Semantics of insert/insert_at/append/append_at/delete_at are the same as dbl_lnk_lst (the
+   * positional ones scan for their pos item), with the index kept up to date by all of them.
+   *
+   * Is neither copyable nor movable (the lanes refer to the head of list tower within the object).
+   *
+   * @tparam T type of element contained by container - as constrained by
+   *           concept lst_elm_type_constraints
+   * @tparam Alloc allocator type - is rebound to allocate the list nodes and the index towers
+   */
+  template <typename T, typename Alloc = std::allocator<T>>
+    requires lst_elm_type_constraints<T>
+  class ranked_dbl_lnk_lst : protected dbl_lnk_lst<T, Alloc> {
+  protected:
+    using base = dbl_lnk_lst<T, Alloc>;
+    using node_t = lst_node<T>;
+    static constexpr size_t max_levels = 24;  // (4^24 nodes - beyond any list that fits in memory)
+    struct tower;
+    struct lane {
+      tower *prev{nullptr};  // non-owning plain pointer (to the previous tower at this level)
+      tower *next{nullptr};  // non-owning plain pointer (null when last at this level)
+      size_t span{0};        // nodes from this tower to the next (to one past tail of list if last)
+    };
+    using lane_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<lane>;
+    struct tower {
+      node_t *node{nullptr};                    // non-owning plain pointer (null for head tower)
+      std::vector<lane, lane_alloc_t> lanes{};  // lanes[0] is the lowest express lane
+    };
+    using tower_map_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<std::pair<node_t *const, tower>>;
+    using tower_map_t = std::unordered_map<node_t*, tower, std::hash<node_t*>, std::equal_to<node_t*>, tower_map_alloc_t>;
+    using preds_t = std::array<tower*, max_levels>;
+    using dists_t = std::array<size_t, max_levels>;
+    tower_map_t towers;  // (mapped values stay put on rehash, so lanes can point at them)
+    tower head_tower;    // position 0, ahead of the first node (node i is at position i + 1)
+    uint64_t rng_state{0x9E3779B97F4A7C15ull};
+    size_t random_height() noexcept;
+    tower* tower_of(const node_t *node) noexcept;
+    void find_preds(const node_t *node, preds_t &preds, dists_t &dists) noexcept;
+    node_t* node_at(size_t i) const noexcept;
+    bool index_add(node_t *node) noexcept;
+    void index_remove(node_t *node) noexcept;
+    template <typename U> bool insert_node(U &&item, node_t *pos_node, bool before) noexcept;
+    void erase_node(node_t *node) noexcept;
+  public:
+    using typename base::allocator_type;
+    using typename base::iterator;
+    using typename base::const_iterator;
+    using typename base::reverse_iterator;
+    using typename base::const_reverse_iterator;
+    ranked_dbl_lnk_lst() noexcept(std::is_nothrow_default_constructible_v<base> &&
+                                  std::is_nothrow_default_constructible_v<tower_map_t>) = default;
+    explicit ranked_dbl_lnk_lst(const Alloc &alloc) noexcept
+      : base{alloc}, towers{tower_map_alloc_t{alloc}}, head_tower{nullptr, std::vector<lane, lane_alloc_t>{lane_alloc_t{alloc}}} {}
+    ranked_dbl_lnk_lst(const ranked_dbl_lnk_lst&) = delete;
+    ranked_dbl_lnk_lst& operator=(const ranked_dbl_lnk_lst&) = delete;
+    ~ranked_dbl_lnk_lst() noexcept { clear(); }
+    using base::size;
+    using base::is_empty;
+    using base::get_allocator;
+    bool insert(const T& item) noexcept requires std::copy_constructible<T>
+      { return insert_node(item, this->head, true); }
+    bool insert(T &&item) noexcept { return insert_node(std::move(item), this->head, true); }
+    bool insert_at(const T& item, const T&pos) noexcept requires std::copy_constructible<T>
+      { return insert_node(item, this->find_first(pos), true); }
+    bool insert_at(T &&item, const T&pos) noexcept { return insert_node(std::move(item), this->find_first(pos), true); }
+    bool append(const T& item) noexcept requires std::copy_constructible<T>
+      { return insert_node(item, this->tail, false); }
+    bool append(T &&item) noexcept { return insert_node(std::move(item), this->tail, false); }
+    bool append_at(const T& item, const T&pos) noexcept requires std::copy_constructible<T>
+      { return insert_node(item, this->find_last(pos), false); }
+    bool append_at(T &&item, const T&pos) noexcept { return insert_node(std::move(item), this->find_last(pos), false); }
+    bool delete_at(const T&pos) noexcept;
+    T& at(size_t i) noexcept { return node_at(i)->value; }
+    const T& at(size_t i) const noexcept { return node_at(i)->value; }
+    T& operator[](size_t i) noexcept { return node_at(i)->value; }
+    const T& operator[](size_t i) const noexcept { return node_at(i)->value; }
+    bool insert_at_index(size_t i, const T& item) noexcept requires std::copy_constructible<T>;
+    bool insert_at_index(size_t i, T &&item) noexcept;
+    bool erase_at_index(size_t i) noexcept;
+    size_t index_of(const_iterator it) const noexcept;
+    void clear() noexcept { towers.clear(); head_tower.lanes.clear(); base::clear(); }
+    using base::begin;
+    using base::end;
+    using base::cbegin;
+    using base::cend;
+    using base::rbegin;
+    using base::rend;
+    using base::crbegin;
+    using base::crend;
+  };
+
+  /**
+   * Draws the number of express lanes for a new node - geometric with p = 1/4 (two trailing zero
+   * bits of an xorshift64 draw per level).
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  size_t ranked_dbl_lnk_lst<T, Alloc>::random_height() noexcept {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return std::min<size_t>(std::countr_zero(rng_state | (uint64_t{1} << 62)) / 2, max_levels);
+  }
+
+  /**
+   * @return the tower of a node, or null when the node was not promoted into any express lane
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  auto ranked_dbl_lnk_lst<T, Alloc>::tower_of(const node_t *const node) noexcept -> tower* {
+    const auto it = towers.find(const_cast<node_t*>(node));
+    return it != towers.end() ? &it->second : nullptr;
+  }
+
+  /**
+   * Finds, for every level of the index, the last tower preceding node and the distance (in
+   * positions) from that tower to node - by walking back along the list to the nearest tower,
+   * then back along the topmost lane of each tower in turn to the head tower.
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  void ranked_dbl_lnk_lst<T, Alloc>::find_preds(const node_t *const node, preds_t &preds, dists_t &dists) noexcept {
+    size_t dist = 1;
+    tower *x = &head_tower;
+    for (const auto *n = node->prev; n != nullptr; n = n->prev, dist++) {
+      if (auto *const t = tower_of(n); t != nullptr) {
+        x = t;
+        break;
+      }
+    }
+    const size_t nbr_levels = head_tower.lanes.size();
+    for (size_t lvl = 0; lvl < nbr_levels;) {
+      for (; lvl < x->lanes.size(); lvl++) {
+        preds[lvl] = x;
+        dists[lvl] = dist;
+      }
+      if (lvl < nbr_levels) {
+        auto *const prev = x->lanes[lvl - 1].prev;
+        dist += prev->lanes[lvl - 1].span;
+        x = prev;
+      }
+    }
+  }
+
+  /**
+   * Descends the express lanes from the head tower to the last tower at or before index i, then
+   * walks the list the rest of the way.
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  auto ranked_dbl_lnk_lst<T, Alloc>::node_at(const size_t i) const noexcept -> node_t* {
+    assert(i < this->count); // (we trust but verify)
+    const size_t target = i + 1;
+    const tower *x = &head_tower;
+    size_t pos = 0;
+    for (size_t lvl = head_tower.lanes.size(); lvl-- > 0;) {
+      while (x->lanes[lvl].next != nullptr && pos + x->lanes[lvl].span <= target) {
+        pos += x->lanes[lvl].span;
+        x = x->lanes[lvl].next;
+      }
+    }
+    node_t *node = x->node;
+    if (node == nullptr) {
+      node = this->head;
+      pos = 1;
+    }
+    for (; pos < target; pos++)
+      node = node->next;
+    return node;
+  }
+
+  /**
+   * Records a newly linked node (not yet counted) in the index - raising the head tower when the
+   * node's tower is the tallest yet, lengthening every lane that passes over the node, and
+   * splitting the lanes that the node's own tower cuts across.
+   * @return false when fails to allocate memory for a new tower
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  bool ranked_dbl_lnk_lst<T, Alloc>::index_add(node_t *const node) noexcept {
+    const size_t height = random_height();
+    tower *t = nullptr;
+    try {
+      if (height > head_tower.lanes.size())
+        head_tower.lanes.resize(height, lane{nullptr, nullptr, this->count + 1});
+      if (height > 0) {
+        t = &towers.try_emplace(node, tower{node, std::vector<lane, lane_alloc_t>{lane_alloc_t{this->node_alloc}}}).first->second;
+        t->lanes.resize(height);
+      }
+    } catch (...) {
+      if (t != nullptr)
+        towers.erase(node);
+      return false;
+    }
+    preds_t preds;
+    dists_t dists;
+    find_preds(node, preds, dists);
+    for (size_t lvl = 0; lvl < head_tower.lanes.size(); lvl++)
+      preds[lvl]->lanes[lvl].span++;
+    for (size_t lvl = 0; lvl < height; lvl++) {
+      auto &pred_lane = preds[lvl]->lanes[lvl];
+      t->lanes[lvl] = lane{preds[lvl], pred_lane.next, pred_lane.span - dists[lvl]};
+      if (pred_lane.next != nullptr)
+        pred_lane.next->lanes[lvl].prev = t;
+      pred_lane.next = t;
+      pred_lane.span = dists[lvl];
+    }
+    return true;
+  }
+
+  /**
+   * Drops a node, about to be unlinked, from the index - the lanes of its tower (if any) are
+   * merged into those of the preceding towers, and every other lane passing over it shortened.
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  void ranked_dbl_lnk_lst<T, Alloc>::index_remove(node_t *const node) noexcept {
+    preds_t preds;
+    dists_t dists;
+    find_preds(node, preds, dists);
+    const auto it = towers.find(node);
+    const size_t height = it != towers.end() ? it->second.lanes.size() : 0;
+    for (size_t lvl = 0; lvl < height; lvl++) {
+      const auto &node_lane = it->second.lanes[lvl];
+      auto &pred_lane = preds[lvl]->lanes[lvl];
+      assert(pred_lane.next == &it->second); // (we trust but verify)
+      pred_lane.span += node_lane.span - 1;
+      pred_lane.next = node_lane.next;
+      if (node_lane.next != nullptr)
+        node_lane.next->lanes[lvl].prev = preds[lvl];
+    }
+    for (size_t lvl = height; lvl < head_tower.lanes.size(); lvl++)
+      preds[lvl]->lanes[lvl].span--;
+    if (height > 0)
+      towers.erase(it);
+  }
+
+  /**
+   * Allocates a node for item and links it in before (or after) pos_node - when pos_node is
+   * null then item is appended at tail of list.
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  template <typename U>
+  bool ranked_dbl_lnk_lst<T, Alloc>::insert_node(U &&item, node_t *const pos_node, const bool before) noexcept {
+    auto *const node = this->new_node(std::forward<U>(item));
+    if (node == nullptr)
+      return false;
+    if (pos_node == nullptr)
+      this->append_at_tail(node);
+    else if (before)
+      this->link_before(pos_node, node);
+    else
+      this->link_after(pos_node, node);
+    if (not index_add(node)) {
+      this->unlink(node);
+      this->free_node(node);
+      return false;
+    }
+    this->count++;
+    return true;
+  }
+
+  /**
+   * Unlinks a node from list and index and frees it.
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  void ranked_dbl_lnk_lst<T, Alloc>::erase_node(node_t *const node) noexcept {
+    index_remove(node);
+    this->unlink(node);
+    this->free_node(node);
+    this->count--;
+  }
+
+  /**
+   * Removes a pos specified matched item from list (the first match starting from head of list).
+   * @tparam T item's type
+   * @param pos item to be removed
+   * @return returns true if item was matched and removed from list
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  bool ranked_dbl_lnk_lst<T, Alloc>::delete_at(const T&pos) noexcept {
+    auto *const node = this->find_first(pos);
+    if (node == nullptr)
+      return false;
+    erase_node(node);
+    return true;
+  }
+
+  /**
+   * Copies item into the container so that it becomes the item at index i (i == size() appends).
+   * @tparam T item's type
+   * @param i index the item is to have
+   * @param item to be copy-inserted
+   * @return returns false when i is beyond size() or fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  bool ranked_dbl_lnk_lst<T, Alloc>::insert_at_index(const size_t i, const T& item) noexcept
+    requires std::copy_constructible<T>
+  {
+    if (i > this->count)
+      return false;
+    return insert_node(item, i < this->count ? node_at(i) : nullptr, true);
+  }
+
+  /**
+   * Same as insert_at_index() above but moves item into the container (thus taking ownership).
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  bool ranked_dbl_lnk_lst<T, Alloc>::insert_at_index(const size_t i, T &&item) noexcept {
+    if (i > this->count)
+      return false;
+    return insert_node(std::move(item), i < this->count ? node_at(i) : nullptr, true);
+  }
+
+  /**
+   * Removes the item at index i from list.
+   * @return returns false when i is not less than size()
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  bool ranked_dbl_lnk_lst<T, Alloc>::erase_at_index(const size_t i) noexcept {
+    if (i >= this->count)
+      return false;
+    erase_node(node_at(i));
+    return true;
+  }
+
+  /**
+   * Determines the index of the item an iterator refers to (size() for end()) - by walking back
+   * along the list to the nearest tower, then back along the topmost lane of each tower in turn to
+   * the head tower, summing the spans.
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  size_t ranked_dbl_lnk_lst<T, Alloc>::index_of(const_iterator it) const noexcept {
+    const auto *const node = base::node_of(it);
+    if (node == nullptr)
+      return this->count;
+    size_t pos = 0;
+    const tower *x = nullptr;
+    for (const auto *n = node; n != nullptr; n = n->prev, pos++) {
+      if (const auto t = towers.find(const_cast<node_t*>(n)); t != towers.end()) {
+        x = &t->second;
+        break;
+      }
+    }
+    if (x == nullptr)
+      return pos - 1;  // (walked all the way back to head of list)
+    while (x != &head_tower) {
+      const auto lvl = x->lanes.size() - 1;
+      x = x->lanes[lvl].prev;
+      pos += x->lanes[lvl].span;
+    }
+    return pos - 1;
+  }
+
+} // cust_coll
+
+#endif //RANKED_DBL_LNK_LST_HPP
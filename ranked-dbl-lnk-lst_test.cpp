@@ -0,0 +1,129 @@
+//
+// Created by rogerv on 5/31/24.
+//
+#include <vector>
+#include <ranges>
+#include <algorithm>
+#include <memory_resource>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "ranked-dbl-lnk-lst.hpp"
+using cust_coll::ranked_dbl_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+
+template <typename Alloc = std::allocator<int>>
+static void random_ops_vs_oracle(const int nbr_values, const Alloc &alloc = Alloc{}) {
+  ranked_dbl_lnk_lst<int, Alloc> lst{alloc};  // <<=== ranked-dbl-lnk-list
+  std::vector<int> oracle{};
+  for (int i = 0; i < ITEM_NBR; i++) {
+    const int val = rand() % nbr_values;
+    const int pos = rand() % nbr_values;
+    const size_t idx = rand() % (oracle.size() + 1);
+    switch (rand() % 7) {
+      case 0: {
+        EXPECT_TRUE(lst.insert(val));
+        oracle.insert(oracle.begin(), val);
+        break;
+      }
+      case 1: {
+        EXPECT_TRUE(lst.append(val));
+        oracle.push_back(val);
+        break;
+      }
+      case 2: {
+        EXPECT_TRUE(lst.insert_at(val, pos));
+        oracle.insert(std::find(oracle.begin(), oracle.end(), pos), val);
+        break;
+      }
+      case 3: {
+        EXPECT_TRUE(lst.append_at(val, pos));
+        auto it = std::find(oracle.rbegin(), oracle.rend(), pos);
+        oracle.insert(it != oracle.rend() ? it.base() : oracle.end(), val); // (base() is one past the match)
+        break;
+      }
+      case 4: {
+        auto it = std::find(oracle.begin(), oracle.end(), pos);
+        EXPECT_EQ(lst.delete_at(pos), it != oracle.end());
+        if (it != oracle.end())
+          oracle.erase(it);
+        break;
+      }
+      case 5: {
+        EXPECT_TRUE(lst.insert_at_index(idx, val));
+        oracle.insert(oracle.begin() + idx, val);
+        break;
+      }
+      default: {
+        EXPECT_EQ(lst.erase_at_index(idx), idx < oracle.size());
+        if (idx < oracle.size())
+          oracle.erase(oracle.begin() + idx);
+      }
+    }
+    if (not oracle.empty()) {
+      const size_t probe = rand() % oracle.size();
+      ASSERT_EQ(lst.at(probe), oracle[probe]);
+    }
+  }
+  ASSERT_EQ(lst.size(), oracle.size());
+  EXPECT_TRUE(std::ranges::equal(lst, oracle));
+  size_t i = 0;
+  for (auto it = lst.cbegin(); it != lst.cend(); ++it, i++) {
+    ASSERT_EQ(lst[i], oracle[i]);
+    ASSERT_EQ(lst.index_of(it), i);
+  }
+  EXPECT_EQ(lst.index_of(lst.cend()), lst.size());
+  while (not lst.is_empty())
+    EXPECT_TRUE(lst.erase_at_index(rand() % lst.size()));
+  EXPECT_FALSE(lst.erase_at_index(0));
+}
+
+TEST(RankedDblLnkListAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  ranked_dbl_lnk_lst<some_elm> lst{};  // <<=== ranked-dbl-lnk-list
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(lst.index_of(lst.cend()), 0);
+  EXPECT_FALSE(lst.erase_at_index(0));
+  EXPECT_FALSE(lst.insert_at_index(1, some_elm{}));
+}
+
+TEST(RankedDblLnkListAssertions, IndexedAccessSomeElm) {
+  std::vector<some_elm> strs{ITEM_NBR};
+  ranked_dbl_lnk_lst<some_elm> lst{};  // <<=== ranked-dbl-lnk-list
+  for (const auto &elm: strs)
+    EXPECT_TRUE(lst.append(elm));
+  for (size_t i = 0; i < strs.size(); i++)
+    ASSERT_EQ(lst.at(i).s, strs[i].s);
+  some_elm item{};
+  const some_elm sav_item{item};
+  EXPECT_TRUE(lst.insert_at_index(ITEM_NBR / 2, std::move(item)));
+  EXPECT_EQ(lst[ITEM_NBR / 2].s, sav_item.s);
+  EXPECT_EQ(lst[ITEM_NBR / 2 + 1].s, strs[ITEM_NBR / 2].s);
+  auto it = std::ranges::find(lst, sav_item);
+  EXPECT_EQ(lst.index_of(it), ITEM_NBR / 2);
+  lst[0] = sav_item;  // (items are writable in place)
+  EXPECT_TRUE(lst.delete_at(sav_item));  // (the first match - at index 0)
+  EXPECT_EQ(lst.index_of(std::ranges::find(lst, sav_item)), ITEM_NBR / 2 - 1);
+  EXPECT_TRUE(lst.erase_at_index(ITEM_NBR / 2 - 1));
+  EXPECT_EQ(lst.size(), ITEM_NBR - 1);
+  for (size_t i = 1; i <= lst.size(); i++)
+    ASSERT_EQ(lst[i - 1].s, strs[i].s);
+  lst.clear();
+  EXPECT_TRUE(lst.is_empty());
+}
+
+TEST(RankedDblLnkListAssertions, UniqueValuesVsStdVector) {
+  random_ops_vs_oracle(ITEM_NBR * 10);
+}
+
+TEST(RankedDblLnkListAssertions, DuplicateValuesVsStdVector) {
+  random_ops_vs_oracle(64);
+}
+
+TEST(RankedDblLnkListAssertions, PolymorphicAllocator) {
+  std::pmr::unsynchronized_pool_resource pool{};
+  random_ops_vs_oracle(ITEM_NBR, std::pmr::polymorphic_allocator<int>{&pool});
+}
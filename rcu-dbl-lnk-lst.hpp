@@ -0,0 +1,356 @@
+//
+// Created by rogerv on 6/1/24.
+//
+#ifndef RCU_DBL_LNK_LST_HPP
+#define RCU_DBL_LNK_LST_HPP
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cassert>
+#include <utility>
+#include <iterator>
+#include "dbl-lnk-lst.hpp"
+
+namespace cust_coll {
+
+  /**
+   * A doubly-linked-list for read-mostly sharing between threads - readers traverse it without
+   * taking any lock while writers (serialized by a mutex, so typically a single writer thread)
+   * insert and delete, RCU style:
+   *
+   * - a writer fully initializes a node before publishing it with a release store of the link
+   *   that leads to it, so a reader (loading links with acquire) sees it either whole or not at all
+   * - an unlinked node keeps its own next link, so a reader standing on it carries on from there
+   * - an unlinked node is not freed but retired, then freed by epoch-based reclamation once no
+   *   reader that could have reached it remains
+   *
+   * A reader brackets its traversal with a read_guard (from read_lock()), which registers it in
+   * the current epoch - an epoch counts readers per parity, in counters striped over cache lines
+   * by thread. Nodes retired in epoch e are freed when the epoch advances from e + 1 to e + 2,
+   * which a writer only does once no reader of epoch e remains (their parity count is zero);
+   * a writer tries to advance the epoch after every retire_batch nodes it has retired, without
+   * ever waiting on readers - so a reader that stays in a read section only delays reclamation.
+   *
+   * Readers see items as const, via forward iteration (begin()/end() while a read_guard is held,
+   * or for_each(f)); writers have insert/insert_at/append/append_at/delete_at/clear with the
+   * semantics of dbl_lnk_lst.
+   *
+   * @tparam T type of element contained by container - as constrained by
+   *           concept lst_elm_type_constraints
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  class rcu_dbl_lnk_lst {
+  protected:
+    struct rcu_node {
+      std::atomic<rcu_node*> next{nullptr};  // owning plain pointer (read by readers)
+      rcu_node *prev{nullptr};               // non-owning plain pointer (writers only)
+      rcu_node *next_retired{nullptr};       // non-owning plain pointer (chains a limbo list)
+      T value;
+      template <typename... Args>
+      explicit rcu_node(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+    };
+    static constexpr size_t nbr_stripes = 32;
+    static constexpr size_t retire_batch = 64;
+    struct alignas(64) reader_stripe {  // (one cache line per stripe)
+      std::atomic<int64_t> active[2]{};   // readers in a read section, by parity of their epoch
+    };
+    std::atomic<rcu_node*> head{nullptr};  // owning plain pointer
+    rcu_node *tail{nullptr};               // non-owning plain pointer (writers only)
+    std::atomic<size_t> count{0};
+    std::mutex writer_mtx{};
+    std::atomic<uint64_t> epoch{0};
+    mutable reader_stripe stripes[nbr_stripes]{};
+    rcu_node *limbo[2]{};     // owning plain pointers - nodes retired, by parity of the epoch retired in
+    size_t nbr_limbo[2]{};
+    static size_t stripe_idx() noexcept;
+    static void free_chain(rcu_node *first, rcu_node *rcu_node::*link) noexcept;
+    void link_after(rcu_node *pred, rcu_node *node) noexcept;
+    void unlink(rcu_node *node) noexcept;
+    rcu_node* find_first(const T&pos) const noexcept;
+    rcu_node* find_last(const T&pos) const noexcept;
+    void retire(rcu_node *node) noexcept;
+    bool try_advance() noexcept;
+    template <typename U> bool link_new(U &&item, bool at_tail, const T *pos) noexcept;
+  public:
+    /**
+     * RAII read section - while one is held by a thread, no node it can reach from the list is
+     * freed. Sections nest, but must be short relative to the rate of writes (else retired nodes
+     * pile up until it ends).
+     */
+    class read_guard {
+    protected:
+      reader_stripe *stripe{nullptr};  // non-owning plain pointer
+      size_t parity{0};
+      friend class rcu_dbl_lnk_lst;
+      explicit read_guard(reader_stripe *s, size_t p) noexcept : stripe{s}, parity{p} {}
+    public:
+      read_guard(const read_guard&) = delete;
+      read_guard& operator=(const read_guard&) = delete;
+      read_guard(read_guard &&other) noexcept : stripe{std::exchange(other.stripe, nullptr)}, parity{other.parity} {}
+      read_guard& operator=(read_guard&&) = delete;
+      ~read_guard() noexcept {
+        if (stripe != nullptr)
+          stripe->active[parity].fetch_sub(1, std::memory_order_release);
+      }
+    };
+
+    class const_iterator {
+    public:
+      using iterator_concept  = std::forward_iterator_tag;
+      using iterator_category = std::forward_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type  = T;
+      using pointer     = const T*;
+      using reference   = const T&;
+    protected:
+      const rcu_node *node{nullptr};  // non-owning plain pointer (null at end)
+      friend class rcu_dbl_lnk_lst;
+      explicit const_iterator(const rcu_node *n) noexcept : node{n} {}
+    public:
+      const_iterator() noexcept = default;
+      const_iterator& operator++() noexcept {
+        node = node->next.load(std::memory_order_acquire);
+        return *this;
+      }
+      const_iterator operator++(int) noexcept { const_iterator tmp = *this; ++(*this); return tmp; }
+      friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept { return a.node == b.node; };
+      reference operator*() const noexcept { return node->value; }
+      pointer operator->() const noexcept { return &node->value; }
+    };
+    using iterator = const_iterator;
+
+    rcu_dbl_lnk_lst() noexcept = default;
+    rcu_dbl_lnk_lst(const rcu_dbl_lnk_lst&) = delete;
+    rcu_dbl_lnk_lst& operator=(const rcu_dbl_lnk_lst&) = delete;
+    ~rcu_dbl_lnk_lst() noexcept;
+    size_t size() const noexcept { return count.load(std::memory_order_relaxed); }
+    bool is_empty() const noexcept { return size() == 0; }
+    read_guard read_lock() const noexcept;
+    // (the calling thread must hold a read_guard for as long as it uses the iterators)
+    const_iterator begin() const noexcept { return const_iterator{head.load(std::memory_order_acquire)}; }
+    const_iterator end() const noexcept { return const_iterator{}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    template <typename F> void for_each(F &&f) const;
+    bool insert(const T& item) noexcept requires std::copy_constructible<T> { return link_new(item, false, nullptr); }
+    bool insert(T &&item) noexcept { return link_new(std::move(item), false, nullptr); }
+    bool insert_at(const T& item, const T&pos) noexcept requires std::copy_constructible<T>
+      { return link_new(item, false, &pos); }
+    bool insert_at(T &&item, const T&pos) noexcept { return link_new(std::move(item), false, &pos); }
+    bool append(const T& item) noexcept requires std::copy_constructible<T> { return link_new(item, true, nullptr); }
+    bool append(T &&item) noexcept { return link_new(std::move(item), true, nullptr); }
+    bool append_at(const T& item, const T&pos) noexcept requires std::copy_constructible<T>
+      { return link_new(item, true, &pos); }
+    bool append_at(T &&item, const T&pos) noexcept { return link_new(std::move(item), true, &pos); }
+    bool delete_at(const T&pos) noexcept;
+    void clear() noexcept;
+    void reclaim() noexcept;
+  };
+
+  /**
+   * @return the reader stripe of the calling thread (threads are dealt stripes round robin)
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  size_t rcu_dbl_lnk_lst<T>::stripe_idx() noexcept {
+    static std::atomic<size_t> next_idx{0};
+    static thread_local const size_t idx = next_idx.fetch_add(1, std::memory_order_relaxed) % nbr_stripes;
+    return idx;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T>
+  void rcu_dbl_lnk_lst<T>::free_chain(rcu_node *first, rcu_node *rcu_node::*const link) noexcept {
+    while (first != nullptr)
+      delete std::exchange(first, first->*link);
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T>
+  rcu_dbl_lnk_lst<T>::~rcu_dbl_lnk_lst() noexcept {
+    // (there can be no readers left by now)
+    for (auto *node = head.load(std::memory_order_relaxed); node != nullptr;)
+      delete std::exchange(node, node->next.load(std::memory_order_relaxed));
+    free_chain(limbo[0], &rcu_node::next_retired);
+    free_chain(limbo[1], &rcu_node::next_retired);
+  }
+
+  /**
+   * Registers the calling thread as a reader of the current epoch - the counter is incremented
+   * before the epoch is checked again, so a writer advancing the epoch in between either sees
+   * this reader or this reader sees the new epoch (and registers again under it).
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  auto rcu_dbl_lnk_lst<T>::read_lock() const noexcept -> read_guard {
+    auto *const stripe = &stripes[stripe_idx()];
+    for (;;) {
+      const auto e = epoch.load(std::memory_order_seq_cst);
+      stripe->active[e & 1].fetch_add(1, std::memory_order_seq_cst);
+      if (epoch.load(std::memory_order_seq_cst) == e)
+        return read_guard{stripe, e & 1};
+      stripe->active[e & 1].fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Visits every item from head to tail within a read section - f must not call a writer
+   * operation of this container (reclaim() in particular would wait on this very section).
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  template <typename F>
+  void rcu_dbl_lnk_lst<T>::for_each(F &&f) const {
+    const auto guard = read_lock();
+    for (const auto &item : *this)
+      f(item);
+  }
+
+  /**
+   * Links node in after pred (at head of list when pred is null) - node is made complete before
+   * the store that publishes it to readers.
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  void rcu_dbl_lnk_lst<T>::link_after(rcu_node *const pred, rcu_node *const node) noexcept {
+    auto &link = pred != nullptr ? pred->next : head;
+    auto *const succ = link.load(std::memory_order_relaxed);
+    node->prev = pred;
+    node->next.store(succ, std::memory_order_relaxed);
+    if (succ != nullptr)
+      succ->prev = node;
+    else
+      tail = node;
+    link.store(node, std::memory_order_release);
+  }
+
+  /**
+   * Unlinks node from list - node's own next link is left as is, for any reader standing on it.
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  void rcu_dbl_lnk_lst<T>::unlink(rcu_node *const node) noexcept {
+    auto *const succ = node->next.load(std::memory_order_relaxed);
+    (node->prev != nullptr ? node->prev->next : head).store(succ, std::memory_order_release);
+    if (succ != nullptr)
+      succ->prev = node->prev;
+    else
+      tail = node->prev;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T>
+  auto rcu_dbl_lnk_lst<T>::find_first(const T&pos) const noexcept -> rcu_node* {
+    for (auto *node = head.load(std::memory_order_relaxed); node != nullptr; node = node->next.load(std::memory_order_relaxed)) {
+      if (node->value == pos)
+        return node;
+    }
+    return nullptr;
+  }
+
+  template <typename T> requires lst_elm_type_constraints<T>
+  auto rcu_dbl_lnk_lst<T>::find_last(const T&pos) const noexcept -> rcu_node* {
+    for (auto *node = tail; node != nullptr; node = node->prev) {
+      if (node->value == pos)
+        return node;
+    }
+    return nullptr;
+  }
+
+  /**
+   * Hands an unlinked node over to deferred reclamation (the writer lock is held).
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  void rcu_dbl_lnk_lst<T>::retire(rcu_node *const node) noexcept {
+    const auto parity = epoch.load(std::memory_order_relaxed) & 1;
+    node->next_retired = limbo[parity];
+    limbo[parity] = node;
+    if (++nbr_limbo[parity] >= retire_batch)
+      try_advance();
+  }
+
+  /**
+   * Advances the epoch from e to e + 1, provided no reader of epoch e - 1 remains (it shares its
+   * parity with e + 1), freeing the nodes retired in epoch e - 1 - only readers of epoch e - 1 or
+   * before registered soon enough to have reached those (the writer lock is held).
+   * @return false when some reader of epoch e - 1 is still in its read section
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  bool rcu_dbl_lnk_lst<T>::try_advance() noexcept {
+    const auto e = epoch.load(std::memory_order_relaxed);
+    const auto old_parity = (e + 1) & 1;
+    for (const auto &stripe : stripes) {
+      if (stripe.active[old_parity].load(std::memory_order_seq_cst) != 0)
+        return false;
+    }
+    free_chain(std::exchange(limbo[old_parity], nullptr), &rcu_node::next_retired);
+    nbr_limbo[old_parity] = 0;
+    epoch.store(e + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  /**
+   * Allocates a node for item and links it in - at head (tail) of list, or in front of the first
+   * (after the last) pos match when pos is given, falling back to appending at tail.
+   * @return returns false when fails to allocate memory for new list item
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  template <typename U>
+  bool rcu_dbl_lnk_lst<T>::link_new(U &&item, const bool at_tail, const T *const pos) noexcept {
+    auto *const node = new (std::nothrow) rcu_node{std::in_place, std::forward<U>(item)};
+    if (node == nullptr)
+      return false;
+    std::scoped_lock lk{writer_mtx};
+    if (pos == nullptr) {
+      link_after(at_tail ? tail : nullptr, node);
+    } else if (auto *const pos_node = at_tail ? find_last(*pos) : find_first(*pos); pos_node == nullptr) {
+      link_after(tail, node);
+    } else {
+      link_after(at_tail ? pos_node : pos_node->prev, node);
+    }
+    count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * Removes a pos specified matched item from list (the first match starting from head of list);
+   * its node is freed once no reader can still be on it.
+   * @tparam T item's type
+   * @param pos item to be removed
+   * @return returns true if item was matched and removed from list
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  bool rcu_dbl_lnk_lst<T>::delete_at(const T&pos) noexcept {
+    std::scoped_lock lk{writer_mtx};
+    auto *const node = find_first(pos);
+    if (node == nullptr)
+      return false;
+    unlink(node);
+    count.fetch_sub(1, std::memory_order_relaxed);
+    retire(node);
+    return true;
+  }
+
+  /**
+   * Empties the list - readers see either the whole list or an empty one.
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  void rcu_dbl_lnk_lst<T>::clear() noexcept {
+    std::scoped_lock lk{writer_mtx};
+    auto *node = head.exchange(nullptr, std::memory_order_acq_rel);
+    tail = nullptr;
+    count.store(0, std::memory_order_relaxed);
+    while (node != nullptr)
+      retire(std::exchange(node, node->next.load(std::memory_order_relaxed)));
+  }
+
+  /**
+   * Frees all nodes retired so far, waiting for the readers that might still be on them to leave
+   * their read sections (so must not be called by a thread holding a read_guard).
+   */
+  template <typename T> requires lst_elm_type_constraints<T>
+  void rcu_dbl_lnk_lst<T>::reclaim() noexcept {
+    std::scoped_lock lk{writer_mtx};
+    while (limbo[0] != nullptr || limbo[1] != nullptr) {
+      if (not try_advance())
+        std::this_thread::yield();
+    }
+  }
+
+} // cust_coll
+
+#endif //RCU_DBL_LNK_LST_HPP
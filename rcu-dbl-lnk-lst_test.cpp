@@ -0,0 +1,173 @@
+//
+// Created by rogerv on 6/1/24.
+//
+#include <list>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "rcu-dbl-lnk-lst.hpp"
+using cust_coll::rcu_dbl_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+static constexpr auto THREAD_NBR = 8;
+
+/**
+ * An item that counts its live instances and carries a check of its own value (which a reader
+ * on a freed node would find broken).
+ */
+struct tracked {
+  static inline std::atomic<int> live{0};
+  int v;
+  int check;
+  explicit tracked(int i) noexcept : v{i}, check{~i} { live++; }
+  tracked(const tracked &oth) noexcept : v{oth.v}, check{oth.check} { live++; }
+  ~tracked() { check = 0; live--; }
+  bool operator==(const tracked &oth) const noexcept { return v == oth.v; }
+  bool intact() const noexcept { return check == ~v; }
+};
+
+template <typename T>
+static std::vector<T> contents_of(const rcu_dbl_lnk_lst<T> &lst) {
+  std::vector<T> items{};
+  lst.for_each([&items](const T &item) { items.push_back(item); });
+  return items;
+}
+
+TEST(RcuDblLnkListAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  rcu_dbl_lnk_lst<some_elm> lst{};  // <<=== rcu-dbl-lnk-list
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_TRUE(contents_of(lst).empty());
+  EXPECT_FALSE(lst.delete_at(some_elm{}));
+  const auto guard = lst.read_lock();
+  EXPECT_EQ(lst.begin(), lst.end());
+}
+
+TEST(RcuDblLnkListAssertions, SingleThreadedOpsMatchStdList) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> op_dist{0, 4}, val_dist{0, 99};
+  rcu_dbl_lnk_lst<int> lst{};  // <<=== rcu-dbl-lnk-list
+  std::list<int> oracle{};
+  for (int i = 0; i < ITEM_NBR; i++) {
+    const int val = val_dist(gen), pos = val_dist(gen);
+    switch (op_dist(gen)) {
+      case 0:
+        EXPECT_TRUE(lst.insert(val));
+        oracle.push_front(val);
+        break;
+      case 1:
+        EXPECT_TRUE(lst.append(val));
+        oracle.push_back(val);
+        break;
+      case 2:
+        EXPECT_TRUE(lst.insert_at(val, pos));
+        oracle.insert(std::find(oracle.begin(), oracle.end(), pos), val);
+        break;
+      case 3: {
+        EXPECT_TRUE(lst.append_at(val, pos));
+        auto it = std::find(oracle.rbegin(), oracle.rend(), pos);
+        oracle.insert(it != oracle.rend() ? it.base() : oracle.end(), val);
+        break;
+      }
+      default: {
+        auto it = std::find(oracle.begin(), oracle.end(), pos);
+        EXPECT_EQ(lst.delete_at(pos), it != oracle.end());
+        if (it != oracle.end())
+          oracle.erase(it);
+      }
+    }
+  }
+  EXPECT_EQ(lst.size(), oracle.size());
+  {
+    const auto guard = lst.read_lock();
+    EXPECT_TRUE(std::ranges::equal(lst, oracle));
+  }
+  lst.clear();
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_TRUE(contents_of(lst).empty());
+}
+
+TEST(RcuDblLnkListAssertions, RetiredNodesOutliveReadSections) {
+  {
+    rcu_dbl_lnk_lst<tracked> lst{};  // <<=== rcu-dbl-lnk-list
+    for (int i = 0; i < ITEM_NBR; i++)
+      ASSERT_TRUE(lst.append(tracked{i}));
+    ASSERT_EQ(tracked::live, ITEM_NBR);
+    {
+      const auto guard = lst.read_lock();
+      auto it = lst.begin();
+      for (int i = 0; i < ITEM_NBR; i++)
+        EXPECT_TRUE(lst.delete_at(tracked{i}));  // (many times the retire batch)
+      EXPECT_TRUE(lst.is_empty());
+      // the reader still walks the list as it was when it stood on its first node
+      for (int i = 0; i < ITEM_NBR; i++, ++it)
+        ASSERT_TRUE(it->v == i && it->intact());
+      EXPECT_EQ(it, lst.end());
+      EXPECT_EQ(tracked::live, ITEM_NBR);  // (none freed while the reader remains)
+    }
+    lst.reclaim();
+    EXPECT_EQ(tracked::live, 0);
+    for (int i = 0; i < ITEM_NBR; i++)
+      ASSERT_TRUE(lst.insert(tracked{i}));
+    lst.clear();
+    lst.reclaim();
+    EXPECT_EQ(tracked::live, 0);
+    for (int i = 0; i < ITEM_NBR; i++)
+      ASSERT_TRUE(lst.insert(tracked{i}));
+  }
+  EXPECT_EQ(tracked::live, 0);
+}
+
+TEST(RcuDblLnkListAssertions, ReadersDuringConcurrentWrites) {
+  rcu_dbl_lnk_lst<tracked> lst{};  // <<=== rcu-dbl-lnk-list
+  constexpr int window = 1000;
+  for (int i = 0; i < window; i++)
+    ASSERT_TRUE(lst.append(tracked{i}));
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers{};
+  std::atomic<int64_t> traversals{0};
+  for (int t = 0; t < THREAD_NBR; t++) {
+    readers.emplace_back([&] {
+      while (not done.load(std::memory_order_relaxed)) {
+        // a traversal sees intact items in increasing order (the writer only appends larger values)
+        int prev = std::numeric_limits<int>::min();
+        bool ordered = true, intact = true;
+        lst.for_each([&](const tracked &item) {
+          ordered = ordered && item.v > prev;
+          intact = intact && item.intact();
+          prev = item.v;
+        });
+        EXPECT_TRUE(ordered);
+        EXPECT_TRUE(intact);
+        traversals++;
+      }
+    });
+  }
+  // the writer slides the window along - appends the next value, deletes the oldest
+  for (int i = window; i < window + ITEM_NBR * 10; i++) {
+    EXPECT_TRUE(lst.append(tracked{i}));
+    EXPECT_TRUE(lst.delete_at(tracked{i - window}));
+    if (i % 1000 == 0) {
+      EXPECT_TRUE(lst.insert_at(tracked{-1}, tracked{i - window + 1}));
+      EXPECT_TRUE(lst.delete_at(tracked{-1}));
+    }
+  }
+  done = true;
+  for (auto &thrd: readers)
+    thrd.join();
+  EXPECT_GT(traversals, 0);
+  EXPECT_EQ(lst.size(), window);
+  lst.reclaim();
+  EXPECT_EQ(tracked::live, window);
+  const auto items = contents_of(lst);
+  for (int i = 0; i < window; i++)
+    EXPECT_EQ(items[i].v, ITEM_NBR * 10 + i);
+}
@@ -0,0 +1,200 @@
+//
+// Created by rogerv on 6/3/24.
+//
+#ifndef SHARDED_DBL_LNK_LST_HPP
+#define SHARDED_DBL_LNK_LST_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <bit>
+#include <algorithm>
+#include <functional>
+#include "dbl-lnk-lst.hpp"
+
+namespace cust_coll {
+
+  /**
+   * A multi-producer append front end to dbl_lnk_lst - each producer thread appends into a shard
+   * of its own (a dbl_lnk_lst segment, on a cache line of its own), so producers don't contend;
+   * collect() stitches the shards together into one dbl_lnk_lst by relinking their head/tail
+   * nodes - O(number of shards), nothing is copied, moved or allocated.
+   *
+   * Threads are dealt shards round robin (of a power of two number of shards); with more
+   * producer threads than shards, some share a shard (its lock, otherwise uncontended, then
+   * serializes them).
+   *
+   * collect() keeps per-producer order - each shard's items follow the previous shard's, in the
+   * order they were appended. collect(seq_of) instead interleaves the items of all shards by a
+   * caller-supplied sequence number seq_of(item) - the shards are merged (stably, by relinking)
+   * in O(n log(number of shards)), after sorting any shard whose items are not already in
+   * sequence (as when producers share a shard).
+   *
+   * Alloc must be safe to allocate from in several threads at once (std::allocator, a
+   * std::pmr::synchronized_pool_resource, ...) - its copies must compare equal.
+   *
+   * @tparam T type of element contained by container - as constrained by
+   *           concept lst_elm_type_constraints
+   * @tparam Alloc allocator type - is rebound to allocate the list nodes
+   */
+  template <typename T, typename Alloc = std::allocator<T>>
+    requires lst_elm_type_constraints<T>
+  class sharded_dbl_lnk_lst {
+  public:
+    using lst_t = dbl_lnk_lst<T, Alloc>;
+  protected:
+    struct alignas(64) shard {  // (one cache line per shard)
+      std::mutex mtx{};
+      lst_t lst;     // appended into by the shard's producers (guarded by mtx)
+      lst_t staged;  // taken over from lst by collect (guarded by collect_mtx)
+      explicit shard(const Alloc &alloc) noexcept : lst{alloc}, staged{alloc} {}
+    };
+    Alloc alloc;
+    std::vector<std::unique_ptr<shard>> shards{};
+    size_t shard_mask{0};  // (number of shards is a power of two)
+    std::mutex collect_mtx{};
+    std::atomic<bool> sealed{false};
+    static size_t thread_idx() noexcept;
+    shard& own_shard() noexcept { return *shards[thread_idx() & shard_mask]; }
+    template <typename F> bool append_into(F &&f) noexcept;
+    void stage() noexcept;
+  public:
+    using allocator_type = Alloc;
+    explicit sharded_dbl_lnk_lst(size_t nbr_shards = std::max(std::thread::hardware_concurrency(), 1u),
+                                 const Alloc &alloc = Alloc{});
+    sharded_dbl_lnk_lst(const sharded_dbl_lnk_lst&) = delete;
+    sharded_dbl_lnk_lst& operator=(const sharded_dbl_lnk_lst&) = delete;
+    ~sharded_dbl_lnk_lst() noexcept = default;
+    size_t nbr_shards() const noexcept { return shards.size(); }
+    size_t size() const noexcept;
+    bool append(const T& item) noexcept requires std::copy_constructible<T>
+      { return append_into([&item](lst_t &lst) noexcept { return lst.append(item); }); }
+    bool append(T &&item) noexcept
+      { return append_into([&item](lst_t &lst) noexcept { return lst.append(std::move(item)); }); }
+    template <typename... Args> bool emplace_back(Args&&... args) noexcept
+      { return append_into([&args...](lst_t &lst) noexcept { return lst.emplace_back(std::forward<Args>(args)...); }); }
+    lst_t collect() noexcept;
+    template <typename SeqOf> lst_t collect(SeqOf seq_of) noexcept;
+    lst_t seal() noexcept { sealed = true; return collect(); }
+    template <typename SeqOf> lst_t seal(SeqOf seq_of) noexcept { sealed = true; return collect(std::move(seq_of)); }
+    bool is_sealed() const noexcept { return sealed.load(std::memory_order_relaxed); }
+  };
+
+  /**
+   * Allocates the shards - nbr_shards rounded up to a power of two - throws std::bad_alloc should
+   * that fail.
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  sharded_dbl_lnk_lst<T, Alloc>::sharded_dbl_lnk_lst(const size_t nbr_shards, const Alloc &alloc) : alloc{alloc} {
+    const auto nbr = std::bit_ceil(std::max<size_t>(nbr_shards, 1));
+    shards.reserve(nbr);
+    for (size_t i = 0; i < nbr; i++)
+      shards.push_back(std::make_unique<shard>(alloc));
+    shard_mask = nbr - 1;
+  }
+
+  /**
+   * @return the shard index of the calling thread (threads are dealt indices round robin)
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  size_t sharded_dbl_lnk_lst<T, Alloc>::thread_idx() noexcept {
+    static std::atomic<size_t> next_idx{0};
+    static thread_local const size_t idx = next_idx.fetch_add(1, std::memory_order_relaxed);
+    return idx;
+  }
+
+  /**
+   * @return number of items appended and not yet collected (a snapshot, when producers are busy)
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  size_t sharded_dbl_lnk_lst<T, Alloc>::size() const noexcept {
+    size_t nbr = 0;
+    for (const auto &s : shards) {
+      std::scoped_lock lk{s->mtx};
+      nbr += s->lst.size();
+    }
+    return nbr;
+  }
+
+  /**
+   * Appends an item (by f(lst)) at tail of the calling thread's shard. sealed is checked again
+   * once the shard lock is held - seal() sets it before stage() takes each shard lock, so an item
+   * is either appended ahead of the staging (and collected by seal()) or refused.
+   * @return returns false when sealed or fails to allocate memory for new list item
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  template <typename F>
+  bool sharded_dbl_lnk_lst<T, Alloc>::append_into(F &&f) noexcept {
+    if (sealed.load(std::memory_order_relaxed))
+      return false;
+    auto &s = own_shard();
+    std::scoped_lock lk{s.mtx};
+    if (sealed.load(std::memory_order_relaxed))  // (ordered by the shard lock)
+      return false;
+    return f(s.lst);
+  }
+
+  /**
+   * Takes over the items of every shard into its staged list - holding each shard's lock just
+   * for an O(1) splice (the collect lock is held).
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  void sharded_dbl_lnk_lst<T, Alloc>::stage() noexcept {
+    for (auto &s : shards) {
+      std::scoped_lock lk{s->mtx};
+      s->staged.splice_back(s->lst);
+    }
+  }
+
+  /**
+   * Takes all the items appended so far, shard after shard (so the items of each producer stay
+   * in the order they were appended) - O(number of shards). Producers may carry on appending
+   * meanwhile (their items go into this collect() or the next).
+   * @return the items collected
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  auto sharded_dbl_lnk_lst<T, Alloc>::collect() noexcept -> lst_t {
+    std::scoped_lock lk{collect_mtx};
+    stage();
+    lst_t collected{alloc};
+    for (auto &s : shards)
+      collected.splice_back(s->staged);
+    return collected;
+  }
+
+  /**
+   * Takes all the items appended so far, interleaved in order of seq_of(item) - items of equal
+   * sequence number keep the order of their shards. The shards are merged pairwise, in
+   * log2(number of shards) rounds.
+   * @param seq_of sequence number of an item (of any type ordered by operator<)
+   * @return the items collected
+   */
+  template <typename T, typename Alloc>
+    requires lst_elm_type_constraints<T>
+  template <typename SeqOf>
+  auto sharded_dbl_lnk_lst<T, Alloc>::collect(SeqOf seq_of) noexcept -> lst_t {
+    const auto by_seq = [&seq_of](const T &a, const T &b) { return std::invoke(seq_of, a) < std::invoke(seq_of, b); };
+    std::scoped_lock lk{collect_mtx};
+    stage();
+    for (auto &s : shards) {
+      if (not std::ranges::is_sorted(s->staged, by_seq))
+        s->staged.sort(by_seq);
+    }
+    for (size_t stride = 1; stride < shards.size(); stride *= 2) {
+      for (size_t i = 0; i + stride < shards.size(); i += 2 * stride)
+        shards[i]->staged.merge(shards[i + stride]->staged, by_seq);
+    }
+    return std::move(shards[0]->staged);
+  }
+
+} // cust_coll
+
+#endif //SHARDED_DBL_LNK_LST_HPP
@@ -0,0 +1,137 @@
+//
+// Created by rogerv on 6/3/24.
+//
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <ranges>
+#include <numeric>
+#include <algorithm>
+#include <memory_resource>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "sharded-dbl-lnk-lst.hpp"
+using cust_coll::sharded_dbl_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+static constexpr auto THREAD_NBR = 8;
+
+/**
+ * An item stamped with its producer and a sequence number.
+ */
+struct stamped {
+  int producer;
+  int64_t seq;
+  bool operator==(const stamped&) const = default;
+};
+
+TEST(ShardedDblLnkListAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  sharded_dbl_lnk_lst<some_elm> lst{};  // <<=== sharded-dbl-lnk-list
+  EXPECT_GE(lst.nbr_shards(), 1);
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_FALSE(lst.is_sealed());
+  EXPECT_TRUE(lst.collect().is_empty());
+  EXPECT_TRUE(lst.collect([](const some_elm &elm) { return elm.s; }).is_empty());
+}
+
+TEST(ShardedDblLnkListAssertions, SingleProducerCollectAndSeal) {
+  sharded_dbl_lnk_lst<some_elm> lst{4};  // <<=== sharded-dbl-lnk-list
+  std::vector<some_elm> strs{ITEM_NBR};
+  for (const auto &elm : strs)
+    EXPECT_TRUE(lst.append(elm));
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  auto collected = lst.collect();
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(std::ranges::equal(collected, strs));
+
+  // the front end stays open after collect(), not after seal()
+  EXPECT_TRUE(lst.emplace_back());
+  some_elm item{};
+  const some_elm sav_item{item};
+  EXPECT_TRUE(lst.append(std::move(item)));
+  auto rest = lst.seal();
+  EXPECT_TRUE(lst.is_sealed());
+  EXPECT_EQ(rest.size(), 2);
+  EXPECT_EQ(*++rest.begin(), sav_item);
+  EXPECT_FALSE(lst.append(sav_item));
+  EXPECT_TRUE(lst.collect().is_empty());
+}
+
+TEST(ShardedDblLnkListAssertions, ConcurrentProducersKeepTheirOrder) {
+  sharded_dbl_lnk_lst<stamped> lst{THREAD_NBR / 2};  // <<=== sharded-dbl-lnk-list (so producers share shards)
+  std::vector<std::thread> producers{};
+  for (int t = 0; t < THREAD_NBR; t++) {
+    producers.emplace_back([&lst, t] {
+      for (int i = 0; i < ITEM_NBR; i++)
+        EXPECT_TRUE(lst.append(stamped{t, i}));
+    });
+  }
+  // collecting while the producers are busy takes whatever has been appended so far
+  auto collected = lst.collect();
+  for (auto &thrd: producers)
+    thrd.join();
+  auto rest = lst.seal();
+  collected.splice_back(rest);
+  ASSERT_EQ(collected.size(), ITEM_NBR * THREAD_NBR);
+  std::vector<int64_t> next_seq(THREAD_NBR, 0);
+  for (const auto &item : collected)
+    ASSERT_EQ(item.seq, next_seq[item.producer]++);
+}
+
+TEST(ShardedDblLnkListAssertions, InterleaveBySequenceNumber) {
+  std::pmr::synchronized_pool_resource pool{};
+  sharded_dbl_lnk_lst<stamped, std::pmr::polymorphic_allocator<stamped>> lst{3, &pool};  // <<=== sharded-dbl-lnk-list
+  std::atomic<int64_t> seq{0};
+  std::vector<std::thread> producers{};
+  for (int t = 0; t < THREAD_NBR; t++) {
+    producers.emplace_back([&lst, &seq, t] {
+      for (int i = 0; i < ITEM_NBR / THREAD_NBR; i++)
+        EXPECT_TRUE(lst.append(stamped{t, seq++}));  // (not appended in seq order across threads)
+    });
+  }
+  for (auto &thrd: producers)
+    thrd.join();
+  const auto collected = lst.seal(&stamped::seq);
+  ASSERT_EQ(collected.size(), (ITEM_NBR / THREAD_NBR) * THREAD_NBR);
+  EXPECT_TRUE(std::ranges::equal(collected | std::views::transform(&stamped::seq),
+                                 std::views::iota(int64_t{0}, static_cast<int64_t>(collected.size()))));
+
+  // equal sequence numbers keep shard order
+  sharded_dbl_lnk_lst<stamped> ties{2};  // <<=== sharded-dbl-lnk-list
+  std::thread{[&ties] { ties.append(stamped{0, 1}); ties.append(stamped{0, 2}); }}.join();
+  std::thread{[&ties] { ties.append(stamped{1, 1}); ties.append(stamped{1, 2}); }}.join();
+  const auto merged = ties.collect([](const stamped &s) { return s.seq; });
+  EXPECT_EQ(merged.size(), 4);
+  auto it = merged.begin();
+  const int first_producer = it->producer;
+  EXPECT_EQ((++it)->producer, 1 - first_producer);
+  EXPECT_EQ((++it)->producer, first_producer);
+}
+
+TEST(ShardedDblLnkListAssertions, SealWhileProducersAppend) {
+  for (int round = 0; round < 20; round++) {
+    sharded_dbl_lnk_lst<stamped> lst{THREAD_NBR / 2};  // <<=== sharded-dbl-lnk-list
+    std::atomic<int> nbr_started{0};
+    std::vector<int64_t> nbr_appended(THREAD_NBR, 0);
+    std::vector<std::thread> producers{};
+    for (int t = 0; t < THREAD_NBR; t++) {
+      producers.emplace_back([&lst, &nbr_started, &nbr_appended, t] {
+        nbr_started++;
+        for (int i = 0; i < ITEM_NBR && lst.append(stamped{t, i}); i++)
+          nbr_appended[t]++;
+      });
+    }
+    while (nbr_started < THREAD_NBR)
+      std::this_thread::yield();
+    // every append that reported success is in the sealed result - nothing is left behind
+    const auto sealed = lst.seal();
+    for (auto &thrd: producers)
+      thrd.join();
+    EXPECT_EQ(static_cast<int64_t>(sealed.size()), std::accumulate(nbr_appended.begin(), nbr_appended.end(), int64_t{0}));
+    EXPECT_EQ(lst.size(), 0);
+    EXPECT_TRUE(lst.collect().is_empty());
+  }
+}
@@ -0,0 +1,278 @@
+//
+// Created by rogerv on 6/4/24.
+//
+#ifndef SMALL_DBL_LNK_LST_HPP
+#define SMALL_DBL_LNK_LST_HPP
+
+#include <new>
+#include <bit>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include "dbl-lnk-lst.hpp"
+
+namespace cust_coll {
+
+  /**
+   * N node sized slots of storage, handed out and taken back by an inline_first_allocator - a bit
+   * of slot_mask is set for each slot in use.
+   *
+   * Is neither copyable nor movable (allocators refer to it by address).
+   *
+   * @tparam Size slot size (bytes)
+   * @tparam Align slot alignment
+   * @tparam N number of slots (at most 64)
+   */
+  template <size_t Size, size_t Align, size_t N>
+  class inline_arena {
+    static_assert(N > 0 && N <= 64, "an inline_arena has from 1 to 64 slots");
+    static constexpr uint64_t full_mask = N == 64 ? ~uint64_t{0} : (uint64_t{1} << N) - 1;
+    alignas(Align) std::byte slots[N][Size];
+    uint64_t slot_mask{0};
+  public:
+    static constexpr size_t slot_size = Size;
+    static constexpr size_t slot_align = Align;
+    static constexpr size_t nbr_slots = N;
+    inline_arena() noexcept = default;
+    inline_arena(const inline_arena&) = delete;
+    inline_arena& operator=(const inline_arena&) = delete;
+    /**
+     * @return the lowest free slot, or null when all are in use
+     */
+    void* take_slot() noexcept {
+      if (slot_mask == full_mask)
+        return nullptr;
+      const auto i = std::countr_one(slot_mask);
+      slot_mask |= uint64_t{1} << i;
+      return slots[i];
+    }
+    void give_back_slot(void *const p) noexcept {
+      const auto i = static_cast<size_t>(static_cast<std::byte*>(p) - slots[0]) / Size;
+      slot_mask &= ~(uint64_t{1} << i);
+    }
+    /**
+     * @return true when p points into one of the slots (std::less gives a total order over
+     *         unrelated pointers)
+     */
+    bool holds(const void *const p) const noexcept {
+      const auto *const b = static_cast<const std::byte*>(p);
+      return not std::less<const std::byte*>{}(b, slots[0]) && std::less<const std::byte*>{}(b, slots[0] + sizeof(slots));
+    }
+    size_t slots_in_use() const noexcept { return static_cast<size_t>(std::popcount(slot_mask)); }
+  };
+
+  /**
+   * A std::allocator compatible allocator that services single-object allocations from the free
+   * slots of an inline_arena, falling back to the Upstream allocator once they are all in use (or
+   * for array allocations, or an object that doesn't fit a slot). Deallocation gives a slot back
+   * to the arena, anything else to Upstream.
+   *
+   * Copies (including rebound copies) share the same arena - which must outlive them. Two
+   * allocators compare equal only when they share an arena (and their upstreams compare equal).
+   *
+   * @tparam T type allocated
+   * @tparam Arena an inline_arena
+   * @tparam Upstream allocator for what the arena can't take
+   */
+  template <typename T, typename Arena, typename Upstream = std::allocator<T>>
+  class inline_first_allocator {
+    template <typename U, typename A, typename UU> friend class inline_first_allocator;
+    using upstream_traits = std::allocator_traits<Upstream>;
+    Arena *arena;  // non-owning plain pointer
+    [[no_unique_address]] Upstream upstream_alloc;
+    static constexpr bool fits_slot = sizeof(T) <= Arena::slot_size && alignof(T) <= Arena::slot_align;
+  public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+    template <typename U> struct rebind {
+      using other = inline_first_allocator<U, Arena, typename upstream_traits::template rebind_alloc<U>>;
+    };
+
+    explicit inline_first_allocator(Arena *arena, const Upstream &upstream = Upstream{}) noexcept
+      : arena{arena}, upstream_alloc{upstream} {}
+    inline_first_allocator(const inline_first_allocator&) noexcept = default;
+    template <typename U, typename UU>
+    inline_first_allocator(const inline_first_allocator<U, Arena, UU> &oth) noexcept
+      : arena{oth.arena}, upstream_alloc{oth.upstream_alloc} {}
+    inline_first_allocator& operator=(const inline_first_allocator&) noexcept = default;
+
+    T* allocate(size_t n) {
+      if constexpr (fits_slot) {
+        if (n == 1) {
+          if (auto *const p = arena->take_slot(); p != nullptr)
+            return static_cast<T*>(p);
+        }
+      }
+      return upstream_traits::allocate(upstream_alloc, n);
+    }
+    void deallocate(T *const p, size_t n) noexcept {
+      if (fits_slot && n == 1 && arena->holds(p))
+        arena->give_back_slot(p);
+      else
+        upstream_traits::deallocate(upstream_alloc, p, n);
+    }
+    const Upstream& upstream() const noexcept { return upstream_alloc; }
+
+    friend bool operator==(const inline_first_allocator &a, const inline_first_allocator &b) noexcept
+      { return a.arena == b.arena && a.upstream_alloc == b.upstream_alloc; }
+  };
+
+  /**
+   * A dbl_lnk_lst whose first N nodes live in storage inside the list object itself - a list that
+   * never holds more than N items makes no heap allocation at all. Past N the nodes are allocated
+   * from Alloc, and a node freed from the inline storage is reused before the heap is gone to
+   * again. Nodes never move, so iterators, references and links stay valid across the spill to
+   * the heap (as with any dbl_lnk_lst).
+   *
+   * Is built on a dbl_lnk_lst (whose node allocator is an inline_first_allocator over the inline
+   * storage) and has its API - but for what would hand inline nodes over from one list object to
+   * another: swap, splice/splice_back/concat/merge and node handles (extract and the node handle
+   * insert/append) are not offered.
+   *
+   * Moving a small_dbl_lnk_lst relinks its heap nodes into the destination and moves the items of
+   * its inline nodes into inline nodes of the destination - so allocates nothing, and can't fail,
+   * when the two Alloc compare equal (as they always do for move construction). Move assignment
+   * between lists of unequal Alloc moves every item into a newly allocated node - should that
+   * allocation fail, std::bad_alloc is thrown (the items not yet moved remain in the source).
+   *
+   * @tparam T type of element contained by container - as constrained by
+   *           concept lst_elm_type_constraints
+   * @tparam N number of nodes stored inline (at most 64)
+   * @tparam Alloc allocator type - is rebound to allocate the list nodes past the first N
+   */
+  template <typename T, size_t N = 8, typename Alloc = std::allocator<T>>
+    requires lst_elm_type_constraints<T>
+  class small_dbl_lnk_lst
+    : private inline_arena<sizeof(lst_node<T>), alignof(lst_node<T>), N>,  // (constructed ahead of the list)
+      protected dbl_lnk_lst<T, inline_first_allocator<T, inline_arena<sizeof(lst_node<T>), alignof(lst_node<T>), N>, Alloc>> {
+  protected:
+    using arena_t = inline_arena<sizeof(lst_node<T>), alignof(lst_node<T>), N>;
+    using alloc_t = inline_first_allocator<T, arena_t, Alloc>;
+    using base = dbl_lnk_lst<T, alloc_t>;
+    // (the arena base is constructed ahead of the list base - so may be pointed at by its allocator)
+    static alloc_t inline_first(arena_t *arena, const Alloc &alloc) noexcept { return alloc_t{arena, alloc}; }
+    bool take_items(small_dbl_lnk_lst &other) noexcept;
+  public:
+    using typename base::allocator_type;
+    using typename base::iterator;
+    using typename base::const_iterator;
+    using typename base::reverse_iterator;
+    using typename base::const_reverse_iterator;
+    small_dbl_lnk_lst() noexcept : base{inline_first(this, Alloc{})} {}
+    explicit small_dbl_lnk_lst(const Alloc &alloc) noexcept : base{inline_first(this, alloc)} {}
+    template <lst_compatible_range<T> R> requires (not std::same_as<std::remove_cvref_t<R>, small_dbl_lnk_lst>)
+    explicit small_dbl_lnk_lst(R &&rng, const Alloc &alloc = Alloc{}) noexcept : base{inline_first(this, alloc)}
+      { base::append_range(std::forward<R>(rng)); }
+    small_dbl_lnk_lst(const small_dbl_lnk_lst&) = delete;
+    small_dbl_lnk_lst& operator=(const small_dbl_lnk_lst&) = delete;
+    small_dbl_lnk_lst(small_dbl_lnk_lst &&other) noexcept;
+    small_dbl_lnk_lst& operator=(small_dbl_lnk_lst &&other);
+    ~small_dbl_lnk_lst() noexcept = default;
+    void swap(small_dbl_lnk_lst &other) noexcept = delete;
+    friend void swap(small_dbl_lnk_lst &a, small_dbl_lnk_lst &b) noexcept = delete;
+    using base::get_allocator;
+    using base::size;
+    using base::is_empty;
+    using base::insert;
+    using base::insert_at;
+    using base::append;
+    using base::append_at;
+    using base::emplace_front;
+    using base::emplace_back;
+    using base::emplace_at;
+    using base::emplace_after;
+    using base::delete_at;
+    using base::remove_if;
+    using base::remove;
+    using base::delete_many;
+    using base::insert_range;
+    using base::insert_range_at;
+    using base::append_range;
+    using base::clear;
+    using base::begin;
+    using base::end;
+    using base::cbegin;
+    using base::cend;
+    using base::rbegin;
+    using base::rend;
+    using base::crbegin;
+    using base::crend;
+    using base::insert_before;
+    using base::insert_after;
+    using base::erase;
+    using base::sort;
+    using base::parallel_sort;
+    // (node handles could carry an inline node off - the overloads brought in above are withdrawn)
+    bool insert(typename base::node_type &&nh) noexcept = delete;
+    bool append(typename base::node_type &&nh) noexcept = delete;
+    static constexpr size_t inline_capacity() noexcept { return N; }
+    // number of items held in inline storage (the rest are on the heap)
+    size_t nbr_inline() const noexcept { return arena_t::slots_in_use(); }
+  };
+
+  /**
+   * Takes over the items of other (in order) into this empty list - a heap node is relinked when
+   * the two Alloc compare equal, an item in an inline node (or in a heap node of an unequal
+   * Alloc) is moved into a new node of this list. Relinked heap nodes take up no inline slot, so
+   * each inline node of other finds a free inline slot here.
+   * @return false when fails to allocate a new node (the items not yet taken remain in other)
+   */
+  template <typename T, size_t N, typename Alloc> requires lst_elm_type_constraints<T>
+  bool small_dbl_lnk_lst<T, N, Alloc>::take_items(small_dbl_lnk_lst &other) noexcept {
+    assert(this->head == nullptr); // (we trust but verify)
+    const bool relink = this->node_alloc.upstream() == other.node_alloc.upstream();
+    const arena_t &other_arena = other;
+    while (other.head != nullptr) {
+      auto *node = other.head;
+      if (not relink || other_arena.holds(node)) {
+        auto *const new_node = this->new_node(std::move(node->value));
+        if (new_node == nullptr)
+          return false;
+        other.unlink(node);
+        other.free_node(node);
+        node = new_node;
+      } else {
+        other.unlink(node);
+      }
+      other.count--;
+      this->append_at_tail(node);
+      this->count++;
+    }
+    return true;
+  }
+
+  /**
+   * Takes over the items of other - the upstream allocator is copied from other, so this can't
+   * fail (see take_items()); other is left empty.
+   * @tparam T item's type
+   */
+  template <typename T, size_t N, typename Alloc> requires lst_elm_type_constraints<T>
+  small_dbl_lnk_lst<T, N, Alloc>::small_dbl_lnk_lst(small_dbl_lnk_lst &&other) noexcept
+    : base{inline_first(this, Alloc{other.node_alloc.upstream()})} {
+    [[maybe_unused]] const bool taken = take_items(other);
+    assert(taken); // (we trust but verify)
+  }
+
+  /**
+   * Frees the items of this list then takes over the items of other (this list keeps its own
+   * upstream allocator) - throws std::bad_alloc should a node fail to allocate, in which case the
+   * items not yet taken remain in other.
+   * @tparam T item's type
+   */
+  template <typename T, size_t N, typename Alloc> requires lst_elm_type_constraints<T>
+  auto small_dbl_lnk_lst<T, N, Alloc>::operator=(small_dbl_lnk_lst &&other) -> small_dbl_lnk_lst& {
+    if (&other == this)
+      return *this;
+    base::clear();
+    if (not take_items(other))
+      throw std::bad_alloc{};
+    return *this;
+  }
+
+} // cust_coll
+
+#endif //SMALL_DBL_LNK_LST_HPP
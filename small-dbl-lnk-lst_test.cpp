@@ -0,0 +1,184 @@
+//
+// Created by rogerv on 6/4/24.
+//
+#include <list>
+#include <vector>
+#include <random>
+#include <ranges>
+#include <algorithm>
+#include <memory_resource>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "small-dbl-lnk-lst.hpp"
+using cust_coll::small_dbl_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+
+/**
+ * A std::allocator that counts the allocations and deallocations made through it.
+ */
+template <typename T>
+struct counting_allocator : std::allocator<T> {
+  static inline int64_t nbr_allocs{0};
+  static inline int64_t nbr_deallocs{0};
+  using value_type = T;
+  template <typename U> struct rebind { using other = counting_allocator<U>; };
+  counting_allocator() noexcept = default;
+  template <typename U> counting_allocator(const counting_allocator<U>&) noexcept {}
+  T* allocate(size_t n) { nbr_allocs++; return std::allocator<T>::allocate(n); }
+  void deallocate(T *const p, size_t n) noexcept { nbr_deallocs++; std::allocator<T>::deallocate(p, n); }
+  friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept { return true; }
+};
+// (each rebound type keeps counts of its own - the node type's are the ones of interest)
+static int64_t heap_allocs() { return counting_allocator<cust_coll::lst_node<some_elm>>::nbr_allocs; }
+static int64_t heap_deallocs() { return counting_allocator<cust_coll::lst_node<some_elm>>::nbr_deallocs; }
+
+TEST(SmallDblLnkListAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  small_dbl_lnk_lst<some_elm> lst{};  // <<=== small-dbl-lnk-list
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(lst.nbr_inline(), 0);
+  EXPECT_EQ(lst.inline_capacity(), 8);
+  EXPECT_EQ(lst.begin(), lst.end());
+  EXPECT_FALSE(lst.delete_at(some_elm{}));
+}
+
+TEST(SmallDblLnkListAssertions, NoHeapAllocationUpToInlineCapacity) {
+  constexpr size_t N = 4;
+  const auto allocs_before = heap_allocs();
+  {
+    small_dbl_lnk_lst<some_elm, N, counting_allocator<some_elm>> lst{};  // <<=== small-dbl-lnk-list
+    std::vector<some_elm> strs{N * 2};
+    for (size_t i = 0; i < N; i++)
+      EXPECT_TRUE(lst.append(strs[i]));
+    EXPECT_EQ(heap_allocs(), allocs_before);
+    EXPECT_EQ(lst.nbr_inline(), N);
+
+    // iterators and references taken before the spill stay valid across it
+    auto first = lst.begin();
+    auto &last_inline = *std::next(lst.begin(), N - 1);
+    for (size_t i = N; i < strs.size(); i++)
+      EXPECT_TRUE(lst.append(strs[i]));
+    EXPECT_EQ(heap_allocs(), allocs_before + static_cast<int64_t>(N));
+    EXPECT_EQ(lst.nbr_inline(), N);
+    EXPECT_EQ(*first, strs[0]);
+    EXPECT_EQ(&last_inline, &*std::next(lst.begin(), N - 1));
+    EXPECT_EQ(*++std::next(first, N - 1), strs[N]);
+    EXPECT_EQ(*--std::next(first, N), strs[N - 1]);
+    EXPECT_TRUE(std::ranges::equal(lst, strs));
+    EXPECT_TRUE(std::ranges::equal(lst | std::views::reverse, strs | std::views::reverse));
+
+    // a freed inline node is reused ahead of the heap
+    EXPECT_TRUE(lst.delete_at(strs[1]));
+    EXPECT_EQ(lst.nbr_inline(), N - 1);
+    EXPECT_TRUE(lst.insert(strs[1]));
+    EXPECT_EQ(lst.nbr_inline(), N);
+    EXPECT_EQ(heap_allocs(), allocs_before + static_cast<int64_t>(N));
+
+    lst.clear();
+    EXPECT_EQ(lst.nbr_inline(), 0);
+    EXPECT_EQ(heap_deallocs(), heap_allocs());
+    EXPECT_TRUE(lst.emplace_back());
+    EXPECT_EQ(lst.nbr_inline(), 1);
+  }
+  EXPECT_EQ(heap_deallocs(), heap_allocs());
+}
+
+TEST(SmallDblLnkListAssertions, RandomOpsMatchStdList) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> op_dist{0, 5}, val_dist{0, 15};
+  small_dbl_lnk_lst<int, 6> lst{};  // <<=== small-dbl-lnk-list
+  std::list<int> oracle{};
+  for (int i = 0; i < ITEM_NBR; i++) {
+    const int val = val_dist(gen), pos = val_dist(gen);
+    const auto op = op_dist(gen);
+    const auto nbr_inline = lst.nbr_inline();
+    switch (op) {
+      case 0:
+        EXPECT_TRUE(lst.insert(val));
+        oracle.push_front(val);
+        break;
+      case 1:
+        EXPECT_TRUE(lst.append(val));
+        oracle.push_back(val);
+        break;
+      case 2:
+        EXPECT_TRUE(lst.insert_at(val, pos));
+        oracle.insert(std::find(oracle.begin(), oracle.end(), pos), val);
+        break;
+      case 3:
+        EXPECT_EQ(lst.remove(pos), static_cast<size_t>(std::erase(oracle, pos)));
+        break;
+      default: {
+        auto it = std::find(oracle.begin(), oracle.end(), pos);
+        EXPECT_EQ(lst.delete_at(pos), it != oracle.end());
+        if (it != oracle.end())
+          oracle.erase(it);
+      }
+    }
+    ASSERT_EQ(lst.size(), oracle.size());
+    if (op < 3) {  // (a free inline slot is always taken ahead of the heap)
+      ASSERT_EQ(lst.nbr_inline(), std::min(nbr_inline + 1, lst.inline_capacity()));
+    }
+    ASSERT_LE(lst.nbr_inline(), lst.size());
+  }
+  EXPECT_TRUE(std::ranges::equal(lst, oracle));
+  lst.sort();
+  oracle.sort();
+  EXPECT_TRUE(std::ranges::equal(lst, oracle));
+}
+
+TEST(SmallDblLnkListAssertions, MoveRelinksHeapNodes) {
+  std::pmr::unsynchronized_pool_resource pool{};
+  using lst_t = small_dbl_lnk_lst<some_elm, 3, std::pmr::polymorphic_allocator<some_elm>>;
+  std::vector<some_elm> strs{5};
+  lst_t lst{strs, &pool};  // <<=== small-dbl-lnk-list
+  EXPECT_EQ(lst.get_allocator().upstream().resource(), &pool);
+  const auto *const heap_item = &*std::prev(lst.end());
+
+  // moving moves the inline items into the destination's own inline nodes, relinks the heap ones
+  lst_t moved{std::move(lst)};  // <<=== small-dbl-lnk-list
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_EQ(lst.nbr_inline(), 0);
+  EXPECT_EQ(moved.nbr_inline(), 3);
+  EXPECT_EQ(moved.get_allocator().upstream().resource(), &pool);
+  EXPECT_TRUE(std::ranges::equal(moved, strs));
+  EXPECT_EQ(&*std::prev(moved.end()), heap_item);
+  EXPECT_TRUE(lst.append(strs[0]));  // (the moved from list is still good for more)
+  EXPECT_EQ(lst.nbr_inline(), 1);
+
+  lst_t assigned{&pool};  // <<=== small-dbl-lnk-list
+  EXPECT_TRUE(assigned.append(some_elm{}));
+  assigned = std::move(moved);
+  EXPECT_TRUE(moved.is_empty());
+  EXPECT_TRUE(std::ranges::equal(assigned, strs));
+  EXPECT_EQ(&*std::prev(assigned.end()), heap_item);
+  std::vector<lst_t> lsts(4);
+  lsts.emplace_back(strs, &pool);  // (reallocation moves the lists)
+  EXPECT_TRUE(std::ranges::equal(lsts.back(), strs));
+
+  // with unequal upstreams every item is moved into a node of the destination's own
+  std::pmr::unsynchronized_pool_resource other_pool{};
+  lst_t other{&other_pool};  // <<=== small-dbl-lnk-list
+  other = std::move(assigned);
+  EXPECT_TRUE(assigned.is_empty());
+  EXPECT_EQ(other.get_allocator().upstream().resource(), &other_pool);
+  EXPECT_TRUE(std::ranges::equal(other, strs));
+  EXPECT_NE(&*std::prev(other.end()), heap_item);
+}
+
+// inline nodes can't change hands between list objects - so the APIs that would are not offered
+template <typename L> concept splices = requires(L &a, L &b) { a.splice_back(b); };
+template <typename L> concept merges = requires(L &a, L &b) { a.merge(b); };
+template <typename L> concept extracts = requires(L &a) { a.extract(a.begin()); };
+template <typename L> concept converts_to_base = requires(L &a) { [](cust_coll::dbl_lnk_lst<int, typename L::allocator_type>&){}(a); };
+using small_lst_t = small_dbl_lnk_lst<int>;
+static_assert(std::is_nothrow_move_constructible_v<small_lst_t>);
+static_assert(not std::is_swappable_v<small_lst_t>);
+static_assert(not splices<small_lst_t> && not merges<small_lst_t> && not extracts<small_lst_t>);
+static_assert(not converts_to_base<small_lst_t>);
+static_assert(splices<cust_coll::dbl_lnk_lst<int>> && extracts<cust_coll::dbl_lnk_lst<int>>);
+static_assert(std::ranges::bidirectional_range<small_lst_t>);
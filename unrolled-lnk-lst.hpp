@@ -0,0 +1,478 @@
+//
+// Created by rogerv on 5/14/24.
+//
+#ifndef UNROLLED_LNK_LST_HPP
+#define UNROLLED_LNK_LST_HPP
+
+#include <new>
+#include <memory>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <iterator>
+#include <bit>
+#include <utility>
+#include <functional>
+#include "dbl-lnk-lst.hpp"
+#include "lst-fingerprints.hpp"
+
+namespace cust_coll {
+
+  static constexpr size_t cache_line_size = 64;
+
+  /**
+   * Default number of elements per unrolled node - as many as fit into a cache line alongside
+   * the node's links and element count (but no fewer than 4).
+   */
+  template <typename T>
+  consteval size_t unrolled_default_n() {
+    constexpr size_t hdr_size = 2 * sizeof(void*) + sizeof(size_t);
+    return std::max<size_t>(sizeof(T) < cache_line_size - hdr_size ? (cache_line_size - hdr_size) / sizeof(T) : 0, 4);
+  }
+
+  /**
+   * An unrolled doubly-linked-list - each (cache line aligned) node holds up to N elements in
+   * contiguous storage, so scanning the list is mostly a sweep through arrays instead of chasing
+   * a pointer per element.
+   *
+   * Has the same API as dbl_lnk_lst (insert/insert_at/append/append_at/delete_at/clear and
+   * its bidirectional iterators) so can be switched in via a typedef. Nodes are split when
+   * inserting into a full node and merged with a neighbour when deleting leaves a node half empty.
+   *
+   * @tparam T type of element contained by container - as constrained by
+   *           concept lst_elm_type_constraints
+   * @tparam N maximum number of elements per node
+   * @tparam Fingerprints search policy - no_fingerprints (the default), or hash_fingerprints<Hash>
+   *                      to have searches compare per node fingerprints before T::operator== (see
+   *                      lst-fingerprints.hpp and fingerprinted_lnk_lst)
+   */
+  template <typename T, size_t N = unrolled_default_n<T>(), typename Fingerprints = no_fingerprints>
+    requires lst_elm_type_constraints<T> && (N > 0)
+  class unrolled_lnk_lst {
+    static_assert(not Fingerprints::enabled || N <= 64, "a fingerprinted node holds at most 64 elements");
+  protected:
+    struct alignas(cache_line_size) unrl_node {
+      unrl_node *prev{nullptr};  // non-owning plain pointer
+      unrl_node *next{nullptr};  // owning plain pointer
+      size_t nbr{0};             // number of elements held in this node
+      [[no_unique_address]] typename Fingerprints::template block<N> fps{};
+      alignas(T) std::byte store[sizeof(T) * N];
+      unrl_node() noexcept = default;
+      unrl_node(const unrl_node&) = delete;
+      unrl_node& operator=(const unrl_node&) = delete;
+      ~unrl_node() noexcept { std::destroy_n(elms(), nbr); }
+      T* elms() noexcept { return std::launder(reinterpret_cast<T*>(store)); }
+      T& operator[](size_t i) noexcept { return elms()[i]; }
+      // true when p points into this node's element storage (std::less gives a total order over
+      // unrelated pointers)
+      bool holds(const T *const p) const noexcept {
+        const auto *const b = reinterpret_cast<const std::byte*>(p);
+        return not std::less<const std::byte*>{}(b, store) && std::less<const std::byte*>{}(b, store + sizeof(store));
+      }
+      template <typename U> void emplace(size_t idx, U &&item) noexcept;
+      void erase(size_t idx) noexcept;
+      void move_tail_to(size_t from, unrl_node *dst) noexcept;
+    };
+  protected:
+    unrl_node *head{nullptr};  // owning plain pointer
+    unrl_node *tail{nullptr};  // non-owning plain pointer
+    size_t count{0};
+    unrl_node* link_new_node(unrl_node *at, bool after) noexcept;
+    void unlink_node(unrl_node *node) noexcept;
+    template <typename U> bool insert_into(unrl_node *node, size_t idx, U &&item) noexcept;
+    void erase_from(unrl_node *node, size_t idx) noexcept;
+    template <typename U> bool insert_at_position(U &&item, const T&pos) noexcept;
+    template <typename U> bool append_at_position(U &&item, const T&pos) noexcept;
+    std::pair<unrl_node*, size_t> locate_first(const T&pos) const noexcept;
+    std::pair<unrl_node*, size_t> locate_last(const T&pos) const noexcept;
+  public:
+    unrolled_lnk_lst()  noexcept = default;
+    unrolled_lnk_lst(const unrolled_lnk_lst&) = delete;
+    unrolled_lnk_lst& operator=(const unrolled_lnk_lst&) = delete;
+    ~unrolled_lnk_lst() noexcept { clear(); }
+    static constexpr size_t node_capacity() noexcept { return N; }
+    size_t size() const noexcept { return count; }
+    bool is_empty() const noexcept { return count == 0; }
+    bool insert(const T& item) noexcept { return insert_into(head, 0, item); }
+    bool insert(T &&item) noexcept { return insert_into(head, 0, std::move(item)); }
+    bool insert_at(const T& item, const T&pos) noexcept { return insert_at_position(item, pos); }
+    bool insert_at(T &&item, const T&pos) noexcept { return insert_at_position(std::move(item), pos); }
+    bool append(const T& item) noexcept { return insert_into(tail, tail != nullptr ? tail->nbr : 0, item); }
+    bool append(T &&item) noexcept { return insert_into(tail, tail != nullptr ? tail->nbr : 0, std::move(item)); }
+    bool append_at(const T& item, const T&pos) noexcept { return append_at_position(item, pos); }
+    bool append_at(T &&item, const T&pos) noexcept { return append_at_position(std::move(item), pos); }
+    bool delete_at(const T&pos) noexcept;
+    void clear() noexcept;
+
+    /**
+     * Bidirectional iterator - Reverse iterates from tail to head, Const gives read-only access
+     * to the items (same scheme as dbl_lnk_lst::basic_iterator). Refers to an item by its node
+     * and its index within that node.
+     */
+    template <bool Reverse, bool Const>
+    class basic_iterator {
+    public:
+      using iterator_concept  = std::bidirectional_iterator_tag;
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type  = T;
+      using pointer     = std::conditional_t<Const, const T*, T*>;
+      using reference   = std::conditional_t<Const, const T&, T&>;
+    protected:
+      unrl_node *node{nullptr};              // non-owning plain pointer (null at end)
+      size_t idx{0};                         // index of item within node (zero at end)
+      const unrolled_lnk_lst *lst{nullptr};  // non-owning plain pointer
+      friend class unrolled_lnk_lst;
+      template <bool, bool> friend class basic_iterator;
+      basic_iterator(unrl_node *n, size_t i, const unrolled_lnk_lst *l) noexcept : node{n}, idx{i}, lst{l} {}
+      // steps toward tail of list (from the tail item on to end)
+      void step_next() noexcept {
+        if (++idx == node->nbr) {
+          node = node->next;
+          idx = 0;
+        }
+      }
+      // steps toward head of list (from the head item on to end)
+      void step_prev() noexcept {
+        if (idx == 0) {
+          node = node->prev;
+          idx = node != nullptr ? node->nbr - 1 : 0;
+        } else {
+          idx--;
+        }
+      }
+    public:
+      basic_iterator() noexcept = default;
+      // a non-const iterator converts to its const counterpart
+      template <bool C = Const> requires C
+      basic_iterator(const basic_iterator<Reverse, false> &oth) noexcept : node{oth.node}, idx{oth.idx}, lst{oth.lst} {}
+      // Prefix increment
+      basic_iterator& operator++() noexcept {
+        if constexpr (Reverse)
+          step_prev();
+        else
+          step_next();
+        return *this;
+      }
+      // Postfix increment
+      basic_iterator operator++(int) noexcept { basic_iterator tmp = *this; ++(*this); return tmp; }
+      // Prefix decrement (end() decrements to the last item in iteration order)
+      basic_iterator& operator--() noexcept {
+        if (node == nullptr) {
+          node = Reverse ? lst->head : lst->tail;
+          idx = Reverse || node == nullptr ? 0 : node->nbr - 1;
+        } else if constexpr (Reverse) {
+          step_next();
+        } else {
+          step_prev();
+        }
+        return *this;
+      }
+      // Postfix decrement
+      basic_iterator operator--(int) noexcept { basic_iterator tmp = *this; --(*this); return tmp; }
+      friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.node == b.node && a.idx == b.idx; };
+      reference operator*() const noexcept { return (*node)[idx]; }
+      pointer operator->() const noexcept { return &(*node)[idx]; }
+    };
+    using iterator = basic_iterator<false, false>;
+    using const_iterator = basic_iterator<false, true>;
+    using reverse_iterator = basic_iterator<true, false>;
+    using const_reverse_iterator = basic_iterator<true, true>;
+    iterator begin() noexcept { return iterator{head, 0, this}; }
+    iterator end() noexcept { return iterator{nullptr, 0, this}; }
+    const_iterator begin() const noexcept { return const_iterator{head, 0, this}; }
+    const_iterator end() const noexcept { return const_iterator{nullptr, 0, this}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator{tail, tail != nullptr ? tail->nbr - 1 : 0, this}; }
+    reverse_iterator rend() noexcept { return reverse_iterator{nullptr, 0, this}; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{tail, tail != nullptr ? tail->nbr - 1 : 0, this}; }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator{nullptr, 0, this}; }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+    iterator find(const T&value) noexcept;
+    iterator find_last(const T&value) noexcept;
+  };
+
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  template <typename U>
+  inline void unrolled_lnk_lst<T, N, Fingerprints>::unrl_node::emplace(const size_t idx, U &&item) noexcept {
+    assert(nbr < N && idx <= nbr); // (we trust but verify)
+    auto *const e = elms();
+    for (size_t j = nbr; j > idx; j--) { // shift up to open a slot at idx
+      std::construct_at(e + j, std::move(e[j - 1]));
+      std::destroy_at(e + j - 1);
+    }
+    std::construct_at(e + idx, std::forward<U>(item));
+    fps.insert(idx, nbr, Fingerprints::of(e[idx]));
+    nbr++;
+  }
+
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  inline void unrolled_lnk_lst<T, N, Fingerprints>::unrl_node::erase(const size_t idx) noexcept {
+    assert(idx < nbr); // (we trust but verify)
+    auto *const e = elms();
+    std::destroy_at(e + idx);
+    for (size_t j = idx + 1; j < nbr; j++) { // shift down to close the slot at idx
+      std::construct_at(e + j - 1, std::move(e[j]));
+      std::destroy_at(e + j);
+    }
+    fps.erase(idx, nbr);
+    nbr--;
+  }
+
+  /**
+   * Moves elements [from, nbr) of this node to the end of the dst node.
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  inline void unrolled_lnk_lst<T, N, Fingerprints>::unrl_node::move_tail_to(const size_t from, unrl_node *const dst) noexcept {
+    assert(dst->nbr + (nbr - from) <= N); // (we trust but verify)
+    auto *const e = elms();
+    auto *const d = dst->elms();
+    fps.move_tail_to(from, nbr, dst->fps, dst->nbr);
+    for (size_t j = from; j < nbr; j++) {
+      std::construct_at(d + dst->nbr++, std::move(e[j]));
+      std::destroy_at(e + j);
+    }
+    nbr = from;
+  }
+
+  /**
+   * Allocates an empty node and links it in after (or before) the at node - if at is null then
+   * the new node becomes the sole node of the list.
+   * @return the new node or null if fails to allocate memory
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  auto unrolled_lnk_lst<T, N, Fingerprints>::link_new_node(unrl_node *const at, const bool after) noexcept -> unrl_node* {
+    auto *const node = new (std::nothrow) unrl_node{};
+    if (node == nullptr)
+      return nullptr;
+    if (at == nullptr) {
+      assert(head == nullptr); // (we trust but verify)
+      head = tail = node;
+    } else if (after) {
+      node->prev = at;
+      node->next = at->next;
+      if (at->next != nullptr)
+        at->next->prev = node;
+      else
+        tail = node;
+      at->next = node;
+    } else {
+      node->next = at;
+      node->prev = at->prev;
+      if (at->prev != nullptr)
+        at->prev->next = node;
+      else
+        head = node;
+      at->prev = node;
+    }
+    return node;
+  }
+
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  void unrolled_lnk_lst<T, N, Fingerprints>::unlink_node(unrl_node *const node) noexcept {
+    if (node->prev != nullptr)
+      node->prev->next = node->next;
+    else
+      head = node->next;
+    if (node->next != nullptr)
+      node->next->prev = node->prev;
+    else
+      tail = node->prev;
+    delete node;
+  }
+
+  /**
+   * Inserts item at element index idx of node (where idx may be node->nbr, i.e., after its last
+   * element). A full node gets split in half, unless inserting at either of its ends, in which
+   * case a new neighbour node is started instead. An item that is itself an element of node is
+   * first copied (moved) aside - as shifting or splitting the node's elements would move it.
+   * @return returns false when fails to allocate memory for a new node
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  template <typename U>
+  bool unrolled_lnk_lst<T, N, Fingerprints>::insert_into(unrl_node *node, size_t idx, U &&item) noexcept {
+    if (node != nullptr && node->holds(std::addressof(item))) {
+      T item_copy{std::forward<U>(item)};
+      return insert_into(node, idx, std::move(item_copy));
+    }
+    if (node == nullptr) {
+      if ((node = link_new_node(nullptr, true)) == nullptr)
+        return false;
+    } else if (node->nbr == N) {
+      if (idx == N || idx == 0) {
+        if ((node = link_new_node(node, idx == N)) == nullptr)
+          return false;
+        idx = 0;
+      } else {
+        auto *const split_node = link_new_node(node, true);
+        if (split_node == nullptr)
+          return false;
+        constexpr size_t half = N / 2;
+        node->move_tail_to(half, split_node);
+        if (idx > half) {
+          node = split_node;
+          idx -= half;
+        }
+      }
+    }
+    node->emplace(idx, std::forward<U>(item));
+    count++;
+    return true;
+  }
+
+  /**
+   * Removes element at index idx of node; an emptied node is freed, otherwise a node left at
+   * half capacity (or less) is merged with a neighbour if their elements fit into one node.
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  void unrolled_lnk_lst<T, N, Fingerprints>::erase_from(unrl_node *const node, const size_t idx) noexcept {
+    node->erase(idx);
+    count--;
+    if (node->nbr == 0) {
+      unlink_node(node);
+    } else if (node->nbr <= N / 2) {
+      if (auto *const next_node = node->next; next_node != nullptr && node->nbr + next_node->nbr <= N) {
+        next_node->move_tail_to(0, node);
+        unlink_node(next_node);
+      } else if (auto *const prev_node = node->prev; prev_node != nullptr && prev_node->nbr + node->nbr <= N) {
+        node->move_tail_to(0, prev_node);
+        unlink_node(node);
+      }
+    }
+  }
+
+  /**
+   * @return node and element index of the first item, starting from head of list, that matches pos
+   *         (null node if none) - with fingerprints, only the elements whose fingerprint matches
+   *         that of pos are compared
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  auto unrolled_lnk_lst<T, N, Fingerprints>::locate_first(const T&pos) const noexcept -> std::pair<unrl_node*, size_t> {
+    [[maybe_unused]] const auto fp = Fingerprints::of(pos);
+    for (auto *node = head; node != nullptr; node = node->next) {
+      auto *const e = node->elms();
+      if constexpr (Fingerprints::enabled) {
+        for (auto m = node->fps.candidates(node->nbr, fp); m != 0; m &= m - 1) {
+          const auto i = static_cast<size_t>(std::countr_zero(m));
+          if (e[i] == pos)
+            return {node, i};
+        }
+      } else {
+        for (size_t i = 0; i < node->nbr; i++) {
+          if (e[i] == pos)
+            return {node, i};
+        }
+      }
+    }
+    return {nullptr, 0};
+  }
+
+  /**
+   * @return node and element index of the first item, starting from tail of list, that matches pos
+   *         (null node if none)
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  auto unrolled_lnk_lst<T, N, Fingerprints>::locate_last(const T&pos) const noexcept -> std::pair<unrl_node*, size_t> {
+    [[maybe_unused]] const auto fp = Fingerprints::of(pos);
+    for (auto *node = tail; node != nullptr; node = node->prev) {
+      auto *const e = node->elms();
+      if constexpr (Fingerprints::enabled) {
+        for (auto m = node->fps.candidates(node->nbr, fp); m != 0;) {
+          const auto i = static_cast<size_t>(63 - std::countl_zero(m));
+          if (e[i] == pos)
+            return {node, i};
+          m &= ~(uint64_t{1} << i);
+        }
+      } else {
+        for (size_t i = node->nbr; i-- > 0;) {
+          if (e[i] == pos)
+            return {node, i};
+        }
+      }
+    }
+    return {nullptr, 0};
+  }
+
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  template <typename U>
+  bool unrolled_lnk_lst<T, N, Fingerprints>::insert_at_position(U &&item, const T&pos) noexcept {
+    if (const auto [node, i] = locate_first(pos); node != nullptr)
+      return insert_into(node, i, std::forward<U>(item));
+    return insert_into(tail, tail != nullptr ? tail->nbr : 0, std::forward<U>(item));
+  }
+
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  template <typename U>
+  bool unrolled_lnk_lst<T, N, Fingerprints>::append_at_position(U &&item, const T&pos) noexcept {
+    if (const auto [node, i] = locate_last(pos); node != nullptr)
+      return insert_into(node, i + 1, std::forward<U>(item));
+    return insert_into(tail, tail != nullptr ? tail->nbr : 0, std::forward<U>(item));
+  }
+
+  /**
+   * Removes a pos specified matched item from list (the first match starting from head of list).
+   * @tparam T item's type
+   * @param pos item to be removed
+   * @return returns true if item was matched and removed from list
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  bool unrolled_lnk_lst<T, N, Fingerprints>::delete_at(const T&pos) noexcept {
+    if (const auto [node, i] = locate_first(pos); node != nullptr) {
+      erase_from(node, i);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Finds the first item, starting from head of list, that matches value.
+   * @tparam T item's type
+   * @param value item to be found
+   * @return (forward) iterator to the matched item, or end() if there's no match
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  auto unrolled_lnk_lst<T, N, Fingerprints>::find(const T&value) noexcept -> iterator {
+    const auto [node, i] = locate_first(value);
+    return node != nullptr ? iterator{node, i, this} : end();
+  }
+
+  /**
+   * Finds the first item, starting from tail of list, that matches value.
+   * @tparam T item's type
+   * @param value item to be found
+   * @return (forward) iterator to the matched item, or end() if there's no match
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  auto unrolled_lnk_lst<T, N, Fingerprints>::find_last(const T&value) noexcept -> iterator {
+    const auto [node, i] = locate_last(value);
+    return node != nullptr ? iterator{node, i, this} : end();
+  }
+
+  /**
+   * Removes all items in container, freeing their memory.
+   * @tparam T item's type
+   */
+  template <typename T, size_t N, typename Fingerprints> requires lst_elm_type_constraints<T> && (N > 0)
+  void unrolled_lnk_lst<T, N, Fingerprints>::clear() noexcept {
+    for (auto *node = head; node != nullptr;) {
+      auto *const next_node = node->next;
+      delete node;
+      node = next_node;
+    }
+    head = tail = nullptr;
+    count = 0;
+  }
+
+  /**
+   * An unrolled_lnk_lst whose searches (insert_at/append_at/delete_at/find/find_last) compare one
+   * byte fingerprints of a node's elements N at a time, calling T::operator== only on the
+   * fingerprint hits - for element types with costly equality (e.g., strings).
+   */
+  template <typename T, typename Hash = std::hash<T>, size_t N = 32>
+  using fingerprinted_lnk_lst = unrolled_lnk_lst<T, N, hash_fingerprints<Hash>>;
+
+} // cust_coll
+
+#endif //UNROLLED_LNK_LST_HPP
@@ -0,0 +1,288 @@
+//
+// Created by rogerv on 5/14/24.
+//
+#include <string>
+#include <vector>
+#include <list>
+#include <ranges>
+#include <iterator>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "some_elm.hpp"
+#include "unrolled-lnk-lst.hpp"
+using cust_coll::unrolled_lnk_lst;
+using cust_coll::fingerprinted_lnk_lst;
+
+static constexpr auto ITEM_NBR = 10000;
+
+struct some_elm_hash {
+  size_t operator()(const some_elm &elm) const noexcept { return std::hash<std::string>{}(elm.s); }
+};
+
+template <typename L>
+static void expect_same_seq(L &lst, std::list<int> &oracle) {
+  ASSERT_EQ(lst.size(), oracle.size());
+  EXPECT_TRUE(std::equal(lst.begin(), lst.end(), oracle.begin()));
+  EXPECT_TRUE(std::equal(lst.rbegin(), lst.rend(), oracle.rbegin()));
+}
+
+template <size_t N, typename Fingerprints = cust_coll::no_fingerprints>
+static void random_ops_vs_oracle() {
+  unrolled_lnk_lst<int, N, Fingerprints> lst{};  // <<=== unrolled-lnk-list
+  std::list<int> oracle{};
+  for (int i = 0; i < ITEM_NBR; i++) {
+    const int val = rand() % 512;
+    const int pos = rand() % 512;
+    switch (rand() % 5) {
+      case 0: {
+        EXPECT_TRUE(lst.insert(val));
+        oracle.push_front(val);
+        break;
+      }
+      case 1: {
+        EXPECT_TRUE(lst.append(val));
+        oracle.push_back(val);
+        break;
+      }
+      case 2: {
+        EXPECT_TRUE(lst.insert_at(val, pos));
+        oracle.insert(std::find(oracle.begin(), oracle.end(), pos), val);
+        break;
+      }
+      case 3: {
+        EXPECT_TRUE(lst.append_at(val, pos));
+        auto it = std::find(oracle.rbegin(), oracle.rend(), pos);
+        oracle.insert(it != oracle.rend() ? it.base() : oracle.end(), val); // (base() is one past the match)
+        break;
+      }
+      default: {
+        auto it = std::find(oracle.begin(), oracle.end(), pos);
+        EXPECT_EQ(lst.delete_at(pos), it != oracle.end());
+        if (it != oracle.end())
+          oracle.erase(it);
+      }
+    }
+  }
+  expect_same_seq(lst, oracle);
+  for (int pos = 0; pos < 512; pos++) {
+    while (lst.delete_at(pos)) {
+      oracle.erase(std::find(oracle.begin(), oracle.end(), pos));
+    }
+  }
+  expect_same_seq(lst, oracle);
+  EXPECT_TRUE(lst.is_empty());
+}
+
+TEST(UnrolledLnkListAssertions, EmptyConstructedState) {
+  srand( time(nullptr) );
+  some_elm::prnt = false;
+
+  unrolled_lnk_lst<some_elm> lst{};  // <<=== unrolled-lnk-list
+  EXPECT_EQ(lst.size(), 0);
+  EXPECT_TRUE(lst.is_empty());
+  EXPECT_TRUE(lst.begin() == lst.end());
+  EXPECT_TRUE(lst.rbegin() == lst.rend());
+}
+
+TEST(UnrolledLnkListAssertions, InsertAndAppendSomeElm) {
+  std::vector<some_elm> strs{ITEM_NBR};
+  unrolled_lnk_lst<some_elm, 4> lst{};  // <<=== unrolled-lnk-list
+  for (size_t i = 0; i < strs.size(); i++) {
+    auto r = i % 2 == 0 ? lst.append(strs[i]) : lst.insert(strs[i]);
+    EXPECT_TRUE(r);
+  }
+  EXPECT_EQ(lst.size(), ITEM_NBR);
+  auto lst_it = lst.begin();
+  for (size_t i = strs.size() - 1; i < strs.size(); i -= 2) // odd indexed items inserted at head
+    EXPECT_EQ((lst_it++)->s, strs[i].s);
+  for (size_t i = 0; i < strs.size(); i += 2)               // even indexed items appended at tail
+    EXPECT_EQ((lst_it++)->s, strs[i].s);
+  EXPECT_TRUE(lst_it == lst.end());
+  some_elm item{};
+  some_elm sav_item{item};
+  auto r = lst.insert_at(std::move(item), strs[2]);
+  EXPECT_TRUE(r);
+  EXPECT_EQ(lst.size(), ITEM_NBR + 1);
+  r = lst.delete_at(sav_item);
+  EXPECT_TRUE(r);
+  r = lst.delete_at(sav_item);
+  EXPECT_FALSE(r);
+  lst.clear();
+  EXPECT_TRUE(lst.is_empty());
+}
+
+TEST(UnrolledLnkListAssertions, SingleElementNodesVsStdList) {
+  random_ops_vs_oracle<1>();
+}
+
+TEST(UnrolledLnkListAssertions, SmallNodesVsStdList) {
+  random_ops_vs_oracle<4>();
+}
+
+TEST(UnrolledLnkListAssertions, DefaultNodesVsStdList) {
+  random_ops_vs_oracle<cust_coll::unrolled_default_n<int>()>();
+}
+
+TEST(UnrolledLnkListAssertions, FingerprintedNodesVsStdList) {
+  random_ops_vs_oracle<32, cust_coll::hash_fingerprints<std::hash<int>>>();
+  random_ops_vs_oracle<7, cust_coll::hash_fingerprints<std::hash<int>>>();  // (all scalar remainder)
+  random_ops_vs_oracle<64, cust_coll::hash_fingerprints<std::hash<int>>>();
+}
+
+template <size_t N>
+static void expect_simd_matches_scalar() {
+  uint8_t fps[N];
+  for (auto &fp : fps)
+    fp = static_cast<uint8_t>(rand() % 8);  // (plenty of duplicates)
+  for (int fp = 0; fp < 256; fp++) {
+    const auto mask = cust_coll::fingerprint_match_mask<N>(fps, static_cast<uint8_t>(fp));
+    EXPECT_EQ(mask, (cust_coll::fingerprint_match_mask<N, false>(fps, static_cast<uint8_t>(fp))));
+    for (size_t i = 0; i < N; i++)
+      EXPECT_EQ((mask >> i) & 1, fps[i] == fp);
+  }
+}
+
+TEST(UnrolledLnkListAssertions, FingerprintMatchMask) {
+  expect_simd_matches_scalar<64>();
+  expect_simd_matches_scalar<37>();
+  expect_simd_matches_scalar<16>();
+  expect_simd_matches_scalar<3>();
+}
+
+TEST(UnrolledLnkListAssertions, FindAndFindLast) {
+  std::vector<some_elm> strs{ITEM_NBR / 10};
+  fingerprinted_lnk_lst<some_elm, some_elm_hash> lst{};  // <<=== unrolled-lnk-list
+  unrolled_lnk_lst<some_elm> plain_lst{};  // <<=== unrolled-lnk-list
+  for (const auto &elm : strs) {
+    EXPECT_TRUE(lst.append(elm));
+    EXPECT_TRUE(plain_lst.append(elm));
+  }
+  for (size_t i = 0; i < strs.size(); i++) {
+    auto it = lst.find(strs[i]);
+    ASSERT_TRUE(it != lst.end());
+    EXPECT_EQ(it->s, strs[i].s);
+    EXPECT_TRUE(std::equal(std::next(strs.begin(), static_cast<ptrdiff_t>(i)), strs.end(), it, lst.end()));
+    EXPECT_EQ(plain_lst.find(strs[i])->s, strs[i].s);
+  }
+  some_elm absent{};
+  absent.s = "!";
+  EXPECT_TRUE(lst.find(absent) == lst.end());
+  EXPECT_TRUE(lst.find_last(absent) == lst.end());
+  EXPECT_TRUE(plain_lst.find_last(absent) == plain_lst.end());
+
+  // with duplicates, find() yields the first from head, find_last() the first from tail
+  const auto &dup = strs[strs.size() / 2];
+  EXPECT_TRUE(lst.insert(dup));
+  EXPECT_TRUE(lst.append(dup));
+  EXPECT_TRUE(lst.find(dup) == lst.begin());
+  auto last = lst.find_last(dup);
+  ASSERT_TRUE(last != lst.end());
+  EXPECT_TRUE(++last == lst.end());
+  EXPECT_TRUE(lst.delete_at(dup));
+  EXPECT_TRUE(lst.delete_at(dup));
+  EXPECT_TRUE(lst.delete_at(dup));
+  EXPECT_FALSE(lst.delete_at(dup));
+  EXPECT_EQ(lst.size(), strs.size() - 1);
+}
+
+static_assert(std::bidirectional_iterator<unrolled_lnk_lst<int>::iterator>);
+static_assert(std::bidirectional_iterator<unrolled_lnk_lst<int>::const_iterator>);
+static_assert(std::bidirectional_iterator<unrolled_lnk_lst<int>::reverse_iterator>);
+static_assert(std::bidirectional_iterator<unrolled_lnk_lst<int>::const_reverse_iterator>);
+static_assert(std::ranges::bidirectional_range<unrolled_lnk_lst<int>>);
+static_assert(std::ranges::bidirectional_range<const fingerprinted_lnk_lst<int>>);
+
+TEST(UnrolledLnkListAssertions, BidirectionalIteratorsAndRanges) {
+  unrolled_lnk_lst<int, 4> lst{};  // <<=== unrolled-lnk-list
+  for (int i = 0; i < ITEM_NBR; i++)
+    EXPECT_TRUE(lst.append(i));
+  const auto &c_lst = lst;
+  EXPECT_EQ(std::distance(c_lst.begin(), c_lst.end()), ITEM_NBR);
+  EXPECT_EQ(*std::prev(lst.end()), ITEM_NBR - 1);
+  EXPECT_EQ(*std::prev(lst.rend()), 0);
+  EXPECT_EQ(*std::next(c_lst.cbegin(), 10), 10);
+  EXPECT_EQ(*std::prev(c_lst.crend(), 10), 9);
+  // stepping back and forth across node boundaries
+  auto it = std::next(lst.begin(), 5);
+  for (int i = 5; i > 0; i--)
+    EXPECT_EQ(*it--, i);
+  EXPECT_TRUE(it == lst.begin());
+  auto rit = lst.rbegin();
+  EXPECT_EQ(*++rit, ITEM_NBR - 2);
+  EXPECT_EQ(*--rit, ITEM_NBR - 1);
+  EXPECT_EQ(*std::next(rit, 7), ITEM_NBR - 8);
+  auto found = lst.find(42);
+  EXPECT_EQ(*--found, 41);
+  *found = -41;  // (mutable via a non-const iterator)
+  EXPECT_EQ(*std::next(c_lst.begin(), 41), -41);
+  // iterator converts to const_iterator
+  unrolled_lnk_lst<int, 4>::const_iterator c_it = lst.begin();
+  EXPECT_TRUE(c_it == lst.cbegin());
+  EXPECT_TRUE(lst.begin() == c_it);
+  // std algorithms and views
+  EXPECT_EQ(std::ranges::find(lst, 42), std::next(lst.begin(), 42));
+  EXPECT_TRUE(std::ranges::equal(lst | std::views::reverse, c_lst | std::views::reverse));
+  EXPECT_EQ(*(lst | std::views::reverse).begin(), ITEM_NBR - 1);
+  EXPECT_TRUE(std::ranges::equal(std::ranges::subrange(c_lst.crbegin(), c_lst.crend()), c_lst | std::views::reverse));
+
+  unrolled_lnk_lst<int> empty{};  // <<=== unrolled-lnk-list
+  EXPECT_TRUE(empty.crbegin() == empty.crend());
+}
+
+TEST(UnrolledLnkListAssertions, InsertOwnItem) {
+  // items long enough to be heap allocated, so a moved-from or destroyed one reads back differently
+  std::vector<std::string> strs{};
+  for (char c = 'a'; c < 'g'; c++)
+    strs.emplace_back(64, c);
+  using lst_t = unrolled_lnk_lst<std::string, 4>;
+  const auto nth = [](lst_t &lst, const int i) -> std::string& { return *std::next(lst.begin(), i); };
+  const auto fill = [&strs](lst_t &lst) {  // (a full node of a-d then one of e-f)
+    for (const auto &str : strs)
+      EXPECT_TRUE(lst.append(str));
+  };
+  const auto expect_seq = [&strs](lst_t &lst, const std::vector<int> &idxs) {
+    std::vector<std::string> expected{};
+    for (const int i : idxs)
+      expected.push_back(i < 0 ? std::string{} : strs[i]);
+    EXPECT_TRUE(std::ranges::equal(lst, expected));
+  };
+  {  // shifting a node's elements up to make room
+    lst_t lst{};  // <<=== unrolled-lnk-list
+    EXPECT_TRUE(lst.append(strs[0]));
+    EXPECT_TRUE(lst.append(strs[1]));
+    EXPECT_TRUE(lst.insert(nth(lst, 0)));
+    EXPECT_TRUE(lst.insert(nth(lst, 2)));
+    expect_seq(lst, {1, 0, 0, 1});
+  }
+  {
+    lst_t lst{};  // <<=== unrolled-lnk-list
+    fill(lst);
+    EXPECT_TRUE(lst.insert_at(nth(lst, 5), strs[4]));
+    EXPECT_TRUE(lst.append_at(nth(lst, 6), strs[4]));
+    expect_seq(lst, {0, 1, 2, 3, 5, 4, 5, 5});
+  }
+  {
+    lst_t lst{};  // <<=== unrolled-lnk-list
+    fill(lst);
+    EXPECT_TRUE(lst.insert_at(std::move(nth(lst, 5)), strs[4]));
+    expect_seq(lst, {0, 1, 2, 3, 5, 4, -1});
+  }
+  {  // splitting a full node
+    lst_t lst{};  // <<=== unrolled-lnk-list
+    fill(lst);
+    EXPECT_TRUE(lst.insert_at(nth(lst, 2), strs[2]));
+    expect_seq(lst, {0, 1, 2, 2, 3, 4, 5});
+  }
+  {
+    lst_t lst{};  // <<=== unrolled-lnk-list
+    fill(lst);
+    EXPECT_TRUE(lst.append_at(nth(lst, 3), strs[1]));
+    expect_seq(lst, {0, 1, 3, 2, 3, 4, 5});
+  }
+  {
+    lst_t lst{};  // <<=== unrolled-lnk-list
+    fill(lst);
+    EXPECT_TRUE(lst.append_at(std::move(nth(lst, 3)), strs[1]));
+    expect_seq(lst, {0, 1, 3, 2, -1, 4, 5});
+  }
+}